@@ -372,17 +372,19 @@ void PartialPipeline::Execute(
     }
     if (pShaderModuleEntryData != nullptr)
     {
+        // The resource mapping only depends on the module data, so build it once and share it across all devices.
+        const Vkgc::ResourceMappingNode*    pResourceMappingNode = nullptr;
+        uint32_t                            mappingNodeCount = 0;
+        CreatePipelineLayoutFromModuleData(pAsyncLayer, pShaderModuleEntryData, &pResourceMappingNode, &mappingNodeCount);
+
         for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
         {
-            const Vkgc::ResourceMappingNode*    pResourceMappingNode = nullptr;
-            uint32_t                            mappingNodeCount = 0;
-            CreatePipelineLayoutFromModuleData(pAsyncLayer, pShaderModuleEntryData, &pResourceMappingNode, &mappingNodeCount);
-
             auto result = pDevice->GetCompiler(deviceIdx)->CreatePartialPipelineBinary(deviceIdx,
                 pShaderModuleData, pShaderModuleEntryData, pResourceMappingNode, mappingNodeCount, pColorTarget);
             VK_ASSERT(result == VK_SUCCESS);
-            m_pAllocator->pfnFree(m_pAllocator->pUserData, (void*)pResourceMappingNode);
         }
+
+        m_pAllocator->pfnFree(m_pAllocator->pUserData, (void*)pResourceMappingNode);
     }
     Destroy();
 }
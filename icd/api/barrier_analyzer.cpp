@@ -0,0 +1,277 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  barrier_analyzer.cpp
+ * @brief Contains the implementation of the barrier analyzer.
+ ***********************************************************************************************************************
+ */
+
+#include "include/khronos/vulkan.h"
+
+#include "include/vk_conv.h"
+#include "include/vk_device.h"
+#include "include/barrier_analyzer.h"
+
+#include "utils/json_writer.h"
+
+#include "palVectorImpl.h"
+
+namespace vk
+{
+
+// Stages and accesses that cover more than any single kind of work
+static constexpr VkPipelineStageFlags BroadStageMask  = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT |
+                                                        VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
+static constexpr VkAccessFlags        BroadAccessMask = VK_ACCESS_MEMORY_READ_BIT |
+                                                        VK_ACCESS_MEMORY_WRITE_BIT;
+
+// =====================================================================================================================
+CmdBufferBarrierLog::CmdBufferBarrierLog(
+    PalAllocator* pAllocator)
+    :
+    m_records(pAllocator),
+    m_barrierWasLast(false)
+{
+    memset(&m_current, 0, sizeof(m_current));
+}
+
+// =====================================================================================================================
+// Forgets all logged barriers.  Called when the command buffer begins or is reset.
+void CmdBufferBarrierLog::Reset()
+{
+    m_records.Clear();
+
+    m_barrierWasLast = false;
+}
+
+// =====================================================================================================================
+// Starts logging a vkCmdPipelineBarrier() or vkCmdWaitEvents() call.  waitCount is the number of PAL pipe points or
+// events the barrier waits on.
+void CmdBufferBarrierLog::BeginBarrier(
+    bool                         waitEvents,
+    VkPipelineStageFlags         srcStageMask,
+    VkPipelineStageFlags         dstStageMask,
+    uint32_t                     waitCount,
+    uint32_t                     memoryBarrierCount,
+    const VkMemoryBarrier*       pMemoryBarriers,
+    uint32_t                     bufferMemoryBarrierCount,
+    const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+    uint32_t                     imageMemoryBarrierCount,
+    const VkImageMemoryBarrier*  pImageMemoryBarriers)
+{
+    memset(&m_current, 0, sizeof(m_current));
+
+    m_current.srcStageMask       = srcStageMask;
+    m_current.dstStageMask       = dstStageMask;
+    m_current.memoryBarrierCount = memoryBarrierCount;
+    m_current.bufferBarrierCount = bufferMemoryBarrierCount;
+    m_current.imageBarrierCount  = imageMemoryBarrierCount;
+    m_current.waitCount          = waitCount;
+    m_current.flags.waitEvents   = waitEvents;
+    m_current.flags.backToBack   = m_barrierWasLast;
+
+    for (uint32_t i = 0; i < memoryBarrierCount; ++i)
+    {
+        m_current.srcAccessMask |= pMemoryBarriers[i].srcAccessMask;
+        m_current.dstAccessMask |= pMemoryBarriers[i].dstAccessMask;
+    }
+
+    for (uint32_t i = 0; i < bufferMemoryBarrierCount; ++i)
+    {
+        m_current.srcAccessMask |= pBufferMemoryBarriers[i].srcAccessMask;
+        m_current.dstAccessMask |= pBufferMemoryBarriers[i].dstAccessMask;
+    }
+
+    for (uint32_t i = 0; i < imageMemoryBarrierCount; ++i)
+    {
+        m_current.srcAccessMask |= pImageMemoryBarriers[i].srcAccessMask;
+        m_current.dstAccessMask |= pImageMemoryBarriers[i].dstAccessMask;
+    }
+}
+
+// =====================================================================================================================
+// Adds the cache masks and layout transitions of a PAL barrier the current barrier was translated to.  A barrier may
+// be split into several PAL barriers.
+void CmdBufferBarrierLog::AddPalBarrier(
+    const Pal::BarrierInfo& barrier)
+{
+    m_current.srcCacheMask |= barrier.globalSrcCacheMask;
+    m_current.dstCacheMask |= barrier.globalDstCacheMask;
+
+    for (uint32_t i = 0; i < barrier.transitionCount; ++i)
+    {
+        const Pal::BarrierTransition& transition = barrier.pTransitions[i];
+
+        m_current.srcCacheMask |= transition.srcCacheMask;
+        m_current.dstCacheMask |= transition.dstCacheMask;
+
+        if (transition.imageInfo.pImage != nullptr)
+        {
+            m_current.layoutTransitionCount++;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Classifies the current barrier and adds it to the log.
+void CmdBufferBarrierLog::EndBarrier()
+{
+    m_current.flags.redundant   = (m_current.waitCount == 0)             &&
+                                  (m_current.layoutTransitionCount == 0) &&
+                                  (m_current.srcCacheMask == 0)          &&
+                                  (m_current.dstCacheMask == 0);
+    m_current.flags.overlyBroad = (((m_current.srcStageMask | m_current.dstStageMask) & BroadStageMask) != 0) ||
+                                  (((m_current.srcAccessMask | m_current.dstAccessMask) & BroadAccessMask) != 0);
+
+    // Losing records for lack of memory only makes the report incomplete.
+    m_records.PushBack(m_current);
+
+    m_barrierWasLast = true;
+}
+
+// =====================================================================================================================
+BarrierAnalyzer::BarrierAnalyzer(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_enabled(false),
+    m_reportCount(0)
+{
+
+}
+
+// =====================================================================================================================
+// Initializes the analyzer.  Should be called during device create.
+VkResult BarrierAnalyzer::Init()
+{
+    m_enabled = m_pDevice->GetRuntimeSettings().enableBarrierAnalysis;
+
+    return PalToVkResult(m_mutex.Init());
+}
+
+// =====================================================================================================================
+// Appends the summary of a command buffer's barriers to the file given by the barrierAnalysisFile setting.  Called
+// when a command buffer ends; command buffers without barriers are not reported.  May be called from any thread.
+void BarrierAnalyzer::Report(
+    const CmdBufferBarrierLog& log,
+    uint32_t                   queueFamilyIndex,
+    bool                       secondary)
+{
+    const uint32_t barrierCount = log.NumBarriers();
+
+    if (m_enabled && (barrierCount > 0))
+    {
+        uint32_t redundantCount        = 0;
+        uint32_t overlyBroadCount      = 0;
+        uint32_t backToBackCount       = 0;
+        uint32_t layoutTransitionCount = 0;
+
+        for (uint32_t i = 0; i < barrierCount; ++i)
+        {
+            const BarrierRecord& record = log.GetBarrier(i);
+
+            redundantCount        += record.flags.redundant;
+            overlyBroadCount      += record.flags.overlyBroad;
+            backToBackCount       += record.flags.backToBack;
+            layoutTransitionCount += record.layoutTransitionCount;
+        }
+
+        Util::MutexAuto lock(&m_mutex);
+
+        utils::JsonOutputStream jsonStream(m_pDevice->GetRuntimeSettings().barrierAnalysisFile);
+        Util::JsonWriter        writer(&jsonStream);
+
+        writer.BeginMap(false);
+
+        writer.Key("commandBuffer");
+        writer.Value(m_reportCount);
+        writer.Key("queueFamilyIndex");
+        writer.Value(queueFamilyIndex);
+        writer.Key("secondary");
+        writer.Value(secondary);
+        writer.Key("barrierCount");
+        writer.Value(barrierCount);
+        writer.Key("layoutTransitionCount");
+        writer.Value(layoutTransitionCount);
+        writer.Key("redundantCount");
+        writer.Value(redundantCount);
+        writer.Key("overlyBroadCount");
+        writer.Value(overlyBroadCount);
+        writer.Key("backToBackCount");
+        writer.Value(backToBackCount);
+
+        writer.Key("barriers");
+        writer.BeginList(false);
+
+        for (uint32_t i = 0; i < barrierCount; ++i)
+        {
+            const BarrierRecord& record = log.GetBarrier(i);
+
+            writer.BeginMap(true);
+            writer.Key("srcStageMask");
+            writer.Value(record.srcStageMask);
+            writer.Key("dstStageMask");
+            writer.Value(record.dstStageMask);
+            writer.Key("srcAccessMask");
+            writer.Value(record.srcAccessMask);
+            writer.Key("dstAccessMask");
+            writer.Value(record.dstAccessMask);
+            writer.Key("srcCacheMask");
+            writer.Value(record.srcCacheMask);
+            writer.Key("dstCacheMask");
+            writer.Value(record.dstCacheMask);
+            writer.Key("memoryBarriers");
+            writer.Value(record.memoryBarrierCount);
+            writer.Key("bufferBarriers");
+            writer.Value(record.bufferBarrierCount);
+            writer.Key("imageBarriers");
+            writer.Value(record.imageBarrierCount);
+            writer.Key("layoutTransitions");
+            writer.Value(record.layoutTransitionCount);
+            writer.Key("waits");
+            writer.Value(record.waitCount);
+            writer.Key("waitEvents");
+            writer.Value(record.flags.waitEvents != 0);
+            writer.Key("redundant");
+            writer.Value(record.flags.redundant != 0);
+            writer.Key("overlyBroad");
+            writer.Value(record.flags.overlyBroad != 0);
+            writer.Key("backToBack");
+            writer.Value(record.flags.backToBack != 0);
+            writer.EndMap();
+        }
+
+        writer.EndList();
+        writer.EndMap();
+
+        m_reportCount++;
+
+        // Separate the reports appended to the file
+        jsonStream.WriteCharacter('\n');
+    }
+}
+
+} // namespace vk
@@ -0,0 +1,171 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  graphics_sub_state_cache.cpp
+ * @brief Contains the implementation of the graphics pipeline sub-state cache.
+ ***********************************************************************************************************************
+ */
+
+#include "include/khronos/vulkan.h"
+
+#include "include/vk_conv.h"
+#include "include/vk_device.h"
+#include "include/vk_instance.h"
+#include "include/graphics_sub_state_cache.h"
+
+#include "palHashMapImpl.h"
+
+namespace vk
+{
+
+// =====================================================================================================================
+GraphicsSubStateCache::GraphicsSubStateCache(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_rasterizationBlocks(NumBlockBuckets, pDevice->VkInstance()->Allocator()),
+    m_multisampleBlocks(NumBlockBuckets, pDevice->VkInstance()->Allocator()),
+    m_colorBlendBlocks(NumBlockBuckets, pDevice->VkInstance()->Allocator())
+{
+
+}
+
+// =====================================================================================================================
+// Initializes the sub-state cache.  Should be called during device create.
+VkResult GraphicsSubStateCache::Init()
+{
+    Pal::Result result = m_mutex.Init();
+
+    if (result == Pal::Result::Success)
+    {
+        result = m_rasterizationBlocks.Init();
+    }
+
+    if (result == Pal::Result::Success)
+    {
+        result = m_multisampleBlocks.Init();
+    }
+
+    if (result == Pal::Result::Success)
+    {
+        result = m_colorBlendBlocks.Init();
+    }
+
+    return PalToVkResult(result);
+}
+
+// =====================================================================================================================
+// Copies out the block previously inserted with the given hash.  Returns false if there is none.
+template <typename Block>
+bool GraphicsSubStateCache::FindBlock(
+    BlockMap<Block>*             pMap,
+    const Util::MetroHash::Hash& hash,
+    Block*                       pBlock)
+{
+    Util::MutexAuto lock(&m_mutex);
+
+    const Block* pEntry = pMap->FindKey(hash);
+
+    if (pEntry != nullptr)
+    {
+        *pBlock = *pEntry;
+    }
+
+    return (pEntry != nullptr);
+}
+
+// =====================================================================================================================
+// Records a newly converted block under the given hash.  Failing to record it is not an error; the next pipeline with
+// the same sub-state simply converts it again.
+template <typename Block>
+void GraphicsSubStateCache::InsertBlock(
+    BlockMap<Block>*             pMap,
+    const Util::MetroHash::Hash& hash,
+    const Block&                 block)
+{
+    Util::MutexAuto lock(&m_mutex);
+
+    if (pMap->GetNumEntries() < MaxBlocksPerKind)
+    {
+        bool   existed = false;
+        Block* pEntry  = nullptr;
+
+        if ((pMap->FindAllocate(hash, &existed, &pEntry) == Pal::Result::Success) && (existed == false))
+        {
+            *pEntry = block;
+        }
+    }
+}
+
+// =====================================================================================================================
+bool GraphicsSubStateCache::Find(
+    const Util::MetroHash::Hash& hash,
+    GraphicsRasterizationBlock*  pBlock)
+{
+    return FindBlock(&m_rasterizationBlocks, hash, pBlock);
+}
+
+// =====================================================================================================================
+bool GraphicsSubStateCache::Find(
+    const Util::MetroHash::Hash& hash,
+    GraphicsMultisampleBlock*    pBlock)
+{
+    return FindBlock(&m_multisampleBlocks, hash, pBlock);
+}
+
+// =====================================================================================================================
+bool GraphicsSubStateCache::Find(
+    const Util::MetroHash::Hash& hash,
+    GraphicsColorBlendBlock*     pBlock)
+{
+    return FindBlock(&m_colorBlendBlocks, hash, pBlock);
+}
+
+// =====================================================================================================================
+void GraphicsSubStateCache::Insert(
+    const Util::MetroHash::Hash&      hash,
+    const GraphicsRasterizationBlock& block)
+{
+    InsertBlock(&m_rasterizationBlocks, hash, block);
+}
+
+// =====================================================================================================================
+void GraphicsSubStateCache::Insert(
+    const Util::MetroHash::Hash&    hash,
+    const GraphicsMultisampleBlock& block)
+{
+    InsertBlock(&m_multisampleBlocks, hash, block);
+}
+
+// =====================================================================================================================
+void GraphicsSubStateCache::Insert(
+    const Util::MetroHash::Hash&   hash,
+    const GraphicsColorBlendBlock& block)
+{
+    InsertBlock(&m_colorBlendBlocks, hash, block);
+}
+
+} // namespace vk
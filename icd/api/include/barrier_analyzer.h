@@ -0,0 +1,157 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  barrier_analyzer.h
+ * @brief Records the barriers of command buffers and reports redundant and overly broad ones.
+ ***********************************************************************************************************************
+ */
+
+#ifndef __BARRIER_ANALYZER_H__
+#define __BARRIER_ANALYZER_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_alloccb.h"
+#include "include/vk_defines.h"
+
+#include "palCmdBuffer.h"
+#include "palMutex.h"
+#include "palVector.h"
+
+namespace vk
+{
+
+class Device;
+
+// What the barrier analysis recorded about one vkCmdPipelineBarrier() or vkCmdWaitEvents() call
+struct BarrierRecord
+{
+    VkPipelineStageFlags srcStageMask;
+    VkPipelineStageFlags dstStageMask;
+    VkAccessFlags        srcAccessMask;          // Union of the source accesses of all memory barriers
+    VkAccessFlags        dstAccessMask;          // Union of the destination accesses of all memory barriers
+    uint32_t             srcCacheMask;           // Union of the PAL source cache masks computed for the barrier
+    uint32_t             dstCacheMask;           // Union of the PAL destination cache masks computed for the barrier
+    uint32_t             memoryBarrierCount;
+    uint32_t             bufferBarrierCount;
+    uint32_t             imageBarrierCount;
+    uint32_t             layoutTransitionCount;  // Number of PAL image layout transitions
+    uint32_t             waitCount;              // Number of PAL pipe points or events waited on
+
+    union
+    {
+        struct
+        {
+            uint32_t waitEvents  : 1;  // Recorded by vkCmdWaitEvents()
+            uint32_t redundant   : 1;  // Neither waits, transitions a layout nor synchronizes any cache
+            uint32_t overlyBroad : 1;  // Uses the all commands or all graphics stages or the generic memory accesses
+            uint32_t backToBack  : 1;  // No command doing GPU work was recorded since the previous barrier
+            uint32_t reserved    : 28;
+        };
+        uint32_t u32All;
+    } flags;
+};
+
+// =====================================================================================================================
+// Barriers recorded into one command buffer since it began.  Each vkCmdPipelineBarrier() or vkCmdWaitEvents() call is
+// bracketed by BeginBarrier() and EndBarrier(), and the PAL barriers it is translated to are added in between.
+//
+// This object is owned by a CmdBuffer.
+class CmdBufferBarrierLog
+{
+public:
+    CmdBufferBarrierLog(PalAllocator* pAllocator);
+
+    void Reset();
+
+    void BeginBarrier(
+        bool                         waitEvents,
+        VkPipelineStageFlags         srcStageMask,
+        VkPipelineStageFlags         dstStageMask,
+        uint32_t                     waitCount,
+        uint32_t                     memoryBarrierCount,
+        const VkMemoryBarrier*       pMemoryBarriers,
+        uint32_t                     bufferMemoryBarrierCount,
+        const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+        uint32_t                     imageMemoryBarrierCount,
+        const VkImageMemoryBarrier*  pImageMemoryBarriers);
+
+    void AddPalBarrier(const Pal::BarrierInfo& barrier);
+
+    void EndBarrier();
+
+    // Called before every command that does GPU work
+    VK_INLINE void NotifyWork()
+        { m_barrierWasLast = false; }
+
+    VK_INLINE uint32_t NumBarriers() const
+        { return m_records.NumElements(); }
+
+    VK_INLINE const BarrierRecord& GetBarrier(uint32_t index) const
+        { return m_records.At(index); }
+
+private:
+    typedef Util::Vector<BarrierRecord, 16, PalAllocator> RecordVector;
+
+    RecordVector  m_records;
+    BarrierRecord m_current;        // Barrier between BeginBarrier() and EndBarrier()
+    bool          m_barrierWasLast; // Whether no GPU work was recorded since the last barrier
+};
+
+// =====================================================================================================================
+// CPU side analysis of the barriers applications record.  Every command buffer logs its vkCmdPipelineBarrier() and
+// vkCmdWaitEvents() calls along with the PAL cache masks and layout transitions they were translated to, and hands the
+// log to Report() when it ends.  Each report is appended to a JSON file as one object summarizing the command buffer,
+// with redundant, overly broad and back-to-back barriers flagged and counted.  This is meant for tuning the barriers
+// of an application without a GPU capture tool; recording a command buffer becomes noticeably slower.
+//
+// This object is owned by the Vulkan Device.
+class BarrierAnalyzer
+{
+public:
+    BarrierAnalyzer(Device* pDevice);
+
+    VkResult Init();
+
+    VK_INLINE bool IsEnabled() const
+        { return m_enabled; }
+
+    void Report(
+        const CmdBufferBarrierLog& log,
+        uint32_t                   queueFamilyIndex,
+        bool                       secondary);
+
+private:
+    Device* const m_pDevice;
+    bool          m_enabled;
+    Util::Mutex   m_mutex;       // Serializes writing the reports
+    uint32_t      m_reportCount; // Number of command buffers reported so far
+};
+
+} // namespace vk
+
+#endif /* __BARRIER_ANALYZER_H__ */
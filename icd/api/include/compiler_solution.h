@@ -42,6 +42,7 @@
 #endif
 
 #include "include/app_shader_optimizer.h"
+#include "include/pipeline_creation_profiler.h"
 
 #include "palMetroHash.h"
 
@@ -89,7 +90,9 @@ struct GraphicsPipelineCreateInfo
     PipelineCompilerType                   compilerType;
     bool                                   elfWasCached;
     Util::MetroHash::Hash                  basePipelineHash;
+    uint64_t                               pipelineHash;      // Pipeline hash of pipelineInfo, or 0 if not yet known
     PipelineCreationFeedback               pipelineFeedback;
+    PipelineCreationTimes                  creationTimes;     // Time spent in the phases run by the compiler
 };
 
 // =====================================================================================================================
@@ -107,7 +110,9 @@ struct ComputePipelineCreateInfo
     PipelineCompilerType                   compilerType;
     bool                                   elfWasCached;
     Util::MetroHash::Hash                  basePipelineHash;
+    uint64_t                               pipelineHash;      // Pipeline hash of pipelineInfo, or 0 if not yet known
     PipelineCreationFeedback               pipelineFeedback;
+    PipelineCreationTimes                  creationTimes;     // Time spent in the phases run by the compiler
 };
 
 // =====================================================================================================================
@@ -0,0 +1,168 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  graphics_sub_state_cache.h
+ * @brief Caches the converted fixed function sub-states of graphics pipelines so that they can be shared by pipelines
+ *        created from identical Vulkan sub-state structures.
+ ***********************************************************************************************************************
+ */
+
+#ifndef __GRAPHICS_SUB_STATE_CACHE_H__
+#define __GRAPHICS_SUB_STATE_CACHE_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_alloccb.h"
+
+#include "palHashMap.h"
+#include "palMetroHash.h"
+#include "palMutex.h"
+#include "palCmdBuffer.h"
+#include "palColorBlendState.h"
+#include "palMsaaState.h"
+#include "palPipeline.h"
+
+namespace vk
+{
+
+class Device;
+
+// Hash of a Vulkan sub-state, split like the graphics pipeline's hashes into the part that affects compilation and the
+// part that does not.
+struct GraphicsSubStateHash
+{
+    Util::MetroHash::Hash base;
+    Util::MetroHash::Hash api;
+};
+
+// Result of converting a VkPipelineRasterizationStateCreateInfo chain.  See
+// GraphicsPipeline::BuildRasterizationState().
+struct GraphicsRasterizationBlock
+{
+    bool                               depthClampDisable;
+    bool                               perpLineEndCapsEnable;
+    bool                               outOfOrderPrimsEnable;
+    bool                               bresenhamEnable;
+    bool                               enableConservativeRasterization;
+    bool                               enableLineStipple;
+    Pal::ConservativeRasterizationMode conservativeRasterizationMode;
+    uint32_t                           rasterizationStream;
+    Pal::TriangleRasterStateParams     triangleRasterState;
+    Pal::DepthBiasParams               depthBiasParams;
+    Pal::PointLineRasterStateParams    pointLineRasterParams;
+    Pal::LineStippleStateParams        lineStippleParams;
+    uint32_t                           staticStateMask;   // Static state bits contributed by this sub-state
+};
+
+// Result of converting a VkPipelineMultisampleStateCreateInfo chain.  The MSAA flags owned by the rasterization state
+// are left zero in msaa.  See GraphicsPipeline::BuildMultisampleState().
+struct GraphicsMultisampleBlock
+{
+    Pal::MsaaStateCreateInfo   msaa;
+    Pal::MsaaQuadSamplePattern samplePatternLocations;
+    uint32_t                   samplePatternCount;
+    uint32_t                   sampleCoverage;
+    bool                       forceAlphaToOne;
+    bool                       alphaToCoverageEnable;
+    uint32_t                   staticStateMask;
+};
+
+// Result of converting a VkPipelineColorBlendStateCreateInfo chain against a subpass' color attachment formats.  See
+// GraphicsPipeline::BuildColorBlendState().
+struct GraphicsColorBlendBlock
+{
+    Pal::ColorBlendStateCreateInfo blend;
+    Pal::LogicOp                   logicOp;
+    bool                           dualSourceBlendEnable;
+
+    struct
+    {
+        Pal::SwizzledFormat        swizzledFormat;
+        uint8_t                    channelWriteMask;
+    } targets[Pal::MaxColorTargets];
+
+    Pal::BlendConstParams          blendConstParams;
+    uint32_t                       staticStateMask;
+};
+
+// =====================================================================================================================
+// Device-level cache of converted graphics pipeline sub-states.  Large permutation sets of pipelines typically share
+// their rasterization, multisample and color blend state and only differ in their shaders.  Each of these sub-states
+// is therefore converted once and the result is looked up for every other pipeline by a hash built with the matching
+// GraphicsPipeline::GenerateHashFrom*StateCreateInfo() function, extended with whatever else the conversion reads.
+//
+// Blocks are matched by the full 128-bit hash alone since the Vulkan structures they were converted from are not kept.
+// The cache is therefore opt-in; see the EnableGraphicsSubStateCache setting.
+//
+// This object is owned by the Vulkan Device.
+class GraphicsSubStateCache
+{
+public:
+    GraphicsSubStateCache(Device* pDevice);
+
+    VkResult Init();
+
+    bool Find(const Util::MetroHash::Hash& hash, GraphicsRasterizationBlock* pBlock);
+    bool Find(const Util::MetroHash::Hash& hash, GraphicsMultisampleBlock* pBlock);
+    bool Find(const Util::MetroHash::Hash& hash, GraphicsColorBlendBlock* pBlock);
+
+    void Insert(const Util::MetroHash::Hash& hash, const GraphicsRasterizationBlock& block);
+    void Insert(const Util::MetroHash::Hash& hash, const GraphicsMultisampleBlock& block);
+    void Insert(const Util::MetroHash::Hash& hash, const GraphicsColorBlendBlock& block);
+
+private:
+    static const uint32_t NumBlockBuckets = 64;
+
+    // Upper bound on the number of blocks of each kind, in case an application keeps generating unique states
+    static const uint32_t MaxBlocksPerKind = 1024;
+
+    template <typename Block>
+    using BlockMap = Util::HashMap<Util::MetroHash::Hash,
+                                   Block,
+                                   PalAllocator,
+                                   Util::JenkinsHashFunc,
+                                   Util::DefaultEqualFunc,
+                                   Util::HashAllocator<PalAllocator>,
+                                   (sizeof(Util::MetroHash::Hash) + sizeof(Block)) * 8>;
+
+    template <typename Block>
+    bool FindBlock(BlockMap<Block>* pMap, const Util::MetroHash::Hash& hash, Block* pBlock);
+
+    template <typename Block>
+    void InsertBlock(BlockMap<Block>* pMap, const Util::MetroHash::Hash& hash, const Block& block);
+
+    Device* const                        m_pDevice;
+    Util::Mutex                          m_mutex;
+
+    BlockMap<GraphicsRasterizationBlock> m_rasterizationBlocks;
+    BlockMap<GraphicsMultisampleBlock>   m_multisampleBlocks;
+    BlockMap<GraphicsColorBlendBlock>    m_colorBlendBlocks;
+};
+
+} // namespace vk
+
+#endif /* __GRAPHICS_SUB_STATE_CACHE_H__ */
@@ -56,6 +56,19 @@ namespace vk
 class Device;
 class Instance;
 class InternalMemMgr;
+struct InternalMemorySlab;
+
+// Number of size classes of the slabs small sub-allocations are made from
+static constexpr uint32_t InternalSlabClassCount = 13;
+
+// Maximum number of slots of a slab, reached by its smallest size class
+static constexpr uint32_t InternalSlabMaxSlots   = 256;
+
+// Number of caches of freed slab slots in front of the InternalMemMgr lock, which the threads are spread over
+static constexpr uint32_t InternalMemCacheCount     = 8;
+
+// Number of freed slots a cache holds before half of them are given back to their slabs
+static constexpr uint32_t InternalMemCacheSlotCount = 32;
 
 // Flags for describing internal memory allocations.
 union InternalMemCreateFlags
@@ -124,6 +137,60 @@ struct InternalMemoryPool
 
     Util::BuddyAllocator<PalAllocator>* pBuddyAllocator; // Buddy allocator used to sub-allocate
                                                          // from the pool
+
+    uint32_t                            sizeAccountedForDeviceMask; // Devices whose heap usage includes the size of
+                                                                    // this pool of application memory
+    Pal::gpusize                        accountedSize;              // Size accounted in the heap usage
+    Pal::GpuHeap                        accountedHeap;              // Heap the size is accounted in
+};
+
+// =====================================================================================================================
+// List of the memory pools with the same properties, along with the slabs that were carved out of them to serve small
+// sub-allocations.  Slabs are kept per size class; those with free slots are listed separately from full ones so that
+// a slot is found in constant time.
+class InternalMemoryPoolList : public Util::List<InternalMemoryPool, PalAllocator>
+{
+public:
+    InternalMemoryPoolList(PalAllocator* pAllocator)
+        :
+        Util::List<InternalMemoryPool, PalAllocator>(pAllocator)
+    {
+        memset(pPartialSlabs, 0, sizeof(pPartialSlabs));
+        memset(pFullSlabs,    0, sizeof(pFullSlabs));
+    }
+
+    InternalMemorySlab* pPartialSlabs[InternalSlabClassCount]; // Slabs with at least one free slot
+    InternalMemorySlab* pFullSlabs[InternalSlabClassCount];    // Slabs without free slots
+};
+
+// Block of a memory pool divided into equally sized slots of one size class
+struct InternalMemorySlab
+{
+    InternalMemoryPool      pool;                                 // Memory pool the slab was carved from
+    Pal::gpusize            offset;                               // Offset of the slab within the pool
+    InternalMemoryPoolList* pOwnerList;                           // Pool list the slab is linked into
+    uint32_t                classIdx;                             // Size class of the slots
+    uint32_t                slotCount;                            // Number of slots
+    uint32_t                freeCount;                            // Number of free slots
+    uint32_t                freeMask[InternalSlabMaxSlots / 32];  // Set bits mark free slots
+    InternalMemorySlab*     pPrev;                                // Previous slab in the owner list's slab list
+    InternalMemorySlab*     pNext;                                // Next slab in the owner list's slab list
+};
+
+// Freed slot of a slab that is held by an InternalMemCache
+struct InternalMemCachedSlot
+{
+    InternalMemorySlab* pSlab;   // Slab the slot belongs to
+    Pal::gpusize        offset;  // Offset of the slot within the slab's pool
+};
+
+// Cache of recently freed slab slots that allocations of the same size class and pool can take without the
+// InternalMemMgr lock.  Freed slots stay allocated in their slab while they are cached.
+struct InternalMemCache
+{
+    Util::Mutex           lock;                                  // Serializes the threads sharing the cache
+    uint32_t              slotCount;                             // Number of cached slots
+    InternalMemCachedSlot slots[InternalMemCacheSlotCount];      // Cached slots from the oldest to the newest
 };
 
 // =====================================================================================================================
@@ -179,6 +246,7 @@ private:
 
     InternalMemoryPool  m_memoryPool;                   // Memory pool the suballocation comes from (its pBuddyAllocator is
                                                         // null if the memory is base allocation, not a suballocation)
+    InternalMemorySlab* m_pSlab;                        // Slab the suballocation is a slot of, or null
     Pal::gpusize        m_gpuVA[MaxPalDevices];         // GPU virtual address to the start of the sub-allocation
     Pal::gpusize        m_gpuShadowVA[MaxPalDevices];   // GPU virtual address for the shadow table
     Pal::gpusize        m_offset;                       // Offset within the memory pool the suballocation starts from
@@ -189,6 +257,7 @@ private:
 // =====================================================================================================================
 InternalMemory::InternalMemory()
     :
+    m_pSlab(nullptr),
     m_offset(0),
     m_size(0),
     m_alignment(0)
@@ -218,7 +287,8 @@ class InternalMemMgr
 {
 public:
     InternalMemMgr(Device*   pDevice,
-                   Instance* pInstance);
+                   Instance* pInstance,
+                   bool      appMemory);
     ~InternalMemMgr() { Destroy(); }
 
     VkResult Init();
@@ -246,9 +316,25 @@ public:
     VkResult CalcSubAllocationPool(const MemoryPoolProperties& poolProps, void** ppPoolInfo);
 
 private:
-    typedef Util::List<InternalMemoryPool, PalAllocator>                                               MemoryPoolList;
+    typedef InternalMemoryPoolList                                                                     MemoryPoolList;
     typedef Util::HashMap<MemoryPoolProperties, MemoryPoolList*, PalAllocator, Util::JenkinsHashFunc>  MemoryPoolListMap;
 
+    // Statistics of how well the memory pools are used, reported with the InternalMemStats log tag.  The thread caches
+    // update these without taking the allocator lock, so every counter is only ever modified atomically.
+    struct PoolStats
+    {
+        volatile uint64_t poolCount;       // Number of memory pools
+        volatile uint64_t poolBytes;       // Total size of the memory pools
+        volatile uint64_t peakPoolBytes;   // Highest total size of the memory pools
+        volatile uint64_t requestedBytes;  // Sum of the requested sizes of live sub-allocations
+        volatile uint64_t reservedBytes;   // Pool space held by live sub-allocations, including rounding
+        volatile uint64_t slabCount;       // Number of live slabs
+        volatile uint64_t slabAllocCount;  // Number of sub-allocations carved out of slabs
+        volatile uint64_t buddyAllocCount; // Number of sub-allocations made by buddy allocators
+        volatile uint64_t cacheHitCount;   // Number of slab slots reused from the caches of freed slots, in addition
+                                           // to slabAllocCount
+    };
+
     VkResult CalcSubAllocationPoolInternal(
         const MemoryPoolProperties& poolProps,
         MemoryPoolList**            ppPoolInfo);
@@ -266,6 +352,33 @@ private:
         uint32_t                     allocMask,
         Pal::gpusize*                pSubAllocOffset);
 
+    VkResult BuddySubAllocate(
+        MemoryPoolList*              pPoolList,
+        const InternalMemCreateInfo& createInfo,
+        uint32_t                     allocMask,
+        InternalMemoryPool*          pPool,
+        Pal::gpusize*                pOffset);
+
+    VkResult SlabSubAllocate(
+        MemoryPoolList*              pPoolList,
+        const InternalMemCreateInfo& createInfo,
+        uint32_t                     classIdx,
+        uint32_t                     allocMask,
+        InternalMemory*              pInternalMemory);
+
+    void SlabFree(
+        InternalMemorySlab*          pSlab,
+        Pal::gpusize                 offset);
+
+    bool TakeCachedSlot(
+        const InternalMemCreateInfo& createInfo,
+        InternalMemory*              pInternalMemory);
+
+    void CacheSlot(
+        const InternalMemory*        pInternalMemory);
+
+    void LogPoolStats() const;
+
     VkResult AllocBaseGpuMem(
         const Pal::GpuMemoryCreateInfo& createInfo,
         const InternalMemCreateFlags&   memCreateFlags,
@@ -273,6 +386,9 @@ private:
         uint32_t                        allocMask,
         bool                            needShadow);
 
+    void DecreaseAccountedPoolSize(
+        const InternalMemoryPool* pGpuMemory);
+
     void FreeBaseGpuMem(
         const InternalMemoryPool*       pGpuMemory);
 
@@ -286,6 +402,13 @@ private:
 
     MemoryPoolProperties m_commonPoolProps[InternalPoolCount]; // Commonly used pool properties
     void*                m_pCommonPools[InternalPoolCount];    // Commonly used memory pools
+
+    bool                 m_slabsEnabled;    // Whether small sub-allocations are made from slabs
+    const bool           m_appMemory;       // Whether the pools hold application memory, whose full size counts
+                                            // toward the heap usage
+    PoolStats            m_poolStats;
+
+    InternalMemCache     m_caches[InternalMemCacheCount];  // Caches of freed slots in front of m_allocatorLock
 };
 
 } // namespace vk
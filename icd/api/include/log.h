@@ -42,6 +42,8 @@ namespace vk
 enum LogTagId : uint32_t {
     GeneralPrint,
     PipelineCompileTime,
+    QueueSubmitStats,
+    InternalMemStats,
     LogTagIdCount
 };
 
@@ -49,6 +51,8 @@ static const char* LogTag[LogTagIdCount] =
 {
     "GeneralPrint",
     "PipelineCompileTime",
+    "QueueSubmitStats",
+    "InternalMemStats",
 };
 
 static void AmdvlkLog(
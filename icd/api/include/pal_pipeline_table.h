@@ -0,0 +1,123 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  pal_pipeline_table.h
+ * @brief Device-level table of reference counted PAL pipeline objects shared by identical Vulkan pipelines.
+ ***********************************************************************************************************************
+ */
+
+#ifndef __PAL_PIPELINE_TABLE_H__
+#define __PAL_PIPELINE_TABLE_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_alloccb.h"
+#include "include/vk_defines.h"
+
+#include "palHashMap.h"
+#include "palMetroHash.h"
+#include "palMutex.h"
+
+namespace Pal
+{
+
+class IPipeline;
+
+}
+
+namespace vk
+{
+
+class Device;
+
+// Set of per-device PAL pipeline objects owned by a PalPipelineTable and referenced by one or more Vulkan pipelines.
+struct SharedPalPipeline
+{
+    Util::MetroHash::Hash key;                        // Key the pipelines are registered under
+    Pal::IPipeline*       pPipelines[MaxPalDevices];  // Per-device PAL pipeline objects
+    void*                 pPalMemory;                 // Storage of the PAL pipeline objects
+    uint32_t              refCount;                   // Reference count of Vulkan pipelines holding on to the objects
+    bool                  registered;                 // Whether the entry can be found by its key
+};
+
+// =====================================================================================================================
+// Device-level table of PAL pipeline objects keyed by the pipeline binaries they were created from and their PAL
+// create info.  Applications commonly create the same pipeline more than once, e.g. once per pipeline cache or
+// per material; every one of them then shares the PAL pipeline and the GPU memory its code was uploaded to instead of
+// creating and uploading them again.
+//
+// A pipeline misses the table in three steps: AllocPipeline() hands out an entry with storage for the PAL objects,
+// the caller creates them there, and Insert() publishes the entry.  Every entry returned by this object must be given
+// back to Release() exactly once.
+//
+// This object is owned by the Vulkan Device.
+class PalPipelineTable
+{
+public:
+    PalPipelineTable(Device* pDevice);
+
+    VkResult Init();
+
+    VK_INLINE bool IsEnabled() const
+        { return m_enabled; }
+
+    void BuildKey(
+        Util::MetroHash128*          pHasher,
+        const Util::MetroHash::Hash* pCacheIds,
+        const size_t*                pBinarySizes,
+        const void* const*           ppBinaries,
+        Util::MetroHash::Hash*       pKey) const;
+
+    SharedPalPipeline* Find(const Util::MetroHash::Hash& key);
+
+    SharedPalPipeline* AllocPipeline(
+        const Util::MetroHash::Hash& key,
+        size_t                       palPipelineSize);
+
+    SharedPalPipeline* Insert(SharedPalPipeline* pPipeline);
+
+    void Release(SharedPalPipeline* pPipeline);
+
+private:
+    static const uint32_t NumPipelineBuckets = 256;
+
+    void DestroyPipeline(SharedPalPipeline* pPipeline);
+
+    typedef Util::HashMap<Util::MetroHash::Hash,
+                          SharedPalPipeline*,
+                          PalAllocator,
+                          Util::JenkinsHashFunc> PipelineMap;
+
+    Device* const m_pDevice;
+    bool          m_enabled;
+    Util::Mutex   m_mutex;
+    PipelineMap   m_pipelines;
+};
+
+} // namespace vk
+
+#endif /* __PAL_PIPELINE_TABLE_H__ */
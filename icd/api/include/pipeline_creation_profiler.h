@@ -0,0 +1,128 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  pipeline_creation_profiler.h
+ * @brief Collects per-phase timing histograms of pipeline creation.
+ ***********************************************************************************************************************
+ */
+
+#ifndef __PIPELINE_CREATION_PROFILER_H__
+#define __PIPELINE_CREATION_PROFILER_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_defines.h"
+
+#include "palSysUtil.h"
+
+namespace vk
+{
+
+class Device;
+
+// Phases of vkCreateGraphicsPipelines() and vkCreateComputePipelines() timed by the PipelineCreationProfiler
+enum class PipelineCreationPhase : uint32_t
+{
+    Hash = 0,           // Building the API and compiler hashes of the create info
+    Convert,            // Converting the create info to compiler and PAL create info
+    CacheLookup,        // Looking up the pipeline binary in the pipeline caches
+    Compile,            // Compiling the pipeline binary
+    CreatePalPipeline,  // Creating the PAL pipeline objects
+    CreateStaticState,  // Creating or looking up the static state objects in the RenderStateCache
+    Total,              // The whole pipeline creation call
+    Count
+};
+
+// Time spent in each phase by one pipeline creation call, in CPU perf counter ticks.  Phases the call did not go
+// through are left zero.
+struct PipelineCreationTimes
+{
+    int64_t phase[static_cast<uint32_t>(PipelineCreationPhase::Count)];
+
+    VK_INLINE void Add(PipelineCreationPhase which, int64_t duration)
+        { phase[static_cast<uint32_t>(which)] += duration; }
+};
+
+// =====================================================================================================================
+// Collects a histogram of the time spent in each phase of pipeline creation, so that it can be seen where the time of
+// bulk pipeline creation goes.  Each creation call accumulates its phase times in a PipelineCreationTimes and hands
+// them to Record() once; recording only updates atomic counters, which keeps the profiler cheap enough to leave
+// enabled while running an application.  The histograms are written to a JSON file when the device is destroyed.
+//
+// This object is owned by the Vulkan Device.
+class PipelineCreationProfiler
+{
+public:
+    PipelineCreationProfiler(Device* pDevice);
+
+    void Init();
+
+    VK_INLINE bool IsEnabled() const
+        { return m_enabled; }
+
+    // Returns the start time of a phase, or 0 if profiling is disabled
+    VK_INLINE int64_t StartPhase() const
+        { return m_enabled ? Util::GetPerfCpuTime() : 0; }
+
+    // Adds the time since the given StartPhase() result to a phase of pTimes
+    VK_INLINE void EndPhase(
+        PipelineCreationPhase  phase,
+        int64_t                startTime,
+        PipelineCreationTimes* pTimes) const
+    {
+        if (m_enabled)
+        {
+            pTimes->Add(phase, Util::GetPerfCpuTime() - startTime);
+        }
+    }
+
+    void Record(const PipelineCreationTimes& times);
+
+    void Dump() const;
+
+private:
+    // Bucket i of a histogram counts the samples that took less than 2^i microseconds and were not counted by bucket
+    // i - 1.  The last bucket counts all longer samples.
+    static const uint32_t NumHistogramBuckets = 24;
+
+    struct PhaseStats
+    {
+        volatile uint64_t count;                           // Number of samples
+        volatile uint64_t totalTime;                       // Sum of the samples in CPU perf counter ticks
+        volatile uint32_t histogram[NumHistogramBuckets];  // Number of samples per duration range
+    };
+
+    Device* const m_pDevice;
+    bool          m_enabled;
+    int64_t       m_perfFrequency;
+
+    PhaseStats    m_phases[static_cast<uint32_t>(PipelineCreationPhase::Count)];
+};
+
+} // namespace vk
+
+#endif /* __PIPELINE_CREATION_PROFILER_H__ */
@@ -0,0 +1,159 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  queue_submit_thread.h
+ * @brief Thread that issues the PAL operations of a queue's submissions on behalf of the application's thread.
+ ***********************************************************************************************************************
+ */
+
+#ifndef __QUEUE_SUBMIT_THREAD_H__
+#define __QUEUE_SUBMIT_THREAD_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_defines.h"
+#include "include/vk_utils.h"
+
+#include "palEvent.h"
+#include "palQueue.h"
+#include "palThread.h"
+
+namespace vk
+{
+
+class Instance;
+
+// PAL queue operation recorded by Queue::Submit() or Queue::Present() and issued by a QueueSubmitThread.  All Vulkan
+// objects are resolved to their PAL objects when the operation is recorded.
+struct QueuedSubmitOp
+{
+    enum class Type : uint32_t
+    {
+        WaitSemaphore,
+        SignalSemaphore,
+        Submit,
+        Present,
+    };
+
+    Type  type;
+    void* pMemory;   // Instance memory to free once the operation has been issued, or nullptr
+
+    union
+    {
+        struct
+        {
+            Pal::IQueueSemaphore* pSemaphore;
+            uint64_t              value;           // Point value of a timeline semaphore, 0 otherwise
+        } semaphore;
+
+        struct
+        {
+            Pal::ICmdBuffer**     ppCmdBuffers;
+            uint32_t              cmdBufferCount;
+            Pal::IFence*          pFence;          // Fence signaled by the submission, or nullptr
+            Pal::CmdBufInfo       cmdBufInfo;      // Passed along with the command buffers if isValid is set
+        } submit;
+
+        Pal::PresentSwapChainInfo present;         // The present rectangles are kept in pMemory
+    };
+};
+
+// =====================================================================================================================
+// Thread that issues the PAL operations of one queue, so that the application's thread does not have to wait for
+// the kernel driver to accept each submission.  Operations are passed in through a single-producer single-consumer
+// ring: the queue, whose use is externally synchronized, is the only producer and this thread the only consumer.
+//
+// Operations are counted as they are pushed.  Anything that relies on an operation having reached PAL, e.g. waiting
+// for a fence it signals, first waits with WaitIssued() until the issued count has passed the operation's count.
+// Errors cannot be returned to the call that pushed the failing operation; the first one is kept until ConsumeResult()
+// reports it to the next submission or wait on the queue.  Only a lost device keeps being reported after that.
+// Presents keep their errors apart for ConsumePresentResult(), so that e.g. an out of date swap chain is reported by
+// the next present rather than by a submission.
+class QueueSubmitThread : public Util::Thread
+{
+public:
+    QueueSubmitThread(
+        Instance*    pInstance,
+        Pal::IQueue* pPalQueue);
+
+    Pal::Result Init();
+
+    void Push(const QueuedSubmitOp& op);
+
+    void WaitIssued(uint64_t opCount);
+
+    void Stop();
+
+    // Returns the number of operations pushed so far
+    VK_INLINE uint64_t GetPushedCount() const
+        { return m_pushedCount; }
+
+    // Returns whether the first opCount operations have been issued to PAL
+    VK_INLINE bool IsIssued(uint64_t opCount) const
+        { return (m_issuedCount >= opCount); }
+
+    // Waits until every operation pushed so far has been issued to PAL
+    VK_INLINE void WaitIdle()
+        { WaitIssued(m_pushedCount); }
+
+    // Returns the first error the thread ran into since the last call, see ConsumeResult(volatile uint32_t*)
+    VK_INLINE Pal::Result ConsumeResult()
+        { return ConsumeResult(&m_result); }
+
+    // Returns the first error a present ran into since the last call, see ConsumeResult(volatile uint32_t*)
+    VK_INLINE Pal::Result ConsumePresentResult()
+        { return ConsumeResult(&m_presentResult); }
+
+private:
+    static Pal::Result ConsumeResult(volatile uint32_t* pResult);
+    static void RecordResult(volatile uint32_t* pResult, Pal::Result result);
+
+    static const uint32_t RingSize = 256;
+
+    static void ThreadFunc(void* pParam);
+
+    void Run();
+    void Execute(const QueuedSubmitOp& op);
+
+    Instance* const       m_pInstance;
+    Pal::IQueue* const    m_pPalQueue;
+    Util::Event           m_event;         // Signaled when operations are pushed or the thread should stop
+    Util::Event           m_issuedEvent;   // Signaled when an operation has been issued
+
+    QueuedSubmitOp        m_ring[RingSize];
+    volatile uint64_t     m_pushedCount;   // Number of operations pushed, only written by the producer
+    volatile uint64_t     m_issuedCount;   // Number of operations issued, only written by the submission thread
+    volatile uint32_t     m_result;        // First error returned by PAL that has not been reported yet
+    volatile uint32_t     m_presentResult; // First error returned by a present that has not been reported yet
+    volatile bool         m_stop;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(QueueSubmitThread);
+};
+
+} // namespace vk
+
+#endif /* __QUEUE_SUBMIT_THREAD_H__ */
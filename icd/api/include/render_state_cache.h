@@ -148,6 +148,26 @@ public:
 private:
     static const uint32_t NumStateBuckets = 32;
 
+    // Each kind of state is guarded by its own lock so that pipelines created concurrently only contend when they
+    // register the same kind of state at the same time.
+    enum StateLock : uint32_t
+    {
+        StateLockInputAssembly = 0,
+        StateLockTriangleRaster,
+        StateLockPointLineRaster,
+        StateLockLineStipple,
+        StateLockDepthBias,
+        StateLockBlendConst,
+        StateLockDepthBounds,
+        StateLockViewport,
+        StateLockScissorRect,
+        StateLockSamplePattern,
+        StateLockMsaa,
+        StateLockColorBlend,
+        StateLockDepthStencil,
+        StateLockCount
+    };
+
     // State mapping for Pal::*Params -> uint32_t token mapping (for redundancy checking CmdSet* functions)
     struct StaticParamState
     {
@@ -175,6 +195,7 @@ private:
     template<class StateObject, typename InfoMap, typename RefMap>
     Pal::Result CreateStaticPalObjectState(
         uint32_t                                 settingMask,
+        StateLock                                lock,
         const typename StateObject::CreateInfo&  createInfo,
         const VkAllocationCallbacks*             pAllocator,
         VkSystemAllocationScope                  parentScope,
@@ -185,6 +206,7 @@ private:
     template<class StateObject, typename InfoMap, typename RefMap>
     void DestroyStaticPalObjectState(
         uint32_t                           settingsMask,
+        StateLock                          lock,
         typename StateObject::PalObject**  ppStates,
         const VkAllocationCallbacks*       pAllocator,
         InfoMap*                           pInfoMap,
@@ -199,6 +221,7 @@ private:
     template<typename ParamInfo, typename ParamHashMap>
     uint32_t CreateStaticParamsState(
         uint32_t         enabledType,
+        StateLock        lock,
         const ParamInfo& params,
         ParamHashMap*    pMap,
         uint32_t*        pNextId);
@@ -206,6 +229,7 @@ private:
     template<typename ParamInfo, typename ParamHashMap>
     void DestroyStaticParamsState(
         uint32_t         enabledType,
+        StateLock        lock,
         const ParamInfo& params,
         uint32_t         token,
         ParamHashMap*    pMap);
@@ -253,7 +277,7 @@ private:
         const VkAllocationCallbacks* pAllocator);
 
     Device* const                                 m_pDevice;
-    Util::Mutex                                   m_mutex;
+    Util::Mutex                                   m_mutexes[StateLockCount];
 
     // These hash tables map static graphics pipeline state to a unique token i.e. a perfect hash.
     Util::HashMap<Pal::InputAssemblyStateParams,
@@ -35,6 +35,7 @@
 #pragma once
 
 #include "include/vk_alloccb.h"
+#include "include/vk_utils.h"
 
 #include "pal.h"
 #include "palLinearAllocator.h"
@@ -101,6 +102,105 @@ private:
     Util::Mutex             m_lock;             // Lock protecting concurrent access to the manager
 };
 
+// =====================================================================================================================
+// Scratch array for the duration of a call.  Arrays of up to InlineCapacity elements live in storage inside the object,
+// so the common calls with a handful of elements neither open a virtual stack frame nor allocate.  Only larger arrays
+// fall back to a frame, which is opened on first use: either on the given allocator, or on one acquired from the stack
+// manager for the lifetime of this object.
+template <typename Elem, uint32_t InlineCapacity>
+class VirtualStackArray
+{
+public:
+    VirtualStackArray(VirtualStackAllocator* pAllocator)
+        :
+        m_pStackMgr(nullptr),
+        m_pAllocator(pAllocator),
+        m_pFrame(nullptr),
+        m_pLargeArray(nullptr)
+        {}
+
+    VirtualStackArray(VirtualStackMgr* pStackMgr)
+        :
+        m_pStackMgr(pStackMgr),
+        m_pAllocator(nullptr),
+        m_pFrame(nullptr),
+        m_pLargeArray(nullptr)
+        {}
+
+    ~VirtualStackArray()
+    {
+        if (m_pFrame != nullptr)
+        {
+            if (m_pLargeArray != nullptr)
+            {
+                m_pFrame->FreeArray(m_pLargeArray);
+            }
+
+            Util::Destructor(m_pFrame);
+        }
+
+        if ((m_pStackMgr != nullptr) && (m_pAllocator != nullptr))
+        {
+            m_pStackMgr->ReleaseAllocator(m_pAllocator);
+        }
+    }
+
+    // Returns storage for count elements, or nullptr if a large array could not be allocated.  Storage returned by an
+    // earlier call is no longer valid afterwards.
+    Elem* Alloc(size_t count)
+    {
+        if (m_pLargeArray != nullptr)
+        {
+            m_pFrame->FreeArray(m_pLargeArray);
+            m_pLargeArray = nullptr;
+        }
+
+        Elem* pArray = m_inlineArray;
+
+        if (count > InlineCapacity)
+        {
+            VirtualStackFrame* pFrame = GetFrame();
+
+            m_pLargeArray = (pFrame != nullptr) ? pFrame->AllocArray<Elem>(count) : nullptr;
+            pArray        = m_pLargeArray;
+        }
+
+        return pArray;
+    }
+
+    // Returns the virtual stack frame large arrays are allocated from, opening it if necessary
+    VirtualStackFrame* GetFrame()
+    {
+        if (m_pFrame == nullptr)
+        {
+            if ((m_pAllocator == nullptr) &&
+                (m_pStackMgr != nullptr)  &&
+                (m_pStackMgr->AcquireAllocator(&m_pAllocator) != Pal::Result::Success))
+            {
+                m_pAllocator = nullptr;
+            }
+
+            if (m_pAllocator != nullptr)
+            {
+                m_pFrame = VK_PLACEMENT_NEW(m_frameStorage) VirtualStackFrame(m_pAllocator);
+            }
+        }
+
+        return m_pFrame;
+    }
+
+private:
+    VirtualStackMgr* const  m_pStackMgr;        // Stack manager to acquire an allocator from, if none was given
+    VirtualStackAllocator*  m_pAllocator;       // Allocator of the frame
+    VirtualStackFrame*      m_pFrame;           // Frame opened for large arrays, or nullptr
+    Elem*                   m_pLargeArray;      // Array allocated from the frame, or nullptr
+
+    Elem                    m_inlineArray[InlineCapacity];
+    alignas(VirtualStackFrame) uint8_t m_frameStorage[sizeof(VirtualStackFrame)];
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(VirtualStackArray);
+};
+
 } // namespace vk
 
 #endif /* __VIRTUAL_STACK_MGR_H */
@@ -152,6 +152,11 @@ struct PerGpuRenderState
 struct AllGpuRenderState
 {
     const GraphicsPipeline*        pGraphicsPipeline;
+
+    // The bound graphics pipeline if none of the state it programmed (static tokens, state objects) has been touched
+    // since it was bound, otherwise null.  GraphicsPipeline::BindToCmdBuffer() uses it to look up a memoized delta.
+    const GraphicsPipeline*        pDeltaBasePipeline;
+
     const ComputePipeline*         pComputePipeline;
     const RenderPass*              pRenderPass;
     const Pal::IMsaaState* const * pBltMsaaStates;
@@ -260,6 +265,38 @@ struct TransformFeedbackState
     bool                enabled;
 };
 
+// Barriers recorded by vkCmdPipelineBarrier() that have not been executed yet.  Adjacent barriers are merged into a
+// single PAL barrier which is executed before the next command that does any GPU work.
+struct DeferredBarrierState
+{
+    static constexpr uint32_t MaxTransitionCount = 64;
+
+    Pal::BarrierInfo       info;                                  // Merged barrier; points at the arrays below
+    Pal::HwPipePoint       pipePoints[MaxHwPipePoints];           // Union of the signal pipe points
+    Pal::BarrierTransition transitions[MaxTransitionCount];       // Layout transitions, one per image subresource range
+    const Image*           pTransitionImages[MaxTransitionCount]; // Images of the above for multi-device groups
+    uint32_t               deviceMask;                            // Device mask the barriers were recorded with
+    bool                   pending;                               // Whether any barrier has been deferred
+};
+
+// PAL layouts that image subresource ranges were last transitioned to within a command buffer.  Entries never overlap;
+// once all are used they are replaced round robin.
+struct ImageLayoutTrackerState
+{
+    static constexpr uint32_t MaxEntryCount = 64;
+
+    struct Entry
+    {
+        const Pal::IImage* pImage;      // PAL image of the default device
+        Pal::SubresRange   subresRange; // Subresource range that was transitioned
+        Pal::ImageLayout   layout;      // Layout it was transitioned to
+    };
+
+    Entry    entries[MaxEntryCount];
+    uint32_t entryCount;
+    uint32_t nextReplaced; // Entry to replace once all are used
+};
+
 // =====================================================================================================================
 // A Vulkan command buffer.
 class CmdBuffer
@@ -618,6 +655,9 @@ public:
                   (((m_rpDeviceMask ^ deviceMask) & deviceMask) == 0));
 
         m_curDeviceMask = deviceMask;
+
+        // Devices that were disabled during the last pipeline bind may hold different state
+        m_state.allGpuState.pDeltaBasePipeline = nullptr;
     }
 
     VK_INLINE uint32_t GetDeviceMask() const
@@ -862,6 +902,20 @@ public:
         return m_pDevice->NumPalDevices() * numEvents;
     }
 
+    // Called before every command that does GPU work
+    VK_INLINE void FlushDeferredBarriers()
+    {
+        if ((m_pDeferredBarrier != nullptr) && m_pDeferredBarrier->pending)
+        {
+            ExecuteDeferredBarriers();
+        }
+
+        if (m_pBarrierLog != nullptr)
+        {
+            m_pBarrierLog->NotifyWork();
+        }
+    }
+
 #if VK_ENABLE_DEBUG_BARRIERS
     VK_INLINE void DbgBarrierPreCmd(uint32_t cmd)
     {
@@ -924,6 +978,27 @@ private:
         const VkImageMemoryBarrier*  pImageMemoryBarriers,
         Pal::BarrierInfo*            pBarrier);
 
+    bool DeferBarrier(
+        const Pal::BarrierInfo&       barrier,
+        const Pal::BarrierTransition* pTransitions,
+        const Image* const*           pTransitionImages);
+
+    void ExecuteDeferredBarriers();
+
+    bool GetTrackedImageLayout(
+        const Pal::IImage*      pImage,
+        const Pal::SubresRange& subresRange,
+        Pal::ImageLayout*       pLayout) const;
+
+    void TrackImageLayout(
+        const Pal::IImage*      pImage,
+        const Pal::SubresRange& subresRange,
+        const Pal::ImageLayout* pLayout);
+
+    void TrackImageLayoutTransition(
+        const VkImageMemoryBarrier& barrier,
+        Pal::BarrierTransition*     pTransition);
+
     enum RebindUserDataFlag : uint32_t
     {
         RebindUserDataDescriptorSets = 0x1,
@@ -1003,6 +1078,9 @@ private:
         PipelineBind apiBind
         ) const;
 
+    VK_INLINE bool IsComputePipelineBound(
+        const ComputePipeline* pPipeline) const;
+
     VK_INLINE static void ConvertPipelineBindPoint(
         VkPipelineBindPoint pipelineBindPoint,
         Pal::PipelineBindPoint* pPalBindPoint,
@@ -1055,6 +1133,9 @@ private:
 
     RenderPassInstanceState       m_renderPassInstance;
     TransformFeedbackState*       m_pTransformFeedbackState;
+    DeferredBarrierState*         m_pDeferredBarrier; // Pending merged vkCmdPipelineBarrier() barriers, if enabled
+    ImageLayoutTrackerState*      m_pImageLayouts;    // Layouts of transitioned images, if tracking is enabled
+    CmdBufferBarrierLog*          m_pBarrierLog;      // Barriers recorded so far, if barrier analysis is enabled
 
 #if VK_ENABLE_DEBUG_BARRIERS
     uint32_t                      m_dbgBarrierPreCmdMask;
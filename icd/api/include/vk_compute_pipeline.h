@@ -77,6 +77,9 @@ public:
 
     static void BindNullPipeline(CmdBuffer* pCmdBuffer);
 
+    VK_INLINE const Pal::DynamicComputeShaderInfo& GetComputeWaveLimitParams() const
+        { return m_info.computeWaveLimitParams; }
+
 protected:
     // Immediate state info that will be written during Bind() but is not
     // encapsulated within a state object.
@@ -98,6 +101,7 @@ protected:
     ComputePipeline(
         Device* const                        pDevice,
         Pal::IPipeline**                     pPalPipeline,
+        SharedPalPipeline*                   pSharedPalPipeline,
         const PipelineLayout*                pPipelineLayout,
         PipelineBinaryInfo*                  pPipelineBinary,
         const ImmedInfo&                     immedInfo,
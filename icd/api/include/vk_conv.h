@@ -49,9 +49,19 @@
 namespace vk
 {
 
+// Dense lookup table of a non-identity enum conversion, generated at compile time by the VK_TO_PAL_TABLE_COMPLEX macros
+template <typename DstType, size_t EntryCount>
+struct VkToPalLookupTable
+{
+    DstType entries[EntryCount];   // Converted value of each enum value
+    bool    valid[EntryCount];     // Whether each enum value is allowed to be converted
+    size_t  numHandled;            // Number of enum values handled by the mapping
+    size_t  numMatching;           // Number of enum values whose converted value equals the enum value
+};
+
 namespace convert
 {
-extern Pal::SwizzledFormat VkToPalSwizzledFormatLookupTableStorage[VK_FORMAT_END_RANGE + 1];
+extern const VkToPalLookupTable<Pal::SwizzledFormat, VK_FORMAT_END_RANGE + 1> VkToPalSwizzledFormatLookupTable;
 };
 
 constexpr uint32_t MaxPalAspectsPerMask         = 3;    // Images can have up to 3 planes (YUV image).
@@ -73,43 +83,39 @@ VK_INLINE Pal::SwizzledFormat VkToPalFormat(VkFormat format);
 // =====================================================================================================================
 // Macro to construct helper function for converting non-trivial non-identity mapping enums
 // The generated helper function's name takes the form "dstType convert::convertFunc(srcType)"
+// The lookup table is built at compile time, so the conversion is a single indexed load.  Its storage is provided by
+// VK_TO_PAL_DECL_LOOKUP_TABLE in vk_conv.cpp.
 // Checks performed:
-// - Checks at load-time whether all enum values in the source enum are handled
-// - Checks at load-time whether the enum actually needs a non-identity mapping
-// - Ensures that the lookup table initialization isn't done more than once
+// - Checks at compile-time whether all enum values in the source enum are handled
+// - Checks at compile-time whether the enum actually needs a non-identity mapping
 // - Checks at run-time whether an intentionally unhandled enum value is used
 #define VK_TO_PAL_TABLE_COMPLEX_WITH_SUFFIX(srcType, srcTypeName, dstType, convertFunc, mapping, suffix) \
     namespace convert \
     { \
-        extern dstType VkToPal##convertFunc##LookupTableStorage[VK_##srcType##_END_RANGE##suffix + 1]; \
-        extern const dstType* VkToPal##convertFunc##LookupTable; \
-        VK_DBG_DECL(extern bool VkToPal##convertFunc##Valid[VK_##srcType##_END_RANGE##suffix + 1]); \
-        static const dstType* InitVkToPal##convertFunc##LookupTable() \
+        typedef VkToPalLookupTable<dstType, VK_##srcType##_END_RANGE##suffix + 1> VkToPal##convertFunc##Table; \
+        constexpr VkToPal##convertFunc##Table BuildVkToPal##convertFunc##LookupTable() \
         { \
-            dstType* lookupTable = VkToPal##convertFunc##LookupTableStorage; \
-            VK_DBG_DECL(static size_t numMatching = 0); \
-            VK_DBG_DECL(static bool initialized = false); \
-            VK_DBG_CHECK(!initialized, "Lookup table of Vk" #srcTypeName " should not be initialized more than once"); \
-            VK_DBG_EXPR(initialized = true); \
+            VkToPal##convertFunc##Table table = {}; \
             for (size_t i = VK_##srcType##_BEGIN_RANGE##suffix; i <= VK_##srcType##_END_RANGE##suffix; ++i) \
             { \
-                VK_DBG_DECL(bool& valid = VkToPal##convertFunc##Valid[i]); \
-                VK_DBG_EXPR(valid = true); \
                 switch (i) \
                 { \
                 mapping \
                 default: \
-                    VK_DBG_CHECK(false, "Unhandled Vk" #srcTypeName " enum value"); \
+                    break; \
                 } \
             } \
-            VK_DBG_CHECK(numMatching != VK_##srcType##_RANGE_SIZE##suffix, "Enum Vk" #srcTypeName " should use " \
-                "identity mapping"); \
-            return lookupTable; \
+            return table; \
         } \
+        static_assert(BuildVkToPal##convertFunc##LookupTable().numHandled == VK_##srcType##_RANGE_SIZE##suffix, \
+                      "Not all Vk" #srcTypeName " enum values are handled"); \
+        static_assert(BuildVkToPal##convertFunc##LookupTable().numMatching != VK_##srcType##_RANGE_SIZE##suffix, \
+                      "Enum Vk" #srcTypeName " should use identity mapping"); \
+        extern const VkToPal##convertFunc##Table VkToPal##convertFunc##LookupTable; \
         VK_INLINE dstType convertFunc(Vk##srcTypeName value) \
         { \
-            VK_DBG_CHECK(VkToPal##convertFunc##Valid[value], "Enum value intentionally unhandled"); \
-            return VkToPal##convertFunc##LookupTable[value]; \
+            VK_DBG_CHECK(VkToPal##convertFunc##LookupTable.valid[value], "Enum value intentionally unhandled"); \
+            return VkToPal##convertFunc##LookupTable.entries[value]; \
         } \
     }
 
@@ -127,23 +133,27 @@ VK_INLINE Pal::SwizzledFormat VkToPalFormat(VkFormat format);
 // Macro to construct a single enum value's mapping for converting non-identity mapping enums
 #define VK_TO_PAL_ENTRY_X(srcValue, dstValue) \
     case VK_##srcValue: \
-        VK_DBG_EXPR(if ((int32_t)i == (int32_t)Pal::dstValue) numMatching++); \
-        lookupTable[i] = Pal::dstValue; \
+        table.entries[i]     = Pal::dstValue; \
+        table.valid[i]       = true; \
+        table.numHandled    += 1; \
+        table.numMatching   += ((int32_t)i == (int32_t)Pal::dstValue) ? 1 : 0; \
         break;
 
 // =====================================================================================================================
 // Macro to construct a single enum value's mapping for converting enum to struct
 #define VK_TO_PAL_STRUC_X(srcValue, dstValue) \
     case VK_##srcValue: \
-        lookupTable[i] = dstValue; \
+        table.entries[i]     = dstValue; \
+        table.valid[i]       = true; \
+        table.numHandled    += 1; \
         break;
 
 // =====================================================================================================================
 // Macro to make an enum value invalid in case of non-identity mapping enums
 #define VK_TO_PAL_ERROR_X(srcValue) \
     case VK_##srcValue: \
-        VK_DBG_EXPR(numMatching++); \
-        VK_DBG_EXPR(valid = false); \
+        table.numHandled    += 1; \
+        table.numMatching   += 1; \
         break;
 
 // =====================================================================================================================
@@ -221,10 +231,12 @@ VK_INLINE Pal::SwizzledFormat VkToPalFormat(VkFormat format);
 // Helper structure for mapping Vulkan primitive topology to PAL primitive type + adjacency
 struct PalPrimTypeAdjacency
 {
-    PalPrimTypeAdjacency()
+    constexpr PalPrimTypeAdjacency() :
+        primType(),
+        adjacency(false)
         { }
 
-    PalPrimTypeAdjacency(
+    constexpr PalPrimTypeAdjacency(
         Pal::PrimitiveType primType,
         bool               adjacency) :
         primType(primType),
@@ -848,10 +860,12 @@ VK_INLINE uint32_t PalToVkVideoProfileLevel(uint32_t level)
 // Helper structure for mapping Vulkan primitive topology to PAL primitive type + adjacency
 struct PalQueryTypePool
 {
-    PalQueryTypePool()
+    constexpr PalQueryTypePool() :
+        m_type(),
+        m_poolType()
     { }
 
-    PalQueryTypePool(
+    constexpr PalQueryTypePool(
         Pal::QueryType      type,
         Pal::QueryPoolType  poolType) :
         m_type(type),
@@ -1735,11 +1749,6 @@ VK_INLINE Pal::MemoryImageCopyRegion VkToPalMemoryImageCopyRegion(
     return region;
 }
 
-namespace convert
-{
-extern Pal::SwizzledFormat VkToPalSwizzledFormatLookupTableStorage[VK_FORMAT_END_RANGE + 1];
-};
-
 // =====================================================================================================================
 constexpr VK_INLINE Pal::SwizzledFormat PalFmt(
     Pal::ChNumFormat    chNumFormat,
@@ -1757,7 +1766,7 @@ VK_INLINE Pal::SwizzledFormat VkToPalFormat(VkFormat format)
 {
     if (VK_ENUM_IN_RANGE(format, VK_FORMAT))
     {
-        return convert::VkToPalSwizzledFormatLookupTableStorage[format];
+        return convert::VkToPalSwizzledFormatLookupTable.entries[format];
     }
     else
     {
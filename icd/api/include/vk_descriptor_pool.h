@@ -111,6 +111,26 @@ protected:
         return static_cast<uint32_t>(Util::VoidPtrDiff(pBlock, m_pDynamicAllocBlocks) / sizeof(DynamicAllocBlock));
     }
 
+    uint32_t AcquireDynamicAllocBlockIndex()
+    {
+        uint32_t blockIndex;
+
+        // Prefer recycling a released block structure.  Otherwise hand out the next block structure that has not been
+        // used since the last reset; tracking this high-water mark is what keeps Reset() independent of maxSets.
+        if (m_dynamicAllocBlockIndexStackCount > 0)
+        {
+            blockIndex = m_pDynamicAllocBlockIndexStack[--m_dynamicAllocBlockIndexStackCount];
+        }
+        else
+        {
+            VK_ASSERT(m_dynamicAllocBlockHighWaterMark < m_dynamicAllocBlockCount);
+
+            blockIndex = m_dynamicAllocBlockHighWaterMark++;
+        }
+
+        return blockIndex;
+    }
+
 #if DEBUG
     void SanityCheckDynamicAllocBlockList();
 #endif
@@ -122,8 +142,9 @@ protected:
     DynamicAllocBlock         m_dynamicAllocBlockFreeListHeader;    // Header for the list of free blocks
     DynamicAllocBlock*        m_pDynamicAllocBlocks;                // Storage of block structures
     uint32_t                  m_dynamicAllocBlockCount;             // Number of block structures
-    uint32_t*                 m_pDynamicAllocBlockIndexStack;       // Stack of indices of available block structures
-    uint32_t                  m_dynamicAllocBlockIndexStackCount;   // Number of available block structures
+    uint32_t*                 m_pDynamicAllocBlockIndexStack;       // Stack of indices of released block structures
+    uint32_t                  m_dynamicAllocBlockIndexStackCount;   // Number of released block structures
+    uint32_t                  m_dynamicAllocBlockHighWaterMark;     // Number of block structures used since last reset
 
     InternalMemory            m_internalMem;
     Pal::gpusize              m_gpuMemSize;                         // Required GPU memory size
@@ -169,7 +190,7 @@ private:
     template <uint32_t numPalDevices>
     VkDescriptorSet DescriptorSetHandleFromIndex(uint32_t idx) const;
 
-    uint32_t             m_nextFreeHandle;
+    uint32_t             m_nextFreeHandle;      // Index of the first set never allocated since the last reset
     uint32_t             m_maxSets;
 
     uint32_t*            m_pFreeIndexStack;
@@ -224,6 +245,9 @@ private:
 
     DescriptorPool(Device* pDevice);
 
+    template <uint32_t numPalDevices>
+    VkResult InitStagingMemory(size_t gpuMemSize);
+
     template <uint32_t numPalDevices>
     static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorPool(
         VkDevice                                    device,
@@ -257,6 +281,8 @@ private:
     InternalMemory       m_staticInternalMem; // Static Internal GPU memory
 
     DescriptorAddr       m_addresses[MaxPalDevices];
+
+    void*                m_pStagingMem;       // Cacheable copy of the descriptor memory if descriptor writes are staged
 };
 
 namespace entry
@@ -56,6 +56,8 @@ struct DescriptorAddr
     Pal::gpusize  fmaskGpuAddr;
     uint32_t*     staticCpuAddr;
     uint32_t*     fmaskCpuAddr;
+    uint32_t*     staticMappedAddr;   // Mapped GPU memory behind staticCpuAddr if descriptor writes are staged
+    uint32_t*     fmaskMappedAddr;    // Mapped GPU memory behind fmaskCpuAddr if descriptor writes are staged
 };
 
 // =====================================================================================================================
@@ -101,10 +103,30 @@ public:
         return m_dynamicDescriptorData[idx];
     }
 
+    // Returns true if CPU writes to this set go to a cacheable staging copy that has to be flushed to GPU memory.
+    bool IsStaged() const
+        { return (m_addresses[0].staticMappedAddr != nullptr); }
+
+    void MarkStagingDirty(uint32_t dwOffset, uint32_t dwCount)
+    {
+        if (IsStaged() && (dwCount > 0))
+        {
+            m_stagingDirtyDwBegin = Util::Min(m_stagingDirtyDwBegin, dwOffset);
+            m_stagingDirtyDwEnd   = Util::Max(m_stagingDirtyDwEnd, dwOffset + dwCount);
+        }
+    }
+
+    void FlushStaging();
+
+    void FlushStagedRange(uint32_t dwOffset, uint32_t dwCount);
+
     VK_INLINE static DescriptorSet* StateFromHandle(VkDescriptorSet set);
     VK_INLINE static Pal::gpusize GpuAddressFromHandle(uint32_t deviceIdx, VkDescriptorSet set);
     VK_INLINE static void UserDataPtrValueFromHandle(VkDescriptorSet set, uint32_t deviceIdx, uint32_t* pUserData);
 
+    static void FlushStagedRangeFromHandle(VkDescriptorSet set, uint32_t dwOffset, uint32_t dwCount)
+        { StateFromHandle(set)->FlushStagedRange(dwOffset, dwCount); }
+
      VK_INLINE static void PatchedDynamicDataFromHandle(
         VkDescriptorSet set,
         uint32_t        deviceIdx,
@@ -139,6 +161,10 @@ protected:
 
     uint32_t                    m_heapIndex;
 
+    // Dword range of the staging copy written since the last flush.  Only used if IsStaged() is true.
+    uint32_t                    m_stagingDirtyDwBegin;
+    uint32_t                    m_stagingDirtyDwEnd;
+
     // NOTE: This is hopefully only needed temporarily until SC implements proper support for buffer descriptors
     // with dynamic offsets. Until then we have to store the static portion of dynamic buffer descriptors in client
     // memory together with the descriptor set so that we are able to supply the patched version of the descriptors.
@@ -330,6 +356,13 @@ private:
         uint32_t                     deviceIdx,
         uint32_t                     descriptorCopyCount,
         const VkCopyDescriptorSet*   pDescriptorCopies);
+
+    template <uint32_t numPalDevices>
+    static void FlushStagedDescriptorSets(
+        uint32_t                     descriptorWriteCount,
+        const VkWriteDescriptorSet*  pDescriptorWrites,
+        uint32_t                     descriptorCopyCount,
+        const VkCopyDescriptorSet*   pDescriptorCopies);
 };
 
 // =====================================================================================================================
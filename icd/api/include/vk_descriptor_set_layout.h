@@ -35,8 +35,12 @@
 #pragma once
 
 #include "include/khronos/vulkan.h"
+#include "include/vk_alloccb.h"
 #include "include/vk_dispatch.h"
 
+#include "palHashMap.h"
+#include "palMutex.h"
+
 namespace Util
 {
 
@@ -175,6 +179,8 @@ public:
     VK_INLINE uint64_t GetApiHash() const
         { return m_apiHash; }
 
+    bool IsEqual(const DescriptorSetLayout& other) const;
+
 protected:
     DescriptorSetLayout(
         const Device*     pDevice,
@@ -213,6 +219,38 @@ protected:
     const CreateInfo          m_info;    // Create-time information
     const Device* const       m_pDevice; // Device pointer
     const uint64_t            m_apiHash;
+    uint32_t                  m_refCount; // Number of outstanding handles to this layout if it is interned
+    bool                      m_interned; // Whether this layout is owned by the device's DescriptorSetLayoutCache
+
+    friend class DescriptorSetLayoutCache;
+};
+
+// =====================================================================================================================
+// Device-level interning table for descriptor set layouts.  Layouts with identical contents share a single reference
+// counted object, and therefore a single VkDescriptorSetLayout handle, which Vulkan permits for non-dispatchable
+// handles.  Lookups are keyed by the layout's API hash and confirmed with a full equality check.
+//
+// This object is owned by the Vulkan Device.
+class DescriptorSetLayoutCache
+{
+public:
+    DescriptorSetLayoutCache(Device* pDevice);
+
+    VkResult Init();
+
+    DescriptorSetLayout* FindOrInsert(DescriptorSetLayout* pLayout);
+
+    bool Release(DescriptorSetLayout* pLayout);
+
+private:
+    static const uint32_t NumLayoutBuckets = 128;
+
+    Device* const               m_pDevice;
+    Util::Mutex                 m_mutex;
+
+    Util::HashMap<uint64_t,
+                  DescriptorSetLayout*,
+                  PalAllocator> m_layouts;   // Interned layouts keyed by their API hash
 };
 
 namespace entry
@@ -66,13 +66,21 @@ public:
 
 private:
 
+    struct TemplateUpdateInfo;
+
+    typedef void(*PfnFlushStagedRange)(
+        VkDescriptorSet             descriptorSet,
+        uint32_t                    dwOffset,
+        uint32_t                    dwCount);
+
     DescriptorUpdateTemplate(
-        uint32_t                    numEntries);
+        uint32_t                    numEntries,
+        PfnFlushStagedRange         pfnFlushStagedRange,
+        uint32_t                    stagingDwOffset,
+        uint32_t                    stagingDwCount);
 
     ~DescriptorUpdateTemplate();
 
-    struct TemplateUpdateInfo;
-
     typedef void(*PfnUpdateEntry)(
         const Device*               pDevice,
         VkDescriptorSet             descriptorSet,
@@ -117,6 +125,9 @@ private:
         VkDescriptorType                        descriptorType,
         const DescriptorSetLayout::BindingInfo& dstBinding);
 
+    static PfnFlushStagedRange GetFlushStagedRangeFunc(
+        const Device*                           pDevice);
+
     template <size_t imageDescSize, size_t fmaskDescSize,  bool updateFmask, uint32_t numPalDevices>
     static void UpdateEntrySampledImage(
             const Device*               pDevice,
@@ -161,6 +172,12 @@ private:
             const TemplateUpdateInfo&   entry);
 
     uint32_t                    m_numEntries;
+
+    // Set up if descriptor writes are staged: the static section dword range written by this template is copied to
+    // GPU memory once after all entries have been applied.
+    PfnFlushStagedRange         m_pfnFlushStagedRange;
+    uint32_t                    m_stagingDwOffset;
+    uint32_t                    m_stagingDwCount;
 };
 
 namespace entry
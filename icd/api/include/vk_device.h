@@ -37,6 +37,7 @@
 #include "include/khronos/vulkan.h"
 
 #include "include/vk_defines.h"
+#include "include/vk_descriptor_set_layout.h"
 #include "include/vk_dispatch.h"
 #include "include/vk_physical_device.h"
 #include "include/vk_queue.h"
@@ -44,8 +45,12 @@
 #include "include/app_shader_optimizer.h"
 #include "include/app_resource_optimizer.h"
 
+#include "include/graphics_sub_state_cache.h"
 #include "include/internal_mem_mgr.h"
 #include "include/log.h"
+#include "include/pal_pipeline_table.h"
+#include "include/pipeline_creation_profiler.h"
+#include "include/barrier_analyzer.h"
 #include "include/render_state_cache.h"
 #include "include/virtual_stack_mgr.h"
 #include "include/barrier_policy.h"
@@ -162,6 +167,12 @@ public:
 
     VkResult WaitIdle(void);
 
+    void WaitForSubmitPoint(uint64_t submitPoint, const Queue* pSkipQueue);
+
+    bool IsCompletionPointReached(uint64_t completionPoint) const;
+
+    Queue* GetQueueOfPoint(uint64_t point) const;
+
     VkResult AllocMemory(
         const VkMemoryAllocateInfo*                 pAllocInfo,
         const VkAllocationCallbacks*                pAllocator,
@@ -332,6 +343,9 @@ public:
     VK_FORCEINLINE InternalMemMgr* MemMgr()
         { return &m_internalMemMgr; }
 
+    VK_FORCEINLINE InternalMemMgr* AppMemMgr()
+        { return &m_appMemMgr; }
+
     VK_FORCEINLINE ShaderOptimizer* GetShaderOptimizer()
         { return &m_shaderOptimizer; }
 
@@ -553,6 +567,35 @@ public:
     VK_INLINE RenderStateCache* GetRenderStateCache()
         { return &m_renderStateCache; }
 
+    VK_INLINE DescriptorSetLayoutCache* GetDescriptorSetLayoutCache()
+        { return &m_descriptorSetLayoutCache; }
+
+    VK_INLINE GraphicsSubStateCache* GetGraphicsSubStateCache()
+        { return &m_graphicsSubStateCache; }
+
+    VK_INLINE PalPipelineTable* GetPalPipelineTable()
+        { return &m_palPipelineTable; }
+
+    VK_INLINE PipelineCreationProfiler* GetPipelineCreationProfiler()
+        { return &m_pipelineCreationProfiler; }
+
+    VK_INLINE BarrierAnalyzer* GetBarrierAnalyzer()
+        { return &m_barrierAnalyzer; }
+
+    // Returns a new non-zero ID identifying a graphics pipeline in other pipelines' bind delta caches.
+    VK_INLINE uint32_t AllocGraphicsPipelineBindId()
+    {
+        uint32_t bindId = Util::AtomicIncrement(&m_graphicsPipelineBindIdCounter);
+
+        // Zero marks an empty cache entry, so skip it if the counter wraps around.
+        if (bindId == 0)
+        {
+            bindId = Util::AtomicIncrement(&m_graphicsPipelineBindIdCounter);
+        }
+
+        return bindId;
+    }
+
     uint32_t GetPinnedSystemMemoryTypes() const;
 
     uint32_t GetPinnedHostMappedForeignMemoryTypes() const;
@@ -646,6 +689,7 @@ protected:
     Properties                          m_properties;
 
     InternalMemMgr                      m_internalMemMgr;
+    InternalMemMgr                      m_appMemMgr;               // Pools small application memory allocations
 
     ShaderOptimizer                     m_shaderOptimizer;
 
@@ -653,6 +697,18 @@ protected:
 
     RenderStateCache                    m_renderStateCache;
 
+    DescriptorSetLayoutCache            m_descriptorSetLayoutCache;
+
+    GraphicsSubStateCache               m_graphicsSubStateCache;
+
+    PalPipelineTable                    m_palPipelineTable;
+
+    PipelineCreationProfiler            m_pipelineCreationProfiler;
+
+    BarrierAnalyzer                     m_barrierAnalyzer;
+
+    volatile uint32_t                   m_graphicsPipelineBindIdCounter; // Last ID handed out to a graphics pipeline
+
     DispatchableQueue*                  m_pQueues[Queue::MaxQueueFamilies][Queue::MaxQueuesPerFamily];
 
     InternalPipeline                    m_timestampQueryCopyPipeline;
@@ -49,6 +49,8 @@ namespace vk
 {
 
 class Device;
+class Queue;
+class QueueSubmitThread;
 
 class Fence : public NonDispatchable<VkFence, Fence>
 {
@@ -87,6 +89,42 @@ public:
     VK_INLINE void SetActiveDevice(uint32_t deviceIdx)
         { m_activeDeviceMask |= (1 << deviceIdx); }
 
+    // Records that the fence is signaled by a submission that is issued along with the first opCount operations of
+    // the given submission thread.  Storing the thread publishes the count to threads polling or waiting for the fence.
+    VK_INLINE void SetPendingSubmission(QueueSubmitThread* pSubmitThread, uint64_t opCount)
+    {
+        m_submitOpCount = opCount;
+        Util::AtomicExchangePointer(reinterpret_cast<void* volatile*>(&m_pSubmitThread), pSubmitThread);
+    }
+
+    // Records the serial number of the Queue::Submit() or Queue::BindSparse() call the fence was passed to
+    VK_INLINE void SetSubmitSerial(Queue* pQueue, uint64_t submitSerial)
+    {
+        m_pSubmitQueue = pQueue;
+        m_submitSerial = submitSerial;
+    }
+
+    // Forgets the submission the fence was passed to when its payload is reset or replaced, which is externally
+    // synchronized
+    VK_INLINE void ClearPendingSubmission()
+    {
+        m_pSubmitThread = nullptr;
+        m_pSubmitQueue  = nullptr;
+    }
+
+    bool IsSubmissionPending() const;
+    void WaitForSubmission() const;
+
+    // Returns whether PAL has reported the fence as signaled since it was last reset, in which case it needs no more
+    // driver calls to poll.  Payloads shared with other handles can be reset behind our back and are never cached.
+    VK_FORCEINLINE bool IsKnownSignaled() const
+        { return m_knownSignaled; }
+
+    void SetKnownSignaled();
+
+    VK_INLINE void ClearKnownSignaled()
+        { m_knownSignaled = false; }
+
     VK_FORCEINLINE Pal::IFence* PalFence(int32_t idx) const
     {
         VK_ASSERT((idx >= 0) && (idx < static_cast<int32_t>(MaxPalDevices)));
@@ -97,11 +135,17 @@ public:
 private:
     Fence(uint32_t      numGroupedFences,
           Pal::IFence** pPalFences,
-          bool          canBeInherited)
+          bool          canBeInherited,
+          bool          signaled)
     :
     m_activeDeviceMask(0),
     m_groupedFenceCount(numGroupedFences),
-    m_pPalTemporaryFences(nullptr)
+    m_pPalTemporaryFences(nullptr),
+    m_pSubmitThread(nullptr),
+    m_submitOpCount(0),
+    m_pSubmitQueue(nullptr),
+    m_submitSerial(0),
+    m_knownSignaled(signaled)
     {
         memcpy(m_pPalFences, pPalFences, sizeof(pPalFences[0]) * numGroupedFences);
         m_flags.value          = 0;
@@ -114,6 +158,13 @@ private:
     Pal::IFence* m_pPalFences[MaxPalDevices];
     Pal::IFence* m_pPalTemporaryFences;
 
+    QueueSubmitThread* volatile m_pSubmitThread;  // Submission thread the fence's submission was pushed to
+    volatile uint64_t           m_submitOpCount;  // Operation count of m_pSubmitThread that includes that submission,
+                                                  // only valid while m_pSubmitThread is set
+    Queue*                      m_pSubmitQueue;   // Queue the fence's submission was made on, or nullptr if unknown
+    uint64_t                    m_submitSerial;   // Serial number of that submission, see SetSubmitSerial()
+    volatile bool               m_knownSignaled;  // Whether the fence is known to be signaled, see IsKnownSignaled()
+
     union
     {
         struct
@@ -122,7 +173,8 @@ private:
             uint32_t isOpened       : 1;
             uint32_t isReference    : 1;
             uint32_t canBeInherited : 1;
-            uint32_t reserved       : 28;
+            uint32_t isExported     : 1;   // The payload was exported by reference
+            uint32_t reserved       : 27;
         };
         uint32_t value;
     } m_flags;
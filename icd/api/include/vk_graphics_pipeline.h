@@ -34,6 +34,7 @@
 #include "include/vk_device.h"
 #include "include/vk_shader_code.h"
 #include "include/internal_mem_mgr.h"
+#include "include/graphics_sub_state_cache.h"
 
 #include "palCmdBuffer.h"
 #include "palColorBlendState.h"
@@ -47,6 +48,7 @@ namespace vk
 class Device;
 class PipelineCache;
 class StencilOpsCombiner;
+class RenderPass;
 class CmdBuffer;
 struct CmdBufferRenderState;
 
@@ -239,6 +241,7 @@ protected:
     GraphicsPipeline(
         Device* const                          pDevice,
         Pal::IPipeline**                       pPalPipeline,
+        SharedPalPipeline*                     pSharedPalPipeline,
         const PipelineLayout*                  pLayout,
         const ImmedInfo&                       immedInfo,
         uint32_t                               staticStateMask,
@@ -272,17 +275,54 @@ protected:
         bool                                        bresenhamEnable;
     };
 
+    // Hashes of the sub-states converted through the GraphicsSubStateCache.  BuildApiHash() hashes each sub-state once
+    // into these and adds them to the pipeline hashes.  ConvertGraphicsPipelineInfo() builds the cache keys from them.
+    struct SubStateHashes
+    {
+        GraphicsSubStateHash rasterization;
+        GraphicsSubStateHash multisample;
+        GraphicsSubStateHash colorBlend;
+    };
+
     static void ConvertGraphicsPipelineInfo(
         Device*                             pDevice,
         const VkGraphicsPipelineCreateInfo* pIn,
         const VbBindingInfo*                pVbInfo,
+        const SubStateHashes&               subStateHashes,
         CreateInfo*                         pInfo);
 
     static void BuildRasterizationState(
         Device*                                       pDevice,
         const VkPipelineRasterizationStateCreateInfo* pIn,
-        CreateInfo*                                   pInfo,
-        const bool                                    dynamicStateFlags[]);
+        const bool                                    dynamicStateFlags[],
+        GraphicsRasterizationBlock*                   pBlock);
+
+    static void BuildMultisampleState(
+        const VkPipelineMultisampleStateCreateInfo* pMs,
+        const RenderPass*                           pRenderPass,
+        uint32_t                                    subpass,
+        bool                                        bresenhamEnable,
+        const bool                                  dynamicStateFlags[],
+        GraphicsMultisampleBlock*                   pBlock);
+
+    static void BuildColorBlendState(
+        const VkPipelineColorBlendStateCreateInfo* pCb,
+        const RenderPass*                          pRenderPass,
+        uint32_t                                   subpass,
+        const bool                                 dynamicStateFlags[],
+        GraphicsColorBlendBlock*                   pBlock);
+
+    static void ApplyRasterizationState(
+        const GraphicsRasterizationBlock& block,
+        CreateInfo*                       pInfo);
+
+    static void ApplyMultisampleState(
+        const GraphicsMultisampleBlock& block,
+        CreateInfo*                     pInfo);
+
+    static void ApplyColorBlendState(
+        const GraphicsColorBlendBlock& block,
+        CreateInfo*                    pInfo);
 
     static void GenerateHashFromVertexInputStateCreateInfo(
         Util::MetroHash128*                         pHasher,
@@ -326,9 +366,38 @@ protected:
 
     static uint64_t BuildApiHash(
         const VkGraphicsPipelineCreateInfo* pCreateInfo,
-        Util::MetroHash::Hash*              pBaseHash);
+        Util::MetroHash::Hash*              pBaseHash,
+        SubStateHashes*                     pSubStateHashes);
 
 private:
+    // State groups programmed by BindToCmdBuffer().  A bind delta is a mask of the groups that have to be redundancy
+    // checked when switching from one particular pipeline to this one; groups outside of it are known to be unchanged.
+    enum BindDeltaGroup : uint32_t
+    {
+        BindDeltaViewport        = 0x0001,
+        BindDeltaScissor         = 0x0002,
+        BindDeltaPipeline        = 0x0004,
+        BindDeltaDepthStencil    = 0x0008,
+        BindDeltaColorBlend      = 0x0010,
+        BindDeltaMsaa            = 0x0020,
+        BindDeltaInputAssembly   = 0x0040,
+        BindDeltaTriangleRaster  = 0x0080,
+        BindDeltaPointLineRaster = 0x0100,
+        BindDeltaLineStipple     = 0x0200,
+        BindDeltaDepthBias       = 0x0400,
+        BindDeltaBlendConst      = 0x0800,
+        BindDeltaDepthBounds     = 0x1000,
+        BindDeltaSamplePattern   = 0x2000,
+        BindDeltaPerDevice       = 0x3FFC,   // Groups programmed in the per-device loop
+        BindDeltaAll             = 0x3FFF
+    };
+
+    // Number of direct-mapped entries in the per-pipeline bind delta cache
+    static constexpr uint32_t BindDeltaCacheSize = 8;
+
+    uint32_t GetBindDelta(const GraphicsPipeline* pPrevPipeline) const;
+    uint32_t ComputeBindDelta(const GraphicsPipeline* pPrevPipeline) const;
+
     ImmedInfo                 m_info;                             // Immediate state that will go in CmdSet* functions
     Pal::IMsaaState*          m_pPalMsaa[MaxPalDevices];          // PAL MSAA state object
     Pal::IColorBlendState*    m_pPalColorBlend[MaxPalDevices];    // PAL color blend state object
@@ -337,6 +406,12 @@ private:
 
     uint32_t                  m_coverageSamples;
 
+    const uint32_t            m_bindId;                           // Unique ID keying other pipelines' delta caches
+
+    // Bind deltas from recently seen previous pipelines, each stored as (previous pipeline's m_bindId << 32) | delta.
+    // Entries are written atomically since a pipeline may be bound by several command buffers concurrently.
+    mutable volatile uint64_t m_bindDeltaCache[BindDeltaCacheSize];
+
     union
     {
         uint8_t value;
@@ -38,6 +38,7 @@
 #include "include/vk_defines.h"
 #include "include/vk_dispatch.h"
 #include "include/vk_utils.h"
+#include "include/internal_mem_mgr.h"
 #include "palGpuMemory.h"
 
 namespace Pal
@@ -54,6 +55,14 @@ class Image;
 namespace vk
 {
 
+// Base address alignment of small application memory allocations that are sub-allocated from shared pools.  Images
+// small enough to be bound to such memory pad their size so that their base address can be aligned at bind time.
+static constexpr VkDeviceSize MemorySubAllocAlignment = 256;
+
+// Largest application memory allocation that is sub-allocated from the shared pools, which is the largest
+// sub-allocation the InternalMemMgr pools make
+static constexpr VkDeviceSize MemorySubAllocLimit     = 128 * 1024;
+
 // =====================================================================================================================
 // Helper structure representing a IGpuMemory priority+offset pair.
 union MemoryPriority
@@ -137,6 +146,16 @@ public:
 
     VkResult GetCommitment(VkDeviceSize* pCommittedMemoryInBytes);
 
+    VkResult CommitResidency();
+
+    static bool IsSubAllocSize(
+        const Device* pDevice,
+        VkDeviceSize  size);
+
+    // Returns the offset of this memory within its PAL memory objects, which is only non-zero for sub-allocations
+    VK_INLINE Pal::gpusize PalOffset() const
+        { return m_subAllocated ? m_subAllocation.Offset() : 0; }
+
     VK_INLINE const Pal::GpuMemoryCreateInfo& PalInfo() const { return m_info; }
 
     void ElevatePriority(MemoryPriority priority);
@@ -179,6 +198,15 @@ private:
     Pal::IImage*          m_pExternalPalImage;
     uint32_t              m_primaryDeviceIndex;
 
+    // Lazy residency state, guarded by the device memory mutex once the object has been created
+    bool                  m_lazyResidency;      // Residency is committed when the memory is first bound or mapped
+    bool                  m_residencyDeferred;  // The memory has not been added to the residency list yet
+
+    // Small allocations are sub-allocated from the pools of the device's application memory manager and share the
+    // PAL memory objects of those pools
+    bool                  m_subAllocated;
+    InternalMemory        m_subAllocation;
+
     // Cache the handle of GPU memory which is on the first device, if the Gpumemory can be inter-process sharing.
     Pal::OsExternalHandle m_sharedGpuMemoryHandle;
     // m_handleCloseNeeded indicates if m_sharedGpuMemoryHandle should be closed.
@@ -215,6 +243,13 @@ private:
         bool                            multiInstanceHeap,
         Memory**                        ppMemory);
 
+    static VkResult CreateSubAllocatedMemory(
+        Device*                         pDevice,
+        const VkAllocationCallbacks*    pAllocator,
+        const Pal::GpuMemoryCreateInfo& createInfo,
+        bool                            hostVisible,
+        Memory**                        ppMemory);
+
     static VkResult CreateGpuPinnedMemory(
         Device*                         pDevice,
         const VkAllocationCallbacks*    pAllocator,
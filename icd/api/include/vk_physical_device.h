@@ -753,6 +753,8 @@ protected:
         Pal::gpusize totalMemorySize[Pal::GpuHeap::GpuHeapCount];     // The total memory (in bytes) per heap
     } m_memoryUsageTracker;
 
+    Pal::gpusize GetHeapBudget(uint32_t heapIndex) const;
+
     uint8_t                          m_pipelineCacheUUID[VK_UUID_SIZE];
 
     Util::IPlatformKey*              m_pPlatformKey;             // Platform identifying key
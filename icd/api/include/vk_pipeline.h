@@ -60,6 +60,7 @@ class  ComputePipeline;
 class  GraphicsPipeline;
 class  PipelineLayout;
 struct RuntimeSettings;
+struct SharedPalPipeline;
 
 // The top-level user data layout is portioned into different sections based on the value type (push constant,
 // descriptor set addresses, etc.).  This structure describes the offsets and sizes of those regions.
@@ -156,6 +157,7 @@ protected:
 
     void Init(
         Pal::IPipeline**      pPalPipeline,
+        SharedPalPipeline*    pSharedPalPipeline,
         const PipelineLayout* pLayout,
         PipelineBinaryInfo*   pBinary,
         uint32_t              staticStateMask,
@@ -172,6 +174,8 @@ protected:
     Device* const                      m_pDevice;
     UserDataLayout                     m_userDataLayout;
     Pal::IPipeline*                    m_pPalPipeline[MaxPalDevices];
+    SharedPalPipeline*                 m_pSharedPalPipeline; // Owner of m_pPalPipeline if it is shared with other
+                                                             // pipelines, nullptr if it is owned by this pipeline
     uint64_t                           m_palPipelineHash; // Unique hash for Pal::Pipeline
     uint32_t                           m_staticStateMask; // Bitfield to detect which subset of pipeline state is
                                                           // static (written at bind-time as opposed to via vkCmd*).
@@ -119,8 +119,30 @@ public:
         uint32_t            numRsrcMapNodes;
         // Number of resource mapping nodes used for the user data nodes
         uint32_t            numUserDataNodes;
+        // Number of static section resource mapping nodes needed by all layouts in the chain
+        uint32_t            numStaRsrcMapNodes;
         // Number of DescriptorRangeValue needed by all layouts in the chain
         uint32_t            numDescRangeValueNodes;
+        // Byte size of the pipeline-independent resource mapping built once at layout creation time
+        size_t              mappingCacheSize;
+    };
+
+    // The part of the LLPC resource mapping that does not depend on the pipeline being compiled.  It is built once
+    // when the layout is created and shared by every pipeline compiled with this layout.
+    struct MappingCache
+    {
+#if LLPC_CLIENT_INTERFACE_MAJOR_VERSION >= 39
+        Vkgc::ResourceMappingNode*  pUserDataNodes;       // Push constant and descriptor set user data nodes
+        Vkgc::ResourceMappingNode*  pStaNodes;            // Static section nodes referenced by set pointer nodes
+        Vkgc::DescriptorRangeValue* pDescRangeValues;     // Immutable sampler descriptor ranges
+#else
+        Llpc::ResourceMappingNode*  pUserDataNodes;       // Push constant and descriptor set user data nodes
+        Llpc::ResourceMappingNode*  pStaNodes;            // Static section nodes referenced by set pointer nodes
+        Llpc::DescriptorRangeValue* pDescRangeValues;     // Immutable sampler descriptor ranges
+#endif
+        uint32_t                    userDataNodeCount;    // Number of valid entries in pUserDataNodes
+        uint32_t                    staNodeCount;         // Number of valid entries in pStaNodes
+        uint32_t                    descRangeValueCount;  // Number of valid entries in pDescRangeValues
     };
 
     typedef VkPipelineLayout ApiType;
@@ -190,6 +212,8 @@ protected:
 
     ~PipelineLayout() { }
 
+    void BuildLlpcMappingCache(void* pCacheMem);
+
     VkResult BuildLlpcSetMapping(
         uint32_t                     setIndex,
         const DescriptorSetLayout*   pLayout,
@@ -228,6 +252,7 @@ protected:
     const PipelineInfo      m_pipelineInfo;
     const Device* const     m_pDevice;
     const uint64_t          m_apiHash;
+    MappingCache            m_mappingCache;
 };
 
 static_assert(alignof(PipelineLayout::SetUserDataLayout) <= alignof(PipelineLayout),
@@ -40,6 +40,7 @@
 #include "include/vk_instance.h"
 #include "include/vk_utils.h"
 #include "include/virtual_stack_mgr.h"
+#include "include/queue_submit_thread.h"
 
 #include "palDeque.h"
 #include "palQueue.h"
@@ -58,7 +59,9 @@ struct CmdBufGpuMem;
 class  Device;
 class  DevModeMgr;
 class  DispatchableQueue;
+class  Fence;
 class  Instance;
+class  Semaphore;
 class  SwapChain;
 class  FrtcFramePacer;
 class  TurboSync;
@@ -67,8 +70,15 @@ class  SqttQueueState;
 // State of a command buffer.
 struct CmdBufState
 {
-    Pal::ICmdBuffer*    pCmdBuf;     // Command buffer pointer
-    Pal::IFence*        pFence;      // Fence that will be signaled when this fence's submit completes
+    Pal::ICmdBuffer*    pCmdBuf;        // Command buffer pointer
+    Pal::IFence*        pFence;         // Fence that will be signaled when this fence's submit completes, only
+                                        // used if the queue has no internal timeline semaphore
+    bool                isBegun;        // The command buffer has been begun and nothing has been recorded into it yet
+    bool                isPending;      // The command buffer has been submitted and may not have completed yet
+    uint64_t            submitOpCount;  // Operation count of the queue's submission thread that includes the
+                                        // submission, 0 if it was issued directly
+    uint64_t            timelineValue;  // Value the queue's internal timeline semaphore is signaled with after the
+                                        // submission
 };
 
 // =====================================================================================================================
@@ -124,8 +134,9 @@ public:
 
     enum
     {
-        MaxQueueFamilies    = Pal::EngineTypeCount,  // Maximum number of queue families
-        MaxQueuesPerFamily  = 8,                     // Maximum number of queues per family
+        MaxQueueFamilies      = Pal::EngineTypeCount,  // Maximum number of queue families
+        MaxQueuesPerFamily    = 8,                     // Maximum number of queues per family
+        SubmitPointQueueShift = 48,                    // Position of the queue in a submit point
     };
 
     VK_FORCEINLINE Pal::IQueue* PalQueue(int32_t idx) const
@@ -157,6 +168,41 @@ public:
         const Pal::CmdBufInfo&     cmdBufInfo,
         CmdBufState*               pCmdBufState);
 
+    // Returns the submit point of the last operation pushed to the submission thread, or 0 without a thread.  A submit
+    // point holds the queue's position in the device plus one above SubmitPointQueueShift and an operation count of
+    // its thread below, so that it can be recorded in other objects with a single atomic write.
+    VK_INLINE uint64_t GetSubmitPoint() const
+        { return (m_pSubmitThread == nullptr) ? 0 : (GetPointQueueBits() | m_pSubmitThread->GetPushedCount()); }
+
+    // Returns the completion point of the Submit() or BindSparse() call in progress.  It is laid out like a submit
+    // point but holds the serial number of the call instead of an operation count.  A fence that is known to be
+    // signaled tells that the calls up to its own have completed on the GPU, see ObserveCompletedSubmitSerial().
+    VK_INLINE uint64_t GetCompletionPoint() const
+        { return GetPointQueueBits() | m_submitSerial; }
+
+    VK_INLINE uint64_t GetCompletedSubmitSerial() const
+        { return m_completedSubmitSerial; }
+
+    void ObserveCompletedSubmitSerial(uint64_t submitSerial);
+
+    // Waits until the submission thread, if any, has issued its first opCount operations
+    VK_INLINE void WaitSubmitThreadIssued(uint64_t opCount)
+    {
+        if (m_pSubmitThread != nullptr)
+        {
+            m_pSubmitThread->WaitIssued(opCount);
+        }
+    }
+
+    // Waits until the submission thread, if any, has issued everything submitted to this queue so far
+    VK_INLINE void WaitSubmitThreadIdle()
+    {
+        if (m_pSubmitThread != nullptr)
+        {
+            m_pSubmitThread->WaitIdle();
+        }
+    }
+
 protected:
     // This is a helper structure during a virtual remap (sparse bind) call to batch remaps into
     // as few calls as possible.
@@ -220,6 +266,27 @@ protected:
 
     VkResult CreateDummyCmdBuffer();
 
+    void CreateSubmitThread();
+
+    // Returns the queue's position in the device plus one, shifted into place for a submit or completion point
+    VK_INLINE uint64_t GetPointQueueBits() const
+    {
+        return static_cast<uint64_t>((m_queueFamilyIndex * MaxQueuesPerFamily) + m_queueIndex + 1) <<
+               SubmitPointQueueShift;
+    }
+
+    VkResult SubmitToThread(
+        uint32_t            submitCount,
+        const VkSubmitInfo* pSubmits,
+        Fence*              pFence);
+
+    void PushWaitSemaphore(
+        Semaphore*          pSemaphore,
+        uint64_t            value);
+
+    void PushPresent(
+        const Pal::PresentSwapChainInfo& presentInfo);
+
     void CreateCmdBufRing(
         uint32_t                   deviceIdx);
 
@@ -236,6 +303,25 @@ protected:
     CmdBufState* AcquireInternalCmdBuf(
         uint32_t                   deviceIdx);
 
+    bool IsInternalCmdBufComplete(
+        uint32_t                   deviceIdx,
+        const CmdBufState*         pCmdBufState);
+
+    void WaitInternalCmdBuf(
+        uint32_t                   deviceIdx,
+        const CmdBufState*         pCmdBufState);
+
+    Pal::Result BeginInternalCmdBuf(
+        uint32_t                   deviceIdx,
+        CmdBufState*               pCmdBufState);
+
+    void RetireInternalCmdBuf(
+        uint32_t                   deviceIdx);
+
+    void ReleaseUnusedInternalCmdBuf(
+        uint32_t                   deviceIdx,
+        CmdBufState*               pCmdBufState);
+
     bool BuildPostProcessCommands(
         uint32_t                         deviceIdx,
         CmdBufState*                     pCmdBufState,
@@ -263,6 +349,24 @@ protected:
         uint32_t                         deviceIdx,
         const Pal::PresentSwapChainInfo* pPresentInfo);
 
+    // Statistics of Submit(), reported with the QueueSubmitStats log tag when the queue is destroyed
+    struct SubmitStats
+    {
+        uint64_t submitCalls;     // Number of Submit() calls
+        uint64_t batchCount;      // Number of VkSubmitInfos passed to Submit()
+        uint64_t palSubmitCount;  // Number of PAL submissions, each of which costs a kernel submission
+        uint64_t submitTime;      // CPU time spent in Submit() in perf counter ticks
+    };
+
+    // Statistics of the internal command buffer rings, reported along with SubmitStats
+    struct InternalCmdBufStats
+    {
+        uint64_t acquireCount;    // Number of AcquireInternalCmdBuf() calls
+        uint64_t readyCount;      // Acquires that got a command buffer that was already begun
+        uint64_t createCount;     // Number of command buffers created for the rings
+        uint64_t stallCount;      // Acquires that had to wait for the oldest command buffer of a full ring
+    };
+
     Pal::IQueue*                       m_pPalQueues[MaxPalDevices];
     Device* const                      m_pDevice;
     uint32_t                           m_queueFamilyIndex;   // This queue's family index
@@ -276,6 +380,23 @@ protected:
     SqttQueueState*                    m_pSqttState; // Per-queue state for handling SQ thread-tracing annotations
     typedef Util::Deque<CmdBufState*, PalAllocator> CmdBufRing;
     CmdBufRing*                        m_pCmdBufRing[MaxPalDevices];
+
+    // Timeline semaphore signaled after each internal command buffer submission, through which their completion is
+    // tracked if the OS supports timeline semaphores
+    struct InternalTimeline
+    {
+        Pal::IQueueSemaphore* pSemaphore;      // Created along with the command buffer ring, or nullptr
+        uint64_t              signaledValue;   // Value signaled after the latest internal submission
+        uint64_t              completedValue;  // Highest value the semaphore is known to have reached
+    };
+
+    InternalTimeline                   m_internalTimeline[MaxPalDevices];
+    SubmitStats                        m_submitStats;
+    InternalCmdBufStats                m_internalCmdBufStats;
+    QueueSubmitThread*                 m_pSubmitThread;    // Thread issuing this queue's submissions, or nullptr
+                                                           // if they are issued directly
+    uint64_t                           m_submitSerial;     // Serial number of the latest Submit() or BindSparse()
+    volatile uint64_t                  m_completedSubmitSerial; // Highest serial number known to have completed
 };
 
 VK_DEFINE_DISPATCHABLE(Queue);
@@ -136,6 +136,34 @@ public:
 #endif
     }
 
+    // Returns whether the timeline payload is known to have reached the given value, which answers waits for values
+    // that have already been observed on the host without asking the kernel driver.
+    VK_FORCEINLINE bool IsTimelineValueReached(uint64_t value) const
+    {
+        return (m_useTempSemaphore == false) && (m_timelineValue >= value);
+    }
+
+    void ObserveTimelineValue(uint64_t value);
+
+    void RecordTimelineSignal(uint64_t value, uint64_t completionPoint);
+
+    void RefreshTimelineValue(const Device* pDevice);
+
+    // Records the submit points, see Queue::GetSubmitPoint(), of the latest signal and wait operations on the semaphore
+    // that were pushed to a submission thread.  Only those have to be issued before the payload is waited for, exported
+    // or replaced.  A binary semaphore has at most one pending signal and wait, and for a timeline semaphore the latest
+    // signal is the one with the highest value.
+    VK_INLINE void SetSignalSubmitPoint(uint64_t submitPoint)
+        { Util::AtomicExchange64(&m_signalSubmitPoint, submitPoint); }
+
+    VK_INLINE void SetWaitSubmitPoint(uint64_t submitPoint)
+        { Util::AtomicExchange64(&m_waitSubmitPoint, submitPoint); }
+
+    VK_INLINE uint64_t GetSignalSubmitPoint() const
+        { return m_signalSubmitPoint; }
+
+    void WaitForQueuedOps(Device* pDevice) const;
+
 private:
     Semaphore(
         Pal::IQueueSemaphore*                pPalSemaphore[],
@@ -146,7 +174,15 @@ private:
         m_palCreateInfo(palCreateInfo),
         m_useTempSemaphore(false),
         m_sharedSemaphoreHandle(sharedSemaphorehandle),
-        m_sharedSemaphoreTempHandle(0)
+        m_sharedSemaphoreTempHandle(0),
+        m_payloadShared(palCreateInfo.flags.shareable != 0),
+        m_timelineValue(palCreateInfo.initialCount),
+        m_signaledValue(palCreateInfo.initialCount),
+        m_signalCompletionPoint(0),
+        m_signalQueueBits(0),
+        m_multiQueueSignals(0),
+        m_signalSubmitPoint(0),
+        m_waitSubmitPoint(0)
     {
         for (uint32_t i = 0; i < semaphoreCount; i++)
         {
@@ -160,6 +196,8 @@ private:
         memset(m_pPalTemporarySemaphores, 0, sizeof(m_pPalTemporarySemaphores));
     }
 
+    static void RaiseValue(volatile uint64_t* pTarget, uint64_t value);
+
     Pal::QueueSemaphoreCreateInfo   m_palCreateInfo;
 
     Pal::IQueueSemaphore*           m_pPalSemaphores[MaxPalDevices];
@@ -175,6 +213,23 @@ private:
     Pal::OsExternalHandle           m_sharedSemaphoreHandle;
     Pal::OsExternalHandle           m_sharedSemaphoreTempHandle;
 
+    // Whether the payload may be signaled outside of this device, e.g. because it was exported or imported.
+    bool                            m_payloadShared;
+
+    // Highest timeline payload value observed on the host.  Timeline values only ever increase, so this is a lower
+    // bound of the current value.
+    volatile uint64_t               m_timelineValue;
+
+    // Highest timeline value any signal operation of this device was issued for, and the completion point of the
+    // latest queue signal, see RecordTimelineSignal().
+    volatile uint64_t               m_signaledValue;
+    volatile uint64_t               m_signalCompletionPoint;
+
+    volatile uint32_t               m_signalQueueBits;    // Queue bits of the completion point of the first signal
+    volatile uint32_t               m_multiQueueSignals;  // Set once signals have come from more than one queue
+
+    volatile uint64_t               m_signalSubmitPoint;  // See SetSignalSubmitPoint()
+    volatile uint64_t               m_waitSubmitPoint;    // See SetWaitSubmitPoint()
 };
 
 namespace entry
@@ -86,6 +86,7 @@ protected:
     const void*                m_pCode;
     ShaderModuleHandle         m_handle;
     Pal::ShaderHash            m_codeHash;
+    Pal::ShaderHash            m_mainEntryCodeHash;   // GetCodeHash() result for the "main" entry point
 };
 
 namespace entry
@@ -134,6 +134,16 @@ public:
     VK_INLINE bool IsHwCompositingSupported() const
         { return (m_properties.flags.hwCompositing == 1); }
 
+    // Returns whether presents can be issued by a queue's submission thread.  The fullscreen manager needs the result
+    // of each present right away, and the software compositor issues work on other queues.
+    VK_INLINE bool CanQueuePresent() const
+        { return (m_pFullscreenMgr == nullptr) && (m_pSwCompositor == nullptr); }
+
+    // Records the submit point, see Queue::GetSubmitPoint(), of the latest present pushed to a submission thread.  The
+    // PAL swap chain only learns about the present once it has been issued.
+    VK_INLINE void SetPresentSubmitPoint(uint64_t submitPoint)
+        { Util::AtomicExchange64(&m_presentSubmitPoint, submitPoint); }
+
     VK_INLINE const Pal::ScreenColorConfig& GetColorParams() const
         { return m_colorParams; }
 
@@ -188,6 +198,7 @@ protected:
                                                // oldSwapChain when creating a new SwapChain.
 
     uint32_t                m_queueFamilyIndex;                    // Queue family index of the last present
+    volatile uint64_t       m_presentSubmitPoint;                  // See SetPresentSubmitPoint()
 };
 
 // =====================================================================================================================
@@ -168,6 +168,14 @@ VK_INLINE uint32_t BufferSizeToIndexCount(Pal::IndexType indexType, VkDeviceSize
     return static_cast<uint32_t>(bufferSize >> static_cast<uint32_t>(indexType));
 }
 
+// =====================================================================================================================
+// Converts CPU perf counter ticks to microseconds.  Whole seconds are converted separately so that accumulated times
+// do not overflow when multiplied by a high counter frequency.
+VK_INLINE uint64_t TicksToMicroseconds(uint64_t ticks, uint64_t frequency)
+{
+    return ((ticks / frequency) * 1000000) + (((ticks % frequency) * 1000000) / frequency);
+}
+
 // =====================================================================================================================
 VK_INLINE void GetExecutableNameAndPath(wchar_t* pExecutableName, wchar_t* pExecutablePath)
 {
@@ -30,6 +30,7 @@
  */
 
 #include "include/internal_mem_mgr.h"
+#include "include/log.h"
 #include "include/vk_conv.h"
 #include "include/vk_device.h"
 #include "include/vk_instance.h"
@@ -48,6 +49,89 @@ namespace vk
 static constexpr Pal::gpusize PoolAllocationSize        = 1ull << 18;   // 256 kilobytes
 static constexpr Pal::gpusize PoolMinSuballocationSize  = 1ull << 4;    // 16 bytes
 
+// Later pools of the same properties grow up to this many times the size of the first one, so that the number of pools
+// to search stays small for heavy users such as descriptor pools
+static constexpr uint32_t     PoolMaxSizeShift          = 3;
+
+static constexpr Pal::gpusize SlabSize                  = 1ull << 14;   // 16 kilobytes
+
+// Slot sizes of the slab size classes.  The classes in between powers of two keep rounding below a third of the slot.
+static constexpr uint32_t SlabClassSizes[InternalSlabClassCount] =
+    { 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096 };
+
+static_assert((SlabSize / SlabClassSizes[0]) <= InternalSlabMaxSlots, "Slab slots do not fit the free mask");
+
+// =====================================================================================================================
+// Returns the smallest slab size class that can hold a sub-allocation, or InternalSlabClassCount if none can.  Slabs
+// are aligned to their size, so a slot is aligned to the largest power of two that divides the slot size.
+static uint32_t GetSlabClass(
+    Pal::gpusize size,
+    Pal::gpusize alignment)
+{
+    uint32_t classIdx = 0;
+
+    while ((classIdx < InternalSlabClassCount) &&
+           ((size > SlabClassSizes[classIdx]) ||
+            (alignment > (SlabClassSizes[classIdx] & (~SlabClassSizes[classIdx] + 1)))))
+    {
+        classIdx++;
+    }
+
+    return classIdx;
+}
+
+// =====================================================================================================================
+// Returns the size of the block a buddy allocator reserves for a sub-allocation.
+static Pal::gpusize GetBuddyBlockSize(
+    Pal::gpusize size,
+    Pal::gpusize alignment)
+{
+    return Util::Pow2Pad(Util::Max(Util::Max(size, alignment), PoolMinSuballocationSize));
+}
+
+// =====================================================================================================================
+// Inserts a slab at the head of a slab list.
+static void LinkSlab(
+    InternalMemorySlab** ppHead,
+    InternalMemorySlab*  pSlab)
+{
+    pSlab->pPrev = nullptr;
+    pSlab->pNext = *ppHead;
+
+    if (*ppHead != nullptr)
+    {
+        (*ppHead)->pPrev = pSlab;
+    }
+
+    *ppHead = pSlab;
+}
+
+// =====================================================================================================================
+// Removes a slab from a slab list.
+static void UnlinkSlab(
+    InternalMemorySlab** ppHead,
+    InternalMemorySlab*  pSlab)
+{
+    if (pSlab->pPrev != nullptr)
+    {
+        pSlab->pPrev->pNext = pSlab->pNext;
+    }
+    else
+    {
+        VK_ASSERT(*ppHead == pSlab);
+
+        *ppHead = pSlab->pNext;
+    }
+
+    if (pSlab->pNext != nullptr)
+    {
+        pSlab->pNext->pPrev = pSlab->pPrev;
+    }
+
+    pSlab->pPrev = nullptr;
+    pSlab->pNext = nullptr;
+}
+
 // =====================================================================================================================
 // Filter invisible heap. For some objects as pipeline, invisible heap will be appended in memory requirement.
 // We filter this because we don't expect to support object memory migration.
@@ -71,14 +155,18 @@ static VK_INLINE void FilterHeap(
 // =====================================================================================================================
 InternalMemMgr::InternalMemMgr(
     Device*   pDevice,
-    Instance* pInstance)
+    Instance* pInstance,
+    bool      appMemory)
     :
     m_pDevice(pDevice),
     m_pSysMemAllocator(pInstance->Allocator()),
-    m_poolListMap(32, m_pSysMemAllocator)
+    m_poolListMap(32, m_pSysMemAllocator),
+    m_slabsEnabled(false),
+    m_appMemory(appMemory)
 {
     memset(m_commonPoolProps, 0, sizeof(m_commonPoolProps));
     memset(m_pCommonPools, 0, sizeof(m_pCommonPools));
+    memset(&m_poolStats, 0, sizeof(m_poolStats));
 }
 
 // =====================================================================================================================
@@ -87,9 +175,18 @@ VkResult InternalMemMgr::Init()
 {
     VkResult result = VK_SUCCESS;
 
+    m_slabsEnabled = m_pDevice->GetRuntimeSettings().enableInternalMemSlabs;
+
     // Initialize memory manager lock
     Pal::Result palResult = m_allocatorLock.Init();
 
+    for (uint32_t i = 0; (i < InternalMemCacheCount) && (palResult == Pal::Result::Success); ++i)
+    {
+        m_caches[i].slotCount = 0;
+
+        palResult = m_caches[i].lock.Init();
+    }
+
     if (palResult == Pal::Result::Success)
     {
         // Initialize pool list map
@@ -224,6 +321,22 @@ void InternalMemMgr::GetCommonPool(
 // Tears down the internal memory manager.
 void InternalMemMgr::Destroy()
 {
+    // Give the cached slots back to their slabs
+    for (uint32_t i = 0; i < InternalMemCacheCount; ++i)
+    {
+        for (uint32_t slotIdx = 0; slotIdx < m_caches[i].slotCount; ++slotIdx)
+        {
+            SlabFree(m_caches[i].slots[slotIdx].pSlab, m_caches[i].slots[slotIdx].offset);
+        }
+
+        m_caches[i].slotCount = 0;
+    }
+
+    if (m_poolListMap.GetNumEntries() != 0)
+    {
+        LogPoolStats();
+    }
+
     // Delete the suballocators (the GPU memory objects corresponding to them is already deleted)
     while (m_poolListMap.GetNumEntries() != 0)
     {
@@ -231,6 +344,24 @@ void InternalMemMgr::Destroy()
 
         MemoryPoolList* pPoolList = mapIt.Get()->value;
 
+        // Delete the slabs, whose memory goes away with the pools
+        for (uint32_t classIdx = 0; classIdx < InternalSlabClassCount; ++classIdx)
+        {
+            InternalMemorySlab** ppLists[] = { &pPoolList->pPartialSlabs[classIdx], &pPoolList->pFullSlabs[classIdx] };
+
+            for (InternalMemorySlab** ppHead : ppLists)
+            {
+                while (*ppHead != nullptr)
+                {
+                    InternalMemorySlab* pSlab = *ppHead;
+
+                    UnlinkSlab(ppHead, pSlab);
+
+                    PAL_DELETE(pSlab, m_pSysMemAllocator);
+                }
+            }
+        }
+
         while (pPoolList->NumElements() != 0)
         {
             auto it = pPoolList->Begin();
@@ -245,6 +376,8 @@ void InternalMemMgr::Destroy()
                                               pPool->groupMemory.PalMemory(deviceIdx));
             }
 
+            DecreaseAccountedPoolSize(pPool);
+
             // Delete the memory object and the system memory associated with it
             pPool->groupMemory.Destroy(m_pDevice->VkInstance());
 
@@ -400,8 +533,11 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
 {
     InternalMemCreateInfo poolInfo = initialSubAllocInfo;
 
-    // Use a larger, fixed size for pool allocations so that future sub-allocations will succeed
-    poolInfo.pal.size = Util::Pow2Align(PoolAllocationSize, poolInfo.pal.alignment);
+    // Use a larger size for pool allocations so that future sub-allocations will succeed.  Pools double in size with
+    // each one added to a list up to a limit.
+    const uint32_t sizeShift = Util::Min(static_cast<uint32_t>(pOwnerList->NumElements()), PoolMaxSizeShift);
+
+    poolInfo.pal.size = Util::Pow2Align(PoolAllocationSize << sizeShift, poolInfo.pal.alignment);
 
     VK_ASSERT(poolInfo.pal.size >= PoolMinSuballocationSize);
     VK_ASSERT(poolInfo.pal.size >= initialSubAllocInfo.pal.size);
@@ -453,12 +589,35 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
 
         pInternalMemory = pOwnerList->Begin().Get();
 
-        // Allocate the base GPU memory object for this pool
-        result = AllocBaseGpuMem(poolInfo.pal,
-                                 poolInfo.flags,
-                                 pInternalMemory,
-                                 allocMask,
-                                 initialSubAllocInfo.flags.needShadow);
+        const Pal::GpuHeap heap = poolInfo.pal.heaps[0];
+
+        // The whole pool is unavailable to other allocations of the application, so it counts toward the heap usage
+        // instead of the sub-allocations made from it
+        if (m_appMemory                                   &&
+            m_pDevice->IsAllocationSizeTrackingEnabled()  &&
+            ((heap == Pal::GpuHeap::GpuHeapInvisible) || (heap == Pal::GpuHeap::GpuHeapLocal)))
+        {
+            result = m_pDevice->TryIncreaseAllocatedMemorySize(poolInfo.pal.size, allocMask, heap);
+        }
+
+        if (result == VK_SUCCESS)
+        {
+            // Allocate the base GPU memory object for this pool
+            result = AllocBaseGpuMem(poolInfo.pal,
+                                     poolInfo.flags,
+                                     pInternalMemory,
+                                     allocMask,
+                                     initialSubAllocInfo.flags.needShadow);
+        }
+
+        if ((result == VK_SUCCESS) && m_appMemory)
+        {
+            m_pDevice->IncreaseAllocatedMemorySize(poolInfo.pal.size, allocMask, heap);
+
+            pInternalMemory->sizeAccountedForDeviceMask = allocMask;
+            pInternalMemory->accountedSize              = poolInfo.pal.size;
+            pInternalMemory->accountedHeap              = heap;
+        }
     }
 
     // Persistently map the base allocation if requested.
@@ -472,6 +631,12 @@ VkResult InternalMemMgr::CreateMemoryPoolAndSubAllocate(
     {
         *pNewPool        = *pInternalMemory;
         *pSubAllocOffset = subAllocOffset;
+
+        // Pools are only created under the allocator lock, so the peak cannot race with another pool creation.
+        const uint64_t poolBytes = Util::AtomicAdd64(&m_poolStats.poolBytes, poolInfo.pal.size);
+
+        Util::AtomicIncrement64(&m_poolStats.poolCount);
+        Util::AtomicExchange64(&m_poolStats.peakPoolBytes, Util::Max(m_poolStats.peakPoolBytes, poolBytes));
     }
     else
     {
@@ -535,98 +700,95 @@ VkResult InternalMemMgr::AllocGpuMem(
 {
     VK_ASSERT(pInternalMemory != nullptr);
 
-    Util::MutexAuto lock(&m_allocatorLock); // Ensure thread-safety using the lock
-
     VkResult result = VK_SUCCESS;
 
-    // If the requested allocation is small enough (at most half the size of a single pool) then try to find an
-    // appropriate pool and suballocate from it.
-    if ((createInfo.flags.noSuballocation == false) &&
-        (createInfo.pal.size <= (PoolAllocationSize / 2)))
+    // Slots that were recently freed into the calling thread's cache are handed out again without taking the lock
+    if (TakeCachedSlot(createInfo, pInternalMemory) == false)
     {
-        MemoryPoolList* pPoolList;
+        Util::MutexAuto lock(&m_allocatorLock); // Ensure thread-safety using the lock
 
-        // Use the previously computed pool list if one is provided.  Otherwise choose one based on this
-        // sub-allocation's information.
-        if (createInfo.pPoolInfo != nullptr)
+        // If the requested allocation is small enough (at most half the size of a single pool) then try to find an
+        // appropriate pool and suballocate from it.
+        if ((createInfo.flags.noSuballocation == false) &&
+            (createInfo.pal.size <= (PoolAllocationSize / 2)))
         {
+            MemoryPoolList* pPoolList;
+
+            // Use the previously computed pool list if one is provided.  Otherwise choose one based on this
+            // sub-allocation's information.
+            if (createInfo.pPoolInfo != nullptr)
+            {
 #if DEBUG
-            CheckProvidedSubAllocPoolInfo(createInfo);
+                CheckProvidedSubAllocPoolInfo(createInfo);
 #endif
-            pPoolList = reinterpret_cast<MemoryPoolList*>(createInfo.pPoolInfo);
-        }
-        else
-        {
-            // No previously-computed pool has been provided so find one for this allocation
-            MemoryPoolProperties poolProps = {};
-
-            GetMemoryPoolPropertiesFromAllocInfo(createInfo, &poolProps);
+                pPoolList = reinterpret_cast<MemoryPoolList*>(createInfo.pPoolInfo);
+            }
+            else
+            {
+                // No previously-computed pool has been provided so find one for this allocation
+                MemoryPoolProperties poolProps = {};
 
-            result = CalcSubAllocationPoolInternal(poolProps, &pPoolList);
-        }
+                GetMemoryPoolPropertiesFromAllocInfo(createInfo, &poolProps);
 
-        if (result == VK_SUCCESS)
-        {
-            // Assume that we won't find an appropriate pool
-            result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+                result = CalcSubAllocationPoolInternal(poolProps, &pPoolList);
+            }
 
-            // If found an appropriate pool list then search for a memory pool to suballocate from
-            for (auto it = pPoolList->Begin(); it.Get() != nullptr; it.Next())
+            if (result == VK_SUCCESS)
             {
-                InternalMemoryPool* pPool = it.Get();
+                const uint32_t slabClass = m_slabsEnabled ?
+                                           GetSlabClass(createInfo.pal.size, createInfo.pal.alignment) :
+                                           InternalSlabClassCount;
 
-                // Try to suballocate from the current memory pool using its buddy allocator
-                Pal::Result palResult = pPool->pBuddyAllocator->Allocate(
-                    createInfo.pal.size,
-                    createInfo.pal.alignment,
-                    &pInternalMemory->m_offset);
+                pInternalMemory->m_pSlab = nullptr;
 
-                if (palResult == Pal::Result::Success)
+                if (slabClass < InternalSlabClassCount)
                 {
-                    // If the suballocation succeeded, set the memory pool the suballocation came from
-                    pInternalMemory->m_memoryPool = *pPool;
-
-                    // Set the result to success and quit the loop
-                    result = VK_SUCCESS;
-                    break;
+                    result = SlabSubAllocate(pPoolList, createInfo, slabClass, allocMask, pInternalMemory);
                 }
-            }
+                else
+                {
+                    result = BuddySubAllocate(
+                        pPoolList,
+                        createInfo,
+                        allocMask,
+                        &pInternalMemory->m_memoryPool,
+                        &pInternalMemory->m_offset);
+
+                    if (result == VK_SUCCESS)
+                    {
+                        Util::AtomicAdd64(&m_poolStats.requestedBytes, createInfo.pal.size);
 
-            if (result != VK_SUCCESS)
-            {
-                // If at this point we still didn't manage to find an appropriate pool that has enough space then
-                // it means we need to create a new memory pool and sub-allocate from that
-                result = CreateMemoryPoolAndSubAllocate(
-                    pPoolList,
-                    createInfo,
-                    &pInternalMemory->m_memoryPool,
-                    allocMask,
-                    &pInternalMemory->m_offset);
+                        Util::AtomicIncrement64(&m_poolStats.buddyAllocCount);
+                        Util::AtomicAdd64(&m_poolStats.reservedBytes,
+                                          GetBuddyBlockSize(createInfo.pal.size, createInfo.pal.alignment));
+                    }
+                }
             }
         }
-    }
-    else
-    {
-        // We don't suballocate from a pool so there's no buddy allocator and also offset is always zero
-        pInternalMemory->m_memoryPool.pBuddyAllocator    = nullptr;
-        pInternalMemory->m_offset = 0;
-
-        // Issue a base memory allocation and use that as the memory object
-        result = AllocBaseGpuMem(
-            createInfo.pal,
-            createInfo.flags,
-            &pInternalMemory->m_memoryPool,
-            allocMask,
-            createInfo.flags.needShadow);
-
-        // Persistently map the allocation if necessary
-        if ((result == VK_SUCCESS) && (createInfo.flags.persistentMapped))
+        else
         {
-            pInternalMemory->m_memoryPool.groupMemory.Map();
-
-            if (createInfo.flags.needShadow)
+            // We don't suballocate from a pool so there's no buddy allocator and also offset is always zero
+            pInternalMemory->m_memoryPool.pBuddyAllocator    = nullptr;
+            pInternalMemory->m_pSlab  = nullptr;
+            pInternalMemory->m_offset = 0;
+
+            // Issue a base memory allocation and use that as the memory object
+            result = AllocBaseGpuMem(
+                createInfo.pal,
+                createInfo.flags,
+                &pInternalMemory->m_memoryPool,
+                allocMask,
+                createInfo.flags.needShadow);
+
+            // Persistently map the allocation if necessary
+            if ((result == VK_SUCCESS) && (createInfo.flags.persistentMapped))
             {
-                pInternalMemory->m_memoryPool.groupShadowMemory.Map();
+                pInternalMemory->m_memoryPool.groupMemory.Map();
+
+                if (createInfo.flags.needShadow)
+                {
+                    pInternalMemory->m_memoryPool.groupShadowMemory.Map();
+                }
             }
         }
     }
@@ -744,29 +906,355 @@ VkResult InternalMemMgr::AllocAndBindGpuMem(
 void InternalMemMgr::FreeGpuMem(
     const InternalMemory* pInternalMemory)
 {
-    Util::MutexAuto lock(&m_allocatorLock);
-
     VK_ASSERT(pInternalMemory != nullptr);
 
-    if (pInternalMemory->m_memoryPool.pBuddyAllocator != nullptr)
+    if (pInternalMemory->m_pSlab != nullptr)
     {
-        // The memory was suballocated so free it using the buddy allocator
-        pInternalMemory->m_memoryPool.pBuddyAllocator->Free(
-            pInternalMemory->m_offset,
-            pInternalMemory->m_size,
-            pInternalMemory->m_alignment);
+        // The memory is a slot of a slab, which goes to the calling thread's cache first
+        CacheSlot(pInternalMemory);
     }
     else
     {
-        VK_ASSERT(pInternalMemory->m_offset == 0);  // Offset should be zero if this isn't a suballocation
+        Util::MutexAuto lock(&m_allocatorLock);
+
+        if (pInternalMemory->m_memoryPool.pBuddyAllocator != nullptr)
+        {
+            // The memory was suballocated so free it using the buddy allocator
+            pInternalMemory->m_memoryPool.pBuddyAllocator->Free(
+                pInternalMemory->m_offset,
+                pInternalMemory->m_size,
+                pInternalMemory->m_alignment);
+
+            Util::AtomicAdd64(&m_poolStats.requestedBytes, 0 - pInternalMemory->m_size);
+            Util::AtomicAdd64(&m_poolStats.reservedBytes,
+                              0 - GetBuddyBlockSize(pInternalMemory->m_size, pInternalMemory->m_alignment));
+        }
+        else
+        {
+            VK_ASSERT(pInternalMemory->m_offset == 0);  // Offset should be zero if this isn't a suballocation
+
+            // Unmap if the allocation was persistently mapped.  Note that we only do this here for allocations that
+            // are not sub-allocated.
+            pInternalMemory->m_memoryPool.groupMemory.Unmap();
+
+            // Free the base allocation
+            FreeBaseGpuMem(&pInternalMemory->m_memoryPool);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Sub-allocates memory with the buddy allocator of the first pool of a list that has enough space, or from a new pool
+// if none has.
+//
+// WARNING: This function is NOT thread-safe and assumes the caller is holding a lock on m_allocatorLock.
+VkResult InternalMemMgr::BuddySubAllocate(
+    MemoryPoolList*              pPoolList,
+    const InternalMemCreateInfo& createInfo,
+    uint32_t                     allocMask,
+    InternalMemoryPool*          pPool,
+    Pal::gpusize*                pOffset)
+{
+    // Assume that we won't find an appropriate pool
+    VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+
+    // Search for a memory pool to suballocate from
+    for (auto it = pPoolList->Begin(); it.Get() != nullptr; it.Next())
+    {
+        InternalMemoryPool* pCurPool = it.Get();
 
-        // Unmap if the allocation was persistently mapped.  Note that we only do this here for allocations that
-        // are not sub-allocated.
-        pInternalMemory->m_memoryPool.groupMemory.Unmap();
+        // Try to suballocate from the current memory pool using its buddy allocator
+        Pal::Result palResult = pCurPool->pBuddyAllocator->Allocate(
+            createInfo.pal.size,
+            createInfo.pal.alignment,
+            pOffset);
 
-        // Free the base allocation
-        FreeBaseGpuMem(&pInternalMemory->m_memoryPool);
+        if (palResult == Pal::Result::Success)
+        {
+            // If the suballocation succeeded, set the memory pool the suballocation came from
+            *pPool = *pCurPool;
+
+            // Set the result to success and quit the loop
+            result = VK_SUCCESS;
+            break;
+        }
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        // If at this point we still didn't manage to find an appropriate pool that has enough space then
+        // it means we need to create a new memory pool and sub-allocate from that
+        result = CreateMemoryPoolAndSubAllocate(pPoolList, createInfo, pPool, allocMask, pOffset);
     }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Sub-allocates a slot of the given size class.  The slot comes from the first slab of the class that has a free one,
+// or from a new slab carved out of the pools with their buddy allocators.
+//
+// WARNING: This function is NOT thread-safe and assumes the caller is holding a lock on m_allocatorLock.
+VkResult InternalMemMgr::SlabSubAllocate(
+    MemoryPoolList*              pPoolList,
+    const InternalMemCreateInfo& createInfo,
+    uint32_t                     classIdx,
+    uint32_t                     allocMask,
+    InternalMemory*              pInternalMemory)
+{
+    VkResult result = VK_SUCCESS;
+
+    InternalMemorySlab* pSlab = pPoolList->pPartialSlabs[classIdx];
+
+    if (pSlab == nullptr)
+    {
+        pSlab = PAL_NEW(InternalMemorySlab, m_pSysMemAllocator, Util::AllocInternal)();
+
+        if (pSlab != nullptr)
+        {
+            InternalMemCreateInfo slabInfo = createInfo;
+
+            slabInfo.pal.size      = SlabSize;
+            slabInfo.pal.alignment = SlabSize;
+
+            result = BuddySubAllocate(pPoolList, slabInfo, allocMask, &pSlab->pool, &pSlab->offset);
+
+            if (result == VK_SUCCESS)
+            {
+                pSlab->pOwnerList = pPoolList;
+                pSlab->classIdx   = classIdx;
+                pSlab->slotCount  = static_cast<uint32_t>(SlabSize / SlabClassSizes[classIdx]);
+                pSlab->freeCount  = pSlab->slotCount;
+
+                for (uint32_t slot = 0; slot < pSlab->slotCount; ++slot)
+                {
+                    pSlab->freeMask[slot / 32] |= (1u << (slot % 32));
+                }
+
+                LinkSlab(&pPoolList->pPartialSlabs[classIdx], pSlab);
+
+                Util::AtomicIncrement64(&m_poolStats.slabCount);
+            }
+            else
+            {
+                PAL_DELETE(pSlab, m_pSysMemAllocator);
+                pSlab = nullptr;
+            }
+        }
+        else
+        {
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        VK_ASSERT(pSlab->freeCount > 0);
+
+        uint32_t word = 0;
+        uint32_t bit  = 0;
+
+        while (Util::BitMaskScanForward(&bit, pSlab->freeMask[word]) == false)
+        {
+            word++;
+        }
+
+        pSlab->freeMask[word] &= ~(1u << bit);
+        pSlab->freeCount--;
+
+        if (pSlab->freeCount == 0)
+        {
+            UnlinkSlab(&pPoolList->pPartialSlabs[classIdx], pSlab);
+            LinkSlab(&pPoolList->pFullSlabs[classIdx], pSlab);
+        }
+
+        const uint32_t slot = (word * 32) + bit;
+
+        pInternalMemory->m_memoryPool = pSlab->pool;
+        pInternalMemory->m_pSlab      = pSlab;
+        pInternalMemory->m_offset     = pSlab->offset + (slot * SlabClassSizes[classIdx]);
+
+        Util::AtomicAdd64(&m_poolStats.requestedBytes, createInfo.pal.size);
+
+        Util::AtomicIncrement64(&m_poolStats.slabAllocCount);
+        Util::AtomicAdd64(&m_poolStats.reservedBytes, SlabClassSizes[classIdx]);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Returns the cache of freed slots that the calling thread uses.  Threads are assigned to the caches round robin the
+// first time they free or allocate a slot, so that threads allocating concurrently rarely share a cache.
+static uint32_t GetCacheIndex()
+{
+    static volatile uint32_t s_threadCount = 0;
+
+    thread_local const uint32_t cacheIndex = Util::AtomicIncrement(&s_threadCount) % InternalMemCacheCount;
+
+    return cacheIndex;
+}
+
+// =====================================================================================================================
+// Hands out a slot from the calling thread's cache of freed slots if it holds one of the size class and pool list of
+// the allocation.  This only applies to allocations that provide their pool up front, which is the case for the common
+// pools, since finding a pool from the allocation's properties requires the manager lock.
+bool InternalMemMgr::TakeCachedSlot(
+    const InternalMemCreateInfo& createInfo,
+    InternalMemory*              pInternalMemory)
+{
+    bool found = false;
+
+    if (m_slabsEnabled                              &&
+        (createInfo.pPoolInfo != nullptr)           &&
+        (createInfo.flags.noSuballocation == false) &&
+        (createInfo.pal.size <= (PoolAllocationSize / 2)))
+    {
+        const uint32_t classIdx = GetSlabClass(createInfo.pal.size, createInfo.pal.alignment);
+
+        if (classIdx < InternalSlabClassCount)
+        {
+            InternalMemCache* pCache = &m_caches[GetCacheIndex()];
+
+            Util::MutexAuto lock(&pCache->lock);
+
+            // Take the most recently freed matching slot.  The slab of a cached slot is never destroyed and its owner
+            // and class never change, so they can be read without the manager lock.
+            for (uint32_t i = pCache->slotCount; (i > 0) && (found == false); --i)
+            {
+                const InternalMemCachedSlot& slot = pCache->slots[i - 1];
+
+                if ((slot.pSlab->pOwnerList == createInfo.pPoolInfo) && (slot.pSlab->classIdx == classIdx))
+                {
+                    pInternalMemory->m_memoryPool = slot.pSlab->pool;
+                    pInternalMemory->m_pSlab      = slot.pSlab;
+                    pInternalMemory->m_offset     = slot.offset;
+
+                    // Keep the remaining slots in the order they were freed
+                    memmove(&pCache->slots[i - 1],
+                            &pCache->slots[i],
+                            (pCache->slotCount - i) * sizeof(InternalMemCachedSlot));
+
+                    pCache->slotCount--;
+
+                    found = true;
+                }
+            }
+        }
+    }
+
+    if (found)
+    {
+        Util::AtomicAdd64(&m_poolStats.requestedBytes, createInfo.pal.size);
+        Util::AtomicIncrement64(&m_poolStats.cacheHitCount);
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Puts a freed slot into the calling thread's cache.  When the cache is full, its older half is given back to the
+// slabs in one batch under the manager lock.
+void InternalMemMgr::CacheSlot(
+    const InternalMemory* pInternalMemory)
+{
+    static constexpr uint32_t FlushCount = InternalMemCacheSlotCount / 2;
+
+    InternalMemCache* pCache = &m_caches[GetCacheIndex()];
+
+    InternalMemCachedSlot flushSlots[FlushCount];
+    uint32_t              flushCount = 0;
+
+    {
+        Util::MutexAuto lock(&pCache->lock);
+
+        if (pCache->slotCount == InternalMemCacheSlotCount)
+        {
+            flushCount = FlushCount;
+
+            memcpy(flushSlots, pCache->slots, sizeof(flushSlots));
+            memmove(&pCache->slots[0],
+                    &pCache->slots[FlushCount],
+                    (InternalMemCacheSlotCount - FlushCount) * sizeof(InternalMemCachedSlot));
+
+            pCache->slotCount -= FlushCount;
+        }
+
+        pCache->slots[pCache->slotCount].pSlab  = pInternalMemory->m_pSlab;
+        pCache->slots[pCache->slotCount].offset = pInternalMemory->m_offset;
+        pCache->slotCount++;
+    }
+
+    Util::AtomicAdd64(&m_poolStats.requestedBytes, 0 - pInternalMemory->m_size);
+
+    if (flushCount > 0)
+    {
+        Util::MutexAuto lock(&m_allocatorLock);
+
+        for (uint32_t i = 0; i < flushCount; ++i)
+        {
+            SlabFree(flushSlots[i].pSlab, flushSlots[i].offset);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Frees a slot of a slab.  Empty slabs are given back to their pool, except for the last one with free slots of its
+// size class, which is kept to avoid carving out a new one for the next sub-allocation.
+//
+// WARNING: This function is NOT thread-safe and assumes the caller is holding a lock on m_allocatorLock.
+void InternalMemMgr::SlabFree(
+    InternalMemorySlab* pSlab,
+    Pal::gpusize        offset)
+{
+    MemoryPoolList* pPoolList = pSlab->pOwnerList;
+
+    const uint32_t classIdx = pSlab->classIdx;
+    const uint32_t slot     = static_cast<uint32_t>((offset - pSlab->offset) / SlabClassSizes[classIdx]);
+
+    VK_ASSERT(slot < pSlab->slotCount);
+    VK_ASSERT((pSlab->freeMask[slot / 32] & (1u << (slot % 32))) == 0);
+
+    pSlab->freeMask[slot / 32] |= (1u << (slot % 32));
+
+    if (pSlab->freeCount == 0)
+    {
+        UnlinkSlab(&pPoolList->pFullSlabs[classIdx], pSlab);
+        LinkSlab(&pPoolList->pPartialSlabs[classIdx], pSlab);
+    }
+
+    pSlab->freeCount++;
+
+    Util::AtomicAdd64(&m_poolStats.reservedBytes, 0 - SlabClassSizes[classIdx]);
+
+    const bool isOnlyPartialSlab = (pPoolList->pPartialSlabs[classIdx] == pSlab) && (pSlab->pNext == nullptr);
+
+    if ((pSlab->freeCount == pSlab->slotCount) && (isOnlyPartialSlab == false))
+    {
+        UnlinkSlab(&pPoolList->pPartialSlabs[classIdx], pSlab);
+
+        pSlab->pool.pBuddyAllocator->Free(pSlab->offset, SlabSize, SlabSize);
+
+        PAL_DELETE(pSlab, m_pSysMemAllocator);
+
+        Util::AtomicAdd64(&m_poolStats.slabCount, 0 - 1ull);
+    }
+}
+
+// =====================================================================================================================
+// Logs how much of the memory pools is in use and how much of that is lost to rounding.
+void InternalMemMgr::LogPoolStats() const
+{
+    const uint64_t KiB = 1024;
+
+    AmdvlkLog(m_pDevice->GetRuntimeSettings().logTagIdMask, InternalMemStats,
+              "%llu pools of %llu KiB (peak %llu KiB), sub-allocations %llu KiB requested in %llu KiB reserved, "
+              "%llu slab sub-allocations plus %llu reused from thread caches, %llu buddy sub-allocations, "
+              "%llu slabs of %llu KiB",
+              m_poolStats.poolCount, m_poolStats.poolBytes / KiB, m_poolStats.peakPoolBytes / KiB,
+              m_poolStats.requestedBytes / KiB, m_poolStats.reservedBytes / KiB,
+              m_poolStats.slabAllocCount, m_poolStats.cacheHitCount, m_poolStats.buddyAllocCount,
+              m_poolStats.slabCount, (m_poolStats.slabCount * SlabSize) / KiB);
 }
 
 // =====================================================================================================================
@@ -949,11 +1437,26 @@ void InternalMemMgr::FreeBaseGpuMem(
         }
     }
 
+    DecreaseAccountedPoolSize(pGpuMemory);
+
     // Free the GPU memory object and system memory used by the object
     pGpuMemory->groupMemory.Destroy(m_pDevice->VkInstance());
     pGpuMemory->groupShadowMemory.Destroy(m_pDevice->VkInstance());
 }
 
+// =====================================================================================================================
+// Removes the size of a pool of application memory from the heap usage once the pool is going away.
+void InternalMemMgr::DecreaseAccountedPoolSize(
+    const InternalMemoryPool* pGpuMemory)
+{
+    if (pGpuMemory->sizeAccountedForDeviceMask != 0)
+    {
+        m_pDevice->DecreaseAllocatedMemorySize(pGpuMemory->accountedSize,
+                                               pGpuMemory->sizeAccountedForDeviceMask,
+                                               pGpuMemory->accountedHeap);
+    }
+}
+
 // =====================================================================================================================
 Pal::IGpuMemory* DeviceGroupMemory::PalMemory(int32_t idx) const
 {
@@ -0,0 +1,252 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  pal_pipeline_table.cpp
+ * @brief Contains the implementation of the table of shared PAL pipeline objects.
+ ***********************************************************************************************************************
+ */
+
+#include "include/khronos/vulkan.h"
+
+#include "include/vk_conv.h"
+#include "include/vk_device.h"
+#include "include/vk_instance.h"
+#include "include/pal_pipeline_table.h"
+
+#include "palHashMapImpl.h"
+#include "palPipeline.h"
+
+namespace vk
+{
+
+// =====================================================================================================================
+PalPipelineTable::PalPipelineTable(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_enabled(false),
+    m_pipelines(NumPipelineBuckets, pDevice->VkInstance()->Allocator())
+{
+
+}
+
+// =====================================================================================================================
+// Initializes the pipeline table.  Should be called during device create.
+VkResult PalPipelineTable::Init()
+{
+    m_enabled = m_pDevice->GetRuntimeSettings().enableSharedPalPipelines;
+
+#if ICD_GPUOPEN_DEVMODE_BUILD
+    // Reinjection replaces the PAL pipeline after it is created, so it would no longer match its key.
+    if (m_pDevice->VkInstance()->GetDevModeMgr() != nullptr)
+    {
+        m_enabled = false;
+    }
+#endif
+
+    Pal::Result result = m_mutex.Init();
+
+    if (result == Pal::Result::Success)
+    {
+        result = m_pipelines.Init();
+    }
+
+    return PalToVkResult(result);
+}
+
+// =====================================================================================================================
+// Finishes the key of a pipeline.  pHasher must already hold the PAL create info of the pipeline without its binary;
+// the binaries are identified by their cache IDs, or by their contents if they were not looked up in a cache.
+void PalPipelineTable::BuildKey(
+    Util::MetroHash128*          pHasher,
+    const Util::MetroHash::Hash* pCacheIds,
+    const size_t*                pBinarySizes,
+    const void* const*           ppBinaries,
+    Util::MetroHash::Hash*       pKey) const
+{
+    static const Util::MetroHash::Hash NullCacheId = {};
+
+    for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); deviceIdx++)
+    {
+        // Devices without a binary of their own use the one of the default device
+        if (ppBinaries[deviceIdx] == nullptr)
+        {
+            pHasher->Update(NullCacheId);
+        }
+        else if (memcmp(&pCacheIds[deviceIdx], &NullCacheId, sizeof(NullCacheId)) != 0)
+        {
+            pHasher->Update(pCacheIds[deviceIdx]);
+        }
+        else
+        {
+            pHasher->Update(static_cast<const uint8_t*>(ppBinaries[deviceIdx]), pBinarySizes[deviceIdx]);
+        }
+    }
+
+    pHasher->Finalize(pKey->bytes);
+}
+
+// =====================================================================================================================
+// Returns the PAL pipelines registered under the given key with an added reference, or nullptr if there are none.
+SharedPalPipeline* PalPipelineTable::Find(
+    const Util::MetroHash::Hash& key)
+{
+    Util::MutexAuto lock(&m_mutex);
+
+    SharedPalPipeline** ppEntry   = m_pipelines.FindKey(key);
+    SharedPalPipeline*  pPipeline = nullptr;
+
+    if (ppEntry != nullptr)
+    {
+        pPipeline = *ppEntry;
+
+        VK_ASSERT(pPipeline->refCount > 0);
+
+        pPipeline->refCount++;
+    }
+
+    return pPipeline;
+}
+
+// =====================================================================================================================
+// Allocates an unregistered entry holding one reference, with storage for a PAL pipeline of the given size per device.
+// The caller creates the PAL pipelines in pPalMemory and then registers them with Insert().
+SharedPalPipeline* PalPipelineTable::AllocPipeline(
+    const Util::MetroHash::Hash& key,
+    size_t                       palPipelineSize)
+{
+    void* pMemory = m_pDevice->VkInstance()->AllocMem(
+        sizeof(SharedPalPipeline) + (palPipelineSize * m_pDevice->NumPalDevices()),
+        VK_DEFAULT_MEM_ALIGN,
+        VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+
+    SharedPalPipeline* pPipeline = nullptr;
+
+    if (pMemory != nullptr)
+    {
+        pPipeline = static_cast<SharedPalPipeline*>(pMemory);
+
+        memset(pPipeline, 0, sizeof(*pPipeline));
+
+        pPipeline->key        = key;
+        pPipeline->pPalMemory = Util::VoidPtrInc(pMemory, sizeof(SharedPalPipeline));
+        pPipeline->refCount   = 1;
+    }
+
+    return pPipeline;
+}
+
+// =====================================================================================================================
+// Registers an entry from AllocPipeline() whose PAL pipelines have been created.  If another thread registered the same
+// key first, the given entry is released and the registered one is returned with an added reference instead.  Failing
+// to register is not an error; the entry then simply is not shared.
+SharedPalPipeline* PalPipelineTable::Insert(
+    SharedPalPipeline* pPipeline)
+{
+    VK_ASSERT((pPipeline->registered == false) && (pPipeline->refCount == 1));
+
+    SharedPalPipeline* pDuplicate = nullptr;
+
+    {
+        Util::MutexAuto lock(&m_mutex);
+
+        bool                existed = false;
+        SharedPalPipeline** ppEntry = nullptr;
+
+        if (m_pipelines.FindAllocate(pPipeline->key, &existed, &ppEntry) == Pal::Result::Success)
+        {
+            if (existed)
+            {
+                pDuplicate = pPipeline;
+                pPipeline  = *ppEntry;
+
+                pPipeline->refCount++;
+            }
+            else
+            {
+                *ppEntry = pPipeline;
+
+                pPipeline->registered = true;
+            }
+        }
+    }
+
+    if (pDuplicate != nullptr)
+    {
+        DestroyPipeline(pDuplicate);
+    }
+
+    return pPipeline;
+}
+
+// =====================================================================================================================
+// Drops a reference to the given entry and destroys its PAL pipelines when the last one is gone.
+void PalPipelineTable::Release(
+    SharedPalPipeline* pPipeline)
+{
+    bool destroy = false;
+
+    {
+        Util::MutexAuto lock(&m_mutex);
+
+        VK_ASSERT(pPipeline->refCount > 0);
+
+        pPipeline->refCount--;
+
+        if (pPipeline->refCount == 0)
+        {
+            if (pPipeline->registered)
+            {
+                m_pipelines.Erase(pPipeline->key);
+            }
+
+            destroy = true;
+        }
+    }
+
+    if (destroy)
+    {
+        DestroyPipeline(pPipeline);
+    }
+}
+
+// =====================================================================================================================
+// Destroys the PAL pipelines of an entry that is no longer referenced and frees it.
+void PalPipelineTable::DestroyPipeline(
+    SharedPalPipeline* pPipeline)
+{
+    for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); deviceIdx++)
+    {
+        if (pPipeline->pPipelines[deviceIdx] != nullptr)
+        {
+            pPipeline->pPipelines[deviceIdx]->Destroy();
+        }
+    }
+
+    m_pDevice->VkInstance()->FreeMem(pPipeline);
+}
+
+} // namespace vk
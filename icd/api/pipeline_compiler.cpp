@@ -637,7 +637,9 @@ VkResult PipelineCompiler::CreateGraphicsPipelineBinary(
     auto                   pInstance     = m_pPhysicalDevice->Manager()->VkInstance();
 
     int64_t compileTime = 0;
-    uint64_t pipelineHash = Vkgc::IPipelineDumper::GetPipelineHash(&pCreateInfo->pipelineInfo);
+    uint64_t pipelineHash = (pCreateInfo->pipelineHash != 0) ?
+                            pCreateInfo->pipelineHash :
+                            Vkgc::IPipelineDumper::GetPipelineHash(&pCreateInfo->pipelineInfo);
 
     void* pPipelineDumpHandle = nullptr;
     const void* moduleDataBaks[ShaderGfxStageCount];
@@ -796,6 +798,9 @@ VkResult PipelineCompiler::CreateGraphicsPipelineBinary(
     m_totalTimeSpent += pCreateInfo->elfWasCached ? cacheTime : compileTime;
     m_totalBinaries++;
 
+    pCreateInfo->creationTimes.Add(PipelineCreationPhase::CacheLookup, cacheTime);
+    pCreateInfo->creationTimes.Add(PipelineCreationPhase::Compile, compileTime);
+
     if (settings.shaderReplaceMode == ShaderReplaceShaderISA)
     {
         ReplacePipelineIsaCode(pDevice, pipelineHash, *ppPipelineBinary, *pPipelineBinarySize);
@@ -843,10 +848,18 @@ VkResult PipelineCompiler::CreateComputePipelineBinary(
     auto                   pInstance     = m_pPhysicalDevice->Manager()->VkInstance();
     bool                   shouldCompile = true;
 
+    // A pipeline hash computed by the caller for another device index is stale
+    if (pCreateInfo->pipelineInfo.deviceIndex != deviceIdx)
+    {
+        pCreateInfo->pipelineHash = 0;
+    }
+
     pCreateInfo->pipelineInfo.deviceIndex = deviceIdx;
 
     int64_t compileTime = 0;
-    uint64_t pipelineHash = Vkgc::IPipelineDumper::GetPipelineHash(&pCreateInfo->pipelineInfo);
+    uint64_t pipelineHash = (pCreateInfo->pipelineHash != 0) ?
+                            pCreateInfo->pipelineHash :
+                            Vkgc::IPipelineDumper::GetPipelineHash(&pCreateInfo->pipelineInfo);
 
     void* pPipelineDumpHandle = nullptr;
     const void* pModuleDataBak = nullptr;
@@ -983,6 +996,9 @@ VkResult PipelineCompiler::CreateComputePipelineBinary(
 
     m_totalTimeSpent += pCreateInfo->elfWasCached ? cacheTime : compileTime;
     m_totalBinaries++;
+
+    pCreateInfo->creationTimes.Add(PipelineCreationPhase::CacheLookup, cacheTime);
+    pCreateInfo->creationTimes.Add(PipelineCreationPhase::Compile, compileTime);
     if (settings.shaderReplaceMode == ShaderReplaceShaderISA)
     {
         ReplacePipelineIsaCode(pDevice, pipelineHash, *ppPipelineBinary, *pPipelineBinarySize);
@@ -0,0 +1,163 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  pipeline_creation_profiler.cpp
+ * @brief Contains the implementation of the pipeline creation profiler.
+ ***********************************************************************************************************************
+ */
+
+#include "include/khronos/vulkan.h"
+
+#include "include/vk_device.h"
+#include "include/vk_utils.h"
+#include "include/pipeline_creation_profiler.h"
+
+#include "utils/json_writer.h"
+
+#include "palInlineFuncs.h"
+
+namespace vk
+{
+
+// Names of the phases in the JSON dump
+static const char* PhaseNames[] =
+{
+    "hash",
+    "convert",
+    "cacheLookup",
+    "compile",
+    "createPalPipeline",
+    "createStaticState",
+    "total",
+};
+
+static_assert(VK_ARRAY_SIZE(PhaseNames) == static_cast<uint32_t>(PipelineCreationPhase::Count),
+              "Every pipeline creation phase needs a name");
+
+// =====================================================================================================================
+PipelineCreationProfiler::PipelineCreationProfiler(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_enabled(false),
+    m_perfFrequency(0)
+{
+    memset(m_phases, 0, sizeof(m_phases));
+}
+
+// =====================================================================================================================
+// Initializes the profiler.  Should be called during device create.
+void PipelineCreationProfiler::Init()
+{
+    m_enabled       = m_pDevice->GetRuntimeSettings().enablePipelineCreationProfiling;
+    m_perfFrequency = Util::GetPerfFrequency();
+}
+
+// =====================================================================================================================
+// Adds the phase times of one pipeline creation call to the histograms.  May be called from any thread.
+void PipelineCreationProfiler::Record(
+    const PipelineCreationTimes& times)
+{
+    if (m_enabled)
+    {
+        for (uint32_t phase = 0; phase < static_cast<uint32_t>(PipelineCreationPhase::Count); ++phase)
+        {
+            const int64_t duration = times.phase[phase];
+
+            if (duration > 0)
+            {
+                PhaseStats* pStats = &m_phases[phase];
+
+                const uint64_t durationUs = utils::TicksToMicroseconds(static_cast<uint64_t>(duration),
+                                                                       static_cast<uint64_t>(m_perfFrequency));
+                const uint32_t bucket     = (durationUs == 0) ?
+                                            0 : Util::Min(Util::Log2(durationUs) + 1, NumHistogramBuckets - 1);
+
+                Util::AtomicIncrement64(&pStats->count);
+                Util::AtomicAdd64(&pStats->totalTime, static_cast<uint64_t>(duration));
+                Util::AtomicIncrement(&pStats->histogram[bucket]);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Writes the collected histograms to the file given by the pipelineCreationProfileFile setting.  Bucket i of a
+// histogram is written with the exclusive upper bound of its range in microseconds, 2^i.
+void PipelineCreationProfiler::Dump() const
+{
+    if (m_enabled)
+    {
+        utils::JsonOutputStream jsonStream(m_pDevice->GetRuntimeSettings().pipelineCreationProfileFile);
+        Util::JsonWriter        writer(&jsonStream);
+
+        writer.BeginMap(false);
+        writer.Key("phases");
+        writer.BeginMap(false);
+
+        for (uint32_t phase = 0; phase < static_cast<uint32_t>(PipelineCreationPhase::Count); ++phase)
+        {
+            const PhaseStats& stats = m_phases[phase];
+
+            writer.Key(PhaseNames[phase]);
+            writer.BeginMap(false);
+
+            writer.Key("count");
+            writer.Value(stats.count);
+            writer.Key("totalUs");
+            writer.Value(utils::TicksToMicroseconds(stats.totalTime, static_cast<uint64_t>(m_perfFrequency)));
+
+            // Only the buckets up to the longest sample are written
+            uint32_t numBuckets = NumHistogramBuckets;
+
+            while ((numBuckets > 0) && (stats.histogram[numBuckets - 1] == 0))
+            {
+                numBuckets--;
+            }
+
+            writer.Key("histogram");
+            writer.BeginList(false);
+
+            for (uint32_t bucket = 0; bucket < numBuckets; ++bucket)
+            {
+                writer.BeginMap(true);
+                writer.Key("maxUs");
+                writer.Value(static_cast<uint64_t>(1) << bucket);
+                writer.Key("count");
+                writer.Value(stats.histogram[bucket]);
+                writer.EndMap();
+            }
+
+            writer.EndList();
+            writer.EndMap();
+        }
+
+        writer.EndMap();
+        writer.EndMap();
+    }
+}
+
+} // namespace vk
@@ -0,0 +1,255 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2020 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  queue_submit_thread.cpp
+ * @brief Contains the implementation of the queue submission thread.
+ ***********************************************************************************************************************
+ */
+
+#include "include/vk_instance.h"
+#include "include/queue_submit_thread.h"
+
+#include "palSysUtil.h"
+
+namespace vk
+{
+
+// =====================================================================================================================
+QueueSubmitThread::QueueSubmitThread(
+    Instance*    pInstance,
+    Pal::IQueue* pPalQueue)
+    :
+    m_pInstance(pInstance),
+    m_pPalQueue(pPalQueue),
+    m_pushedCount(0),
+    m_issuedCount(0),
+    m_result(static_cast<uint32_t>(Pal::Result::Success)),
+    m_presentResult(static_cast<uint32_t>(Pal::Result::Success)),
+    m_stop(false)
+{
+
+}
+
+// =====================================================================================================================
+// Creates the events and starts the thread.
+Pal::Result QueueSubmitThread::Init()
+{
+    Util::EventCreateFlags flags = {};
+    flags.manualReset       = false;
+    flags.initiallySignaled = false;
+
+    Pal::Result result = m_event.Init(flags);
+
+    if (result == Pal::Result::Success)
+    {
+        // Any number of threads may wait for operations to be issued, so the event is reset by the submission thread
+        // before it issues an operation rather than by a waiter
+        flags.manualReset = true;
+
+        result = m_issuedEvent.Init(flags);
+    }
+
+    if (result == Pal::Result::Success)
+    {
+        result = Util::Thread::Begin(ThreadFunc, this);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Hands an operation to the thread.  Blocks while the ring is full.
+void QueueSubmitThread::Push(
+    const QueuedSubmitOp& op)
+{
+    if ((m_pushedCount - m_issuedCount) >= RingSize)
+    {
+        WaitIssued(m_pushedCount - RingSize + 1);
+    }
+
+    m_ring[m_pushedCount % RingSize] = op;
+
+    // The operation has to be written before it is published to the thread
+    Util::AtomicIncrement64(&m_pushedCount);
+
+    m_event.Set();
+}
+
+// =====================================================================================================================
+// Waits until the first opCount operations have been issued to PAL.  The timeout only bounds how late a waiter notices
+// an operation that was issued between its check and the submission thread resetting the event for the next one.
+void QueueSubmitThread::WaitIssued(
+    uint64_t opCount)
+{
+    while (IsIssued(opCount) == false)
+    {
+        m_issuedEvent.Wait(0.001f);
+    }
+}
+
+// =====================================================================================================================
+// Returns the error kept in the given result, and forgets it unless the device was lost.
+Pal::Result QueueSubmitThread::ConsumeResult(
+    volatile uint32_t* pResult)
+{
+    const uint32_t result = *pResult;
+
+    if ((result != static_cast<uint32_t>(Pal::Result::Success)) &&
+        (result != static_cast<uint32_t>(Pal::Result::ErrorDeviceLost)))
+    {
+        // An error issued in the meantime is kept for the next call
+        Util::AtomicCompareAndSwap(pResult, result, static_cast<uint32_t>(Pal::Result::Success));
+    }
+
+    return static_cast<Pal::Result>(result);
+}
+
+// =====================================================================================================================
+// Keeps the result of an operation unless an earlier error has not been reported yet.
+void QueueSubmitThread::RecordResult(
+    volatile uint32_t* pResult,
+    Pal::Result        result)
+{
+    if (result == Pal::Result::ErrorDeviceLost)
+    {
+        // A lost device is reported by every later call regardless of what was pending
+        Util::AtomicExchange(pResult, static_cast<uint32_t>(result));
+    }
+    else if (result != Pal::Result::Success)
+    {
+        Util::AtomicCompareAndSwap(pResult,
+                                   static_cast<uint32_t>(Pal::Result::Success),
+                                   static_cast<uint32_t>(result));
+    }
+}
+
+// =====================================================================================================================
+// Issues all pending operations and stops the thread.
+void QueueSubmitThread::Stop()
+{
+    WaitIdle();
+
+    m_stop = true;
+    m_event.Set();
+
+    Join();
+}
+
+// =====================================================================================================================
+void QueueSubmitThread::ThreadFunc(
+    void* pParam)
+{
+    static_cast<QueueSubmitThread*>(pParam)->Run();
+}
+
+// =====================================================================================================================
+// Issues operations in the order they were pushed until the thread is stopped.
+void QueueSubmitThread::Run()
+{
+    while (m_stop == false)
+    {
+        m_event.Wait(1.0f);
+
+        while (m_issuedCount != m_pushedCount)
+        {
+            m_issuedEvent.Reset();
+
+            Execute(m_ring[m_issuedCount % RingSize]);
+
+            Util::AtomicIncrement64(&m_issuedCount);
+
+            m_issuedEvent.Set();
+        }
+    }
+}
+
+// =====================================================================================================================
+// Issues a single operation to the PAL queue.
+void QueueSubmitThread::Execute(
+    const QueuedSubmitOp& op)
+{
+    Pal::Result result = Pal::Result::Success;
+
+    switch (op.type)
+    {
+    case QueuedSubmitOp::Type::WaitSemaphore:
+        result = m_pPalQueue->WaitQueueSemaphore(op.semaphore.pSemaphore, op.semaphore.value);
+        break;
+
+    case QueuedSubmitOp::Type::SignalSemaphore:
+        result = m_pPalQueue->SignalQueueSemaphore(op.semaphore.pSemaphore, op.semaphore.value);
+        break;
+
+    case QueuedSubmitOp::Type::Submit:
+    {
+        Pal::PerSubQueueSubmitInfo perSubQueueInfo = {};
+        perSubQueueInfo.cmdBufferCount  = op.submit.cmdBufferCount;
+        perSubQueueInfo.ppCmdBuffers    = op.submit.ppCmdBuffers;
+        perSubQueueInfo.pCmdBufInfoList = (op.submit.cmdBufInfo.isValid != 0) ? &op.submit.cmdBufInfo : nullptr;
+
+        Pal::IFence* pPalFence = op.submit.pFence;
+
+        Pal::SubmitInfo submitInfo = {};
+        submitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
+        submitInfo.perSubQueueInfoCount = 1;
+        submitInfo.ppFences             = (pPalFence != nullptr) ? &pPalFence : nullptr;
+        submitInfo.fenceCount           = (pPalFence != nullptr) ? 1 : 0;
+
+        result = m_pPalQueue->Submit(submitInfo);
+        break;
+    }
+
+    case QueuedSubmitOp::Type::Present:
+        result = m_pPalQueue->PresentSwapChain(op.present);
+        break;
+
+    default:
+        VK_NEVER_CALLED();
+        break;
+    }
+
+    if (op.pMemory != nullptr)
+    {
+        m_pInstance->FreeMem(op.pMemory);
+    }
+
+    if (op.type != QueuedSubmitOp::Type::Present)
+    {
+        RecordResult(&m_result, result);
+    }
+    else
+    {
+        RecordResult(&m_presentResult, result);
+
+        // Submissions have to report a lost device as well
+        if (result == Pal::Result::ErrorDeviceLost)
+        {
+            RecordResult(&m_result, result);
+        }
+    }
+}
+
+} // namespace vk
@@ -80,7 +80,12 @@ RenderStateCache::RenderStateCache(
 // Initializes the render state cache.  Should be called during device create.
 VkResult RenderStateCache::Init()
 {
-    Pal::Result result = m_mutex.Init();
+    Pal::Result result = Pal::Result::Success;
+
+    for (uint32_t i = 0; (i < StateLockCount) && (result == Pal::Result::Success); ++i)
+    {
+        result = m_mutexes[i].Init();
+    }
 
     if (result == Pal::Result::Success)
     {
@@ -183,7 +188,7 @@ RenderStateCache::EraseFromMaps(
 
 // =====================================================================================================================
 // Destroys the render state cache.  Should be called during device destroy.
-// Not necessary to take the mutex in this function because, an application should ensure that no work is active on
+// Not necessary to take the mutexes in this function because, an application should ensure that no work is active on
 // the device, and an application is responsible for destroying / freeing any Vulkan objects that were created using
 // that device.
 void RenderStateCache::Destroy()
@@ -516,6 +521,7 @@ void RenderStateCache::DestroyPalObjects(
 template<class StateObject, typename InfoMap, typename RefMap>
 Pal::Result RenderStateCache::CreateStaticPalObjectState(
     uint32_t                                settingMask,
+    StateLock                               lock,
     const typename StateObject::CreateInfo& createInfo,
     const VkAllocationCallbacks*            pAllocator,
     VkSystemAllocationScope                 parentScope,
@@ -533,7 +539,7 @@ Pal::Result RenderStateCache::CreateStaticPalObjectState(
     bool existed = false;
     StateObject** ppState = nullptr;
 
-    Util::MutexAuto lock(&m_mutex);
+    Util::MutexAuto mutexLock(&m_mutexes[lock]);
 
     // Map the createinfo to a pre-existing state object.  Allocate a new (empty) entry if one does not exist.
     result = pStateMap->FindAllocate(createInfo, &existed, &ppState);
@@ -611,6 +617,7 @@ Pal::Result RenderStateCache::CreateStaticPalObjectState(
 template<class StateObject, typename InfoMap, typename RefMap>
 void RenderStateCache::DestroyStaticPalObjectState(
     uint32_t                          settingsMask,
+    StateLock                         lock,
     typename StateObject::PalObject** ppStates,
     const VkAllocationCallbacks*      pAllocator,
     InfoMap*                          pInfoMap,
@@ -627,7 +634,7 @@ void RenderStateCache::DestroyStaticPalObjectState(
     }
     else
     {
-        Util::MutexAuto lock(&m_mutex);
+        Util::MutexAuto mutexLock(&m_mutexes[lock]);
 
         // Find the state object containing the given PAL object.  This should always exist.
         auto** pValue = pRefMap->FindKey(ppStates[0]);
@@ -666,6 +673,7 @@ Pal::Result RenderStateCache::CreateMsaaState(
 {
     return CreateStaticPalObjectState<StaticMsaaState>(
         OptRenderStateCacheMsaaState,
+        StateLockMsaa,
         createInfo,
         pAllocator,
         parentScope,
@@ -683,6 +691,7 @@ void RenderStateCache::DestroyMsaaState(
 {
     return DestroyStaticPalObjectState<StaticMsaaState>(
         OptRenderStateCacheMsaaState,
+        StateLockMsaa,
         ppStates,
         pAllocator,
         &m_msaaStates,
@@ -700,6 +709,7 @@ Pal::Result RenderStateCache::CreateColorBlendState(
 {
     return CreateStaticPalObjectState<StaticColorBlendState>(
         OptRenderStateCacheColorBlendState,
+        StateLockColorBlend,
         createInfo,
         pAllocator,
         parentScope,
@@ -717,6 +727,7 @@ void RenderStateCache::DestroyColorBlendState(
 {
     return DestroyStaticPalObjectState<StaticColorBlendState>(
         OptRenderStateCacheColorBlendState,
+        StateLockColorBlend,
         ppStates,
         pAllocator,
         &m_colorBlendStates,
@@ -734,6 +745,7 @@ Pal::Result RenderStateCache::CreateDepthStencilState(
 {
     return CreateStaticPalObjectState<StaticDepthStencilState>(
         OptRenderStateCacheDepthStencilState,
+        StateLockDepthStencil,
         createInfo,
         pAllocator,
         parentScope,
@@ -751,6 +763,7 @@ void RenderStateCache::DestroyDepthStencilState(
 {
     return DestroyStaticPalObjectState<StaticDepthStencilState>(
         OptRenderStateCacheDepthStencilState,
+        StateLockDepthStencil,
         ppStates,
         pAllocator,
         &m_depthStencilStates,
@@ -771,6 +784,7 @@ VK_INLINE bool RenderStateCache::IsEnabled(
 template<typename ParamInfo, typename ParamHashMap>
 uint32_t RenderStateCache::CreateStaticParamsState(
     uint32_t         enabledType,
+    StateLock        lock,
     const ParamInfo& params,
     ParamHashMap*    pMap,
     uint32_t*        pNextId)
@@ -779,7 +793,7 @@ uint32_t RenderStateCache::CreateStaticParamsState(
 
     if (IsEnabled(enabledType))
     {
-        Util::MutexAuto lock(&m_mutex);
+        Util::MutexAuto mutexLock(&m_mutexes[lock]);
 
         bool existed = false;
         StaticParamState* pState = nullptr;
@@ -824,13 +838,14 @@ uint32_t RenderStateCache::CreateStaticParamsState(
 template<typename ParamInfo, typename ParamHashMap>
 void RenderStateCache::DestroyStaticParamsState(
     uint32_t         enabledType,
+    StateLock        lock,
     const ParamInfo& params,
     uint32_t         token,
     ParamHashMap*    pMap)
 {
     if (IsEnabled(enabledType) && (token != DynamicRenderStateToken))
     {
-        Util::MutexAuto lock(&m_mutex);
+        Util::MutexAuto mutexLock(&m_mutexes[lock]);
 
         StaticParamState* pValue = pMap->FindKey(params);
 
@@ -854,6 +869,7 @@ uint32_t RenderStateCache::CreateInputAssemblyState(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheInputAssemblyState,
+        StateLockInputAssembly,
         params,
         &m_inputAssemblyState,
         &m_inputAssemblyStateNextId);
@@ -866,6 +882,7 @@ void RenderStateCache::DestroyInputAssemblyState(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheInputAssemblyState,
+        StateLockInputAssembly,
         params,
         token,
         &m_inputAssemblyState);
@@ -877,6 +894,7 @@ uint32_t RenderStateCache::CreateTriangleRasterState(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheTriangleRasterState,
+        StateLockTriangleRaster,
         params,
         &m_triangleRasterState,
         &m_triangleRasterStateNextId);
@@ -889,6 +907,7 @@ void RenderStateCache::DestroyTriangleRasterState(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheTriangleRasterState,
+        StateLockTriangleRaster,
         params,
         token,
         &m_triangleRasterState);
@@ -900,6 +919,7 @@ uint32_t RenderStateCache::CreatePointLineRasterState(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticPointLineRasterState,
+        StateLockPointLineRaster,
         params,
         &m_pointLineRasterState,
         &m_pointLineRasterStateNextId);
@@ -912,6 +932,7 @@ void RenderStateCache::DestroyPointLineRasterState(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticPointLineRasterState,
+        StateLockPointLineRaster,
         params,
         token,
         &m_pointLineRasterState);
@@ -923,6 +944,7 @@ uint32_t RenderStateCache::CreateDepthBias(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticDepthBias,
+        StateLockDepthBias,
         params,
         &m_depthBias,
         &m_depthBiasNextId);
@@ -935,6 +957,7 @@ void RenderStateCache::DestroyDepthBias(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticDepthBias,
+        StateLockDepthBias,
         params,
         token,
         &m_depthBias);
@@ -946,6 +969,7 @@ uint32_t RenderStateCache::CreateBlendConst(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticBlendConst,
+        StateLockBlendConst,
         params,
         &m_blendConst,
         &m_blendConstNextId);
@@ -958,6 +982,7 @@ void RenderStateCache::DestroyBlendConst(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticBlendConst,
+        StateLockBlendConst,
         params,
         token,
         &m_blendConst);
@@ -969,6 +994,7 @@ uint32_t RenderStateCache::CreateDepthBounds(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticDepthBounds,
+        StateLockDepthBounds,
         params,
         &m_depthBounds,
         &m_depthBoundsNextId);
@@ -981,6 +1007,7 @@ void RenderStateCache::DestroyDepthBounds(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticDepthBounds,
+        StateLockDepthBounds,
         params,
         token,
         &m_depthBounds);
@@ -992,6 +1019,7 @@ uint32_t RenderStateCache::CreateViewport(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticViewport,
+        StateLockViewport,
         params,
         &m_viewport,
         &m_viewportNextId);
@@ -1004,6 +1032,7 @@ void RenderStateCache::DestroyViewport(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticViewport,
+        StateLockViewport,
         params,
         token,
         &m_viewport);
@@ -1015,6 +1044,7 @@ uint32_t RenderStateCache::CreateScissorRect(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticScissorRect,
+        StateLockScissorRect,
         params,
         &m_scissorRect,
         &m_scissorRectNextId);
@@ -1027,6 +1057,7 @@ void RenderStateCache::DestroyScissorRect(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticScissorRect,
+        StateLockScissorRect,
         params,
         token,
         &m_scissorRect);
@@ -1038,6 +1069,7 @@ uint32_t RenderStateCache::CreateSamplePattern(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticSamplePattern,
+        StateLockSamplePattern,
         samplePattern,
         &m_samplePattern,
         &m_samplePatternNextId);
@@ -1050,6 +1082,7 @@ void RenderStateCache::DestroySamplePattern(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticSamplePattern,
+        StateLockSamplePattern,
         samplePattern,
         token,
         &m_samplePattern);
@@ -1061,6 +1094,7 @@ uint32_t RenderStateCache::CreateLineStipple(
 {
     return CreateStaticParamsState(
         OptRenderStateCacheStaticLineStipple,
+        StateLockLineStipple,
         params,
         &m_lineStippleState,
         &m_lineStippleStateNextId);
@@ -1073,6 +1107,7 @@ void RenderStateCache::DestroyLineStipple(
 {
     return DestroyStaticParamsState(
         OptRenderStateCacheStaticLineStipple,
+        StateLockLineStipple,
         params,
         token,
         &m_lineStippleState);
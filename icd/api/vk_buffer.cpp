@@ -393,23 +393,27 @@ VkResult Buffer::BindMemory(
     // The buffer must not be sparse
     VK_ASSERT(IsSparse() == false);
 
-    // Simply use the passed memory object and offset directly
-    m_memOffset = memOffset;
+    Memory*  pMemory = (mem != VK_NULL_HANDLE) ? Memory::ObjectFromHandle(mem) : nullptr;
+    VkResult result  = (pMemory != nullptr) ? pMemory->CommitResidency() : VK_SUCCESS;
 
-    if (mem != VK_NULL_HANDLE)
+    if (result == VK_SUCCESS)
     {
-        Memory*pMemory = Memory::ObjectFromHandle(mem);
+        // Simply use the passed memory object and offset directly, relative to the PAL memory of a sub-allocation
+        m_memOffset = memOffset + ((pMemory != nullptr) ? pMemory->PalOffset() : 0);
+    }
 
+    if ((pMemory != nullptr) && (result == VK_SUCCESS))
+    {
         if (pDevice->IsMultiGpu() == false)
         {
             const uint32_t singleIdx = DefaultDeviceIndex;
 
             Pal::IGpuMemory* pPalMemory = pMemory->PalMemory(singleIdx);
             m_perGpu[singleIdx].pGpuMemory  = pPalMemory;
-            m_perGpu[singleIdx].gpuVirtAddr = pPalMemory->Desc().gpuVirtAddr + memOffset;
+            m_perGpu[singleIdx].gpuVirtAddr = pPalMemory->Desc().gpuVirtAddr + m_memOffset;
 
             // @NOTE - This only handles the single GPU case currently.  MGPU is not supported by RMV v1
-            LogGpuMemoryBind(pDevice, pPalMemory, memOffset);
+            LogGpuMemoryBind(pDevice, pPalMemory, m_memOffset);
         }
         else
         {
@@ -420,12 +424,12 @@ VkResult Buffer::BindMemory(
 
                 m_perGpu[localDeviceIdx].pGpuMemory  = pMemory->PalMemory(localDeviceIdx, sourceMemInst);
                 m_perGpu[localDeviceIdx].gpuVirtAddr =
-                    m_perGpu[localDeviceIdx].pGpuMemory->Desc().gpuVirtAddr + memOffset;
+                    m_perGpu[localDeviceIdx].pGpuMemory->Desc().gpuVirtAddr + m_memOffset;
             }
         }
     }
 
-    return VK_SUCCESS;
+    return result;
 }
 
 // =====================================================================================================================
@@ -333,6 +333,19 @@ Pal::Result CreateClearRects(
     return palResult;
 }
 
+// =====================================================================================================================
+// Returns true if the two subresource ranges of the same image share at least one subresource.
+bool SubresRangesOverlap(
+    const Pal::SubresRange& range1,
+    const Pal::SubresRange& range2)
+{
+    return (range1.startSubres.aspect == range2.startSubres.aspect)                              &&
+           (range1.startSubres.mipLevel   < (range2.startSubres.mipLevel   + range2.numMips))   &&
+           (range2.startSubres.mipLevel   < (range1.startSubres.mipLevel   + range1.numMips))   &&
+           (range1.startSubres.arraySlice < (range2.startSubres.arraySlice + range2.numSlices)) &&
+           (range2.startSubres.arraySlice < (range1.startSubres.arraySlice + range1.numSlices));
+}
+
 } // anonymous ns
 
 // =====================================================================================================================
@@ -358,7 +371,10 @@ CmdBuffer::CmdBuffer(
     m_barrierPolicy(barrierPolicy),
     m_pSqttState(nullptr),
     m_renderPassInstance(pDevice->VkInstance()->Allocator()),
-    m_pTransformFeedbackState(nullptr)
+    m_pTransformFeedbackState(nullptr),
+    m_pDeferredBarrier(nullptr),
+    m_pImageLayouts(nullptr),
+    m_pBarrierLog(nullptr)
 {
     m_flags.needResetState = true;
 
@@ -543,6 +559,55 @@ VkResult CmdBuffer::Initialize(
         }
     }
 
+    if ((result == Pal::Result::Success) && m_pDevice->GetRuntimeSettings().deferPipelineBarriers)
+    {
+        void* pDeferredStorage = m_pDevice->VkInstance()->AllocMem(sizeof(DeferredBarrierState),
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+        if (pDeferredStorage != nullptr)
+        {
+            m_pDeferredBarrier = static_cast<DeferredBarrierState*>(pDeferredStorage);
+
+            memset(m_pDeferredBarrier, 0, sizeof(DeferredBarrierState));
+        }
+        else
+        {
+            result = Pal::Result::ErrorOutOfMemory;
+        }
+    }
+
+    if ((result == Pal::Result::Success) && m_pDevice->GetRuntimeSettings().enableImageLayoutTracking)
+    {
+        void* pTrackerStorage = m_pDevice->VkInstance()->AllocMem(sizeof(ImageLayoutTrackerState),
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+        if (pTrackerStorage != nullptr)
+        {
+            m_pImageLayouts = static_cast<ImageLayoutTrackerState*>(pTrackerStorage);
+
+            memset(m_pImageLayouts, 0, sizeof(ImageLayoutTrackerState));
+        }
+        else
+        {
+            result = Pal::Result::ErrorOutOfMemory;
+        }
+    }
+
+    if ((result == Pal::Result::Success) && m_pDevice->GetBarrierAnalyzer()->IsEnabled())
+    {
+        void* pLogStorage = m_pDevice->VkInstance()->AllocMem(sizeof(CmdBufferBarrierLog),
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+        if (pLogStorage != nullptr)
+        {
+            m_pBarrierLog = VK_PLACEMENT_NEW(pLogStorage) CmdBufferBarrierLog(m_pDevice->VkInstance()->Allocator());
+        }
+        else
+        {
+            result = Pal::Result::ErrorOutOfMemory;
+        }
+    }
+
     return PalToVkResult(result);
 }
 
@@ -1184,11 +1249,18 @@ VkResult CmdBuffer::End(void)
 
     DbgBarrierPreCmd(DbgBarrierCmdBufEnd);
 
+    FlushDeferredBarriers();
+
     if (m_pSqttState != nullptr)
     {
         m_pSqttState->End();
     }
 
+    if (m_pBarrierLog != nullptr)
+    {
+        m_pDevice->GetBarrierAnalyzer()->Report(*m_pBarrierLog, m_queueFamilyIndex, m_flags.is2ndLvl);
+    }
+
     DbgBarrierPostCmd(DbgBarrierCmdBufEnd);
 
     result = PalCmdBufferEnd();
@@ -1208,6 +1280,9 @@ void CmdBuffer::ResetPipelineState()
 
     memset(&m_state.allGpuState.staticTokens, 0u, sizeof(m_state.allGpuState.staticTokens));
 
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
+    m_state.allGpuState.pComputePipeline   = nullptr;
+
     uint32_t bindIdx = 0;
     do
     {
@@ -1274,6 +1349,22 @@ void CmdBuffer::ResetState()
     m_recordingResult = VK_SUCCESS;
 
     m_flags.hasConditionalRendering = false;
+
+    if (m_pDeferredBarrier != nullptr)
+    {
+        m_pDeferredBarrier->pending = false;
+    }
+
+    if (m_pImageLayouts != nullptr)
+    {
+        m_pImageLayouts->entryCount   = 0;
+        m_pImageLayouts->nextReplaced = 0;
+    }
+
+    if (m_pBarrierLog != nullptr)
+    {
+        m_pBarrierLog->Reset();
+    }
 }
 
 // =====================================================================================================================
@@ -1330,6 +1421,41 @@ void CmdBuffer::ConvertPipelineBindPoint(
     }
 }
 
+// =====================================================================================================================
+// Returns true if binding the given compute pipeline would not change any state: the same PAL pipelines are bound to
+// the PAL compute bind point on behalf of the API's compute bind point with the same API hash and wave limits, and the
+// user data layout is identical.  This is the case when a pipeline is re-bound, and when one of several identical
+// pipelines sharing their PAL pipelines is bound.
+VK_INLINE bool CmdBuffer::IsComputePipelineBound(
+    const ComputePipeline* pPipeline) const
+{
+    const ComputePipeline* pCurPipeline = m_state.allGpuState.pComputePipeline;
+
+    bool bound = (pCurPipeline != nullptr) &&
+                 PalPipelineBindingOwnedBy(Pal::PipelineBindPoint::Compute, PipelineBindCompute);
+
+    if (bound && (pCurPipeline != pPipeline))
+    {
+        // The API hash and wave limits are passed along with the PAL pipeline, so they have to match as well
+        bound = (pCurPipeline->PalPipelineHash() == pPipeline->PalPipelineHash()) &&
+                (pCurPipeline->GetApiHash() == pPipeline->GetApiHash())            &&
+                (memcmp(&pCurPipeline->GetComputeWaveLimitParams(),
+                        &pPipeline->GetComputeWaveLimitParams(),
+                        sizeof(Pal::DynamicComputeShaderInfo)) == 0);
+
+        for (uint32_t deviceIdx = 0; bound && (deviceIdx < m_pDevice->NumPalDevices()); deviceIdx++)
+        {
+            bound = (pCurPipeline->PalPipeline(deviceIdx) == pPipeline->PalPipeline(deviceIdx));
+        }
+
+        bound = bound && (memcmp(pPipeline->GetUserDataLayout(),
+                                 &m_state.allGpuState.pipelineState[PipelineBindCompute].userDataLayout,
+                                 sizeof(UserDataLayout)) == 0);
+    }
+
+    return bound;
+}
+
 // =====================================================================================================================
 // Bind pipeline to command buffer
 void CmdBuffer::BindPipeline(
@@ -1351,10 +1477,16 @@ void CmdBuffer::BindPipeline(
     {
     case PipelineBindCompute:
         {
-            if (pipeline != VK_NULL_HANDLE)
+            const ComputePipeline* pPipeline = (pipeline != VK_NULL_HANDLE) ?
+                NonDispatchable<VkPipeline, ComputePipeline>::ObjectFromHandle(pipeline) : nullptr;
+
+            if ((pPipeline != nullptr) && IsComputePipelineBound(pPipeline))
+            {
+                // Neither the PAL pipeline nor the user data layout change, so there is nothing to rebind.
+                m_state.allGpuState.pComputePipeline = pPipeline;
+            }
+            else if (pPipeline != nullptr)
             {
-                const ComputePipeline* pPipeline       = NonDispatchable<VkPipeline,
-                                                                         ComputePipeline>::ObjectFromHandle(pipeline);
                 const PhysicalDevice*  pPhysicalDevice = m_pDevice->VkPhysicalDevice(DefaultDeviceIndex);
                 const RuntimeSettings& settings        = m_pDevice->GetRuntimeSettings();
 
@@ -1402,7 +1534,8 @@ void CmdBuffer::BindPipeline(
             else
             {
                 GraphicsPipeline::BindNullPipeline(this);
-                m_state.allGpuState.pGraphicsPipeline = nullptr;
+                m_state.allGpuState.pGraphicsPipeline  = nullptr;
+                m_state.allGpuState.pDeltaBasePipeline = nullptr;
             }
         }
         break;
@@ -1537,6 +1670,8 @@ void CmdBuffer::ExecuteCommands(
 {
     DbgBarrierPreCmd(DbgBarrierExecuteCommands);
 
+    FlushDeferredBarriers();
+
     for (uint32_t i = 0; i < cmdBufferCount; i++)
     {
         CmdBuffer* pInteralCmdBuf = ApiCmdBuffer::ObjectFromHandle(pCmdBuffers[i]);
@@ -1556,6 +1691,13 @@ void CmdBuffer::ExecuteCommands(
     // in that case they cannot be used after ends of execution secondary command buffer
     ResetPipelineState();
 
+    // Secondary command buffers may have transitioned any image
+    if (m_pImageLayouts != nullptr)
+    {
+        m_pImageLayouts->entryCount   = 0;
+        m_pImageLayouts->nextReplaced = 0;
+    }
+
     DbgBarrierPostCmd(DbgBarrierExecuteCommands);
 }
 
@@ -1577,6 +1719,23 @@ VkResult CmdBuffer::Destroy(void)
         pInstance->FreeMem(m_pTransformFeedbackState);
     }
 
+    if (m_pDeferredBarrier != nullptr)
+    {
+        pInstance->FreeMem(m_pDeferredBarrier);
+    }
+
+    if (m_pImageLayouts != nullptr)
+    {
+        pInstance->FreeMem(m_pImageLayouts);
+    }
+
+    if (m_pBarrierLog != nullptr)
+    {
+        Util::Destructor(m_pBarrierLog);
+
+        pInstance->FreeMem(m_pBarrierLog);
+    }
+
     // Unregister this command buffer from the pool
     m_pCmdPool->UnregisterCmdBuffer(this);
 
@@ -1876,6 +2035,8 @@ void CmdBuffer::Draw(
 {
     DbgBarrierPreCmd(DbgBarrierDrawNonIndexed);
 
+    FlushDeferredBarriers();
+
     ValidateStates();
 
     PalCmdDraw(firstVertex,
@@ -1896,6 +2057,8 @@ void CmdBuffer::DrawIndexed(
 {
     DbgBarrierPreCmd(DbgBarrierDrawIndexed);
 
+    FlushDeferredBarriers();
+
     ValidateStates();
 
     PalCmdDrawIndexed(firstIndex,
@@ -1919,11 +2082,14 @@ void CmdBuffer::DrawIndirect(
 {
     DbgBarrierPreCmd((indexed ? DbgBarrierDrawIndexed : DbgBarrierDrawNonIndexed) | DbgBarrierDrawIndirect);
 
+    FlushDeferredBarriers();
+
     ValidateStates();
 
     Buffer* pBuffer = Buffer::ObjectFromHandle(buffer);
 
-    if ((stride + offset) <= pBuffer->PalMemory(DefaultDeviceIndex)->Desc().size)
+    // Compare against the buffer itself since its PAL memory may be a pool that other allocations share
+    if ((stride + offset) <= pBuffer->GetSize())
     {
         const Pal::gpusize paramOffset = pBuffer->MemOffset() + offset;
         Pal::gpusize countVirtAddr = 0;
@@ -1973,6 +2139,8 @@ void CmdBuffer::Dispatch(
 {
     DbgBarrierPreCmd(DbgBarrierDispatch);
 
+    FlushDeferredBarriers();
+
     if (PalPipelineBindingOwnedBy(Pal::PipelineBindPoint::Compute, PipelineBindCompute) == false)
     {
         RebindCompatibleUserData(PipelineBindCompute, Pal::PipelineBindPoint::Compute, RebindUserDataAll);
@@ -1994,6 +2162,8 @@ void CmdBuffer::DispatchOffset(
 {
     DbgBarrierPreCmd(DbgBarrierDispatch);
 
+    FlushDeferredBarriers();
+
     if (PalPipelineBindingOwnedBy(Pal::PipelineBindPoint::Compute, PipelineBindCompute) == false)
     {
         RebindCompatibleUserData(PipelineBindCompute, Pal::PipelineBindPoint::Compute, RebindUserDataAll);
@@ -2011,6 +2181,8 @@ void CmdBuffer::DispatchIndirect(
 {
     DbgBarrierPreCmd(DbgBarrierDispatchIndirect);
 
+    FlushDeferredBarriers();
+
     if (PalPipelineBindingOwnedBy(Pal::PipelineBindPoint::Compute, PipelineBindCompute) == false)
     {
         RebindCompatibleUserData(PipelineBindCompute, Pal::PipelineBindPoint::Compute, RebindUserDataAll);
@@ -2032,6 +2204,8 @@ void CmdBuffer::CopyBuffer(
 {
     DbgBarrierPreCmd(DbgBarrierCopyBuffer);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -2084,6 +2258,8 @@ void CmdBuffer::CopyImage(
 {
     DbgBarrierPreCmd(DbgBarrierCopyImage);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -2147,6 +2323,8 @@ void CmdBuffer::BlitImage(
 {
     DbgBarrierPreCmd(DbgBarrierCopyImage);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -2219,6 +2397,8 @@ void CmdBuffer::CopyBufferToImage(
 {
     DbgBarrierPreCmd(DbgBarrierCopyBuffer | DbgBarrierCopyImage);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -2280,6 +2460,8 @@ void CmdBuffer::CopyImageToBuffer(
 {
     DbgBarrierPreCmd(DbgBarrierCopyBuffer | DbgBarrierCopyImage);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -2341,6 +2523,8 @@ void CmdBuffer::UpdateBuffer(
 {
     DbgBarrierPreCmd(DbgBarrierCopyBuffer);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     Buffer* pDestBuffer = Buffer::ObjectFromHandle(destBuffer);
@@ -2361,6 +2545,8 @@ void CmdBuffer::FillBuffer(
 {
     DbgBarrierPreCmd(DbgBarrierCopyBuffer);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     Buffer* pDestBuffer = Buffer::ObjectFromHandle(destBuffer);
@@ -2386,6 +2572,8 @@ void CmdBuffer::ClearColorImage(
     uint32_t                       rangeCount,
     const VkImageSubresourceRange* pRanges)
 {
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     const Image* pImage = Image::ObjectFromHandle(image);
@@ -2498,6 +2686,8 @@ void CmdBuffer::ClearDepthStencilImage(
     uint32_t                       rangeCount,
     const VkImageSubresourceRange* pRanges)
 {
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -2565,6 +2755,8 @@ void CmdBuffer::ClearAttachments(
     uint32_t                 rectCount,
     const VkClearRect*       pRects)
 {
+    FlushDeferredBarriers();
+
     if ((m_flags.is2ndLvl == false) && (m_state.allGpuState.pFramebuffer != nullptr))
     {
         ClearImageAttachments(attachmentCount, pAttachments, rectCount, pRects);
@@ -3020,6 +3212,8 @@ void CmdBuffer::ResolveImage(
     uint32_t              rectCount,
     const VkImageResolve* pRects)
 {
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
@@ -3087,6 +3281,8 @@ void CmdBuffer::SetEvent(
 {
     DbgBarrierPreCmd(DbgBarrierSetResetEvent);
 
+    FlushDeferredBarriers();
+
     PalCmdSetEvent(Event::ObjectFromHandle(event), VkToPalSrcPipePoint(stageMask));
 
     DbgBarrierPostCmd(DbgBarrierSetResetEvent);
@@ -3099,6 +3295,8 @@ void CmdBuffer::ResetEvent(
 {
     DbgBarrierPreCmd(DbgBarrierSetResetEvent);
 
+    FlushDeferredBarriers();
+
     Event* pEvent = Event::ObjectFromHandle(event);
 
     const Pal::HwPipePoint pipePoint = VkToPalSrcPipePoint(stageMask);
@@ -3126,13 +3324,298 @@ void CmdBuffer::FlushBarriers(
     pBarrier->transitionCount = mainTransitionCount;
     pBarrier->pTransitions    = pTransitions;
 
-    PalCmdBarrier(pBarrier, pTransitions, pTransitionImages, m_curDeviceMask);
+    if (m_pBarrierLog != nullptr)
+    {
+        m_pBarrierLog->AddPalBarrier(*pBarrier);
+    }
+
+    if ((m_pDeferredBarrier == nullptr) || (DeferBarrier(*pBarrier, pTransitions, pTransitionImages) == false))
+    {
+        PalCmdBarrier(pBarrier, pTransitions, pTransitionImages, m_curDeviceMask);
+    }
 
     // Remove any signaled events as we do not want to wait more than once.
     pBarrier->gpuEventWaitCount = 0;
     pBarrier->ppGpuEvents = nullptr;
 }
 
+// =====================================================================================================================
+// Merges a barrier recorded by vkCmdPipelineBarrier() into the deferred barrier instead of executing it.  Memory
+// transitions are folded into the global cache masks and a layout transition of the same subresources as a deferred
+// one is chained onto it.  Returns false if the barrier cannot be deferred, in which case the caller has to execute it.
+bool CmdBuffer::DeferBarrier(
+    const Pal::BarrierInfo&       barrier,
+    const Pal::BarrierTransition* pTransitions,
+    const Image* const*           pTransitionImages)
+{
+    DeferredBarrierState* pState = m_pDeferredBarrier;
+
+    // Event waits and split barriers keep their own ordering and are never deferred.
+    bool canDefer = (barrier.reason == RgpBarrierExternalCmdPipelineBarrier) &&
+                    (barrier.gpuEventWaitCount == 0)                         &&
+                    (barrier.pSplitBarrierGpuEvent == nullptr);
+
+    uint32_t imageTransitionCount = 0;
+    bool     conflict             = pState->pending &&
+                                    ((pState->deviceMask != m_curDeviceMask) ||
+                                     (pState->info.flags.u32All != barrier.flags.u32All));
+
+    for (uint32_t i = 0; canDefer && (i < barrier.transitionCount); ++i)
+    {
+        const Pal::BarrierTransition& transition = pTransitions[i];
+
+        if (transition.imageInfo.pImage != nullptr)
+        {
+            // Sample locations point into the caller's stack frame.
+            canDefer = (transition.imageInfo.pQuadSamplePattern == nullptr);
+
+            imageTransitionCount++;
+
+            // A transition can only be chained onto a deferred one of exactly the same subresources.  Any other
+            // overlap needs the deferred transition to complete first.
+            for (uint32_t j = 0; (conflict == false) && pState->pending && (j < pState->info.transitionCount); ++j)
+            {
+                const Pal::BarrierTransition& deferred = pState->transitions[j];
+
+                if ((deferred.imageInfo.pImage == transition.imageInfo.pImage) &&
+                    SubresRangesOverlap(deferred.imageInfo.subresRange, transition.imageInfo.subresRange))
+                {
+                    conflict = (memcmp(&deferred.imageInfo.subresRange,
+                                       &transition.imageInfo.subresRange,
+                                       sizeof(Pal::SubresRange)) != 0) ||
+                               (deferred.imageInfo.newLayout.usages  != transition.imageInfo.oldLayout.usages) ||
+                               (deferred.imageInfo.newLayout.engines != transition.imageInfo.oldLayout.engines);
+                }
+            }
+        }
+    }
+
+    canDefer = canDefer && (imageTransitionCount <= DeferredBarrierState::MaxTransitionCount);
+
+    if (canDefer)
+    {
+        if (pState->pending &&
+            (conflict ||
+             ((pState->info.transitionCount + imageTransitionCount) > DeferredBarrierState::MaxTransitionCount)))
+        {
+            ExecuteDeferredBarriers();
+        }
+
+        if (pState->pending == false)
+        {
+            memset(&pState->info, 0, sizeof(pState->info));
+
+            pState->info.flags.u32All = barrier.flags.u32All;
+            pState->info.reason       = barrier.reason;
+            pState->info.waitPoint    = barrier.waitPoint;
+            pState->deviceMask        = m_curDeviceMask;
+            pState->pending           = true;
+        }
+        else if (barrier.waitPoint < pState->info.waitPoint)
+        {
+            pState->info.waitPoint = barrier.waitPoint;
+        }
+
+        for (uint32_t i = 0; i < barrier.pipePointWaitCount; ++i)
+        {
+            const Pal::HwPipePoint pipePoint = barrier.pPipePoints[i];
+
+            // Waiting at the bottom of the pipe covers every other pipe point.
+            bool seen = false;
+
+            for (uint32_t j = 0; (j < pState->info.pipePointWaitCount) && (seen == false); ++j)
+            {
+                seen = (pState->pipePoints[j] == pipePoint) || (pState->pipePoints[j] == Pal::HwPipeBottom);
+            }
+
+            if (seen == false)
+            {
+                if (pipePoint == Pal::HwPipeBottom)
+                {
+                    pState->info.pipePointWaitCount = 0;
+                }
+
+                VK_ASSERT(pState->info.pipePointWaitCount < MaxHwPipePoints);
+
+                pState->pipePoints[pState->info.pipePointWaitCount++] = pipePoint;
+            }
+        }
+
+        pState->info.globalSrcCacheMask |= barrier.globalSrcCacheMask;
+        pState->info.globalDstCacheMask |= barrier.globalDstCacheMask;
+
+        for (uint32_t i = 0; i < barrier.transitionCount; ++i)
+        {
+            const Pal::BarrierTransition& transition = pTransitions[i];
+
+            if (transition.imageInfo.pImage == nullptr)
+            {
+                pState->info.globalSrcCacheMask |= transition.srcCacheMask;
+                pState->info.globalDstCacheMask |= transition.dstCacheMask;
+            }
+            else
+            {
+                Pal::BarrierTransition* pDeferred = nullptr;
+
+                for (uint32_t j = 0; (j < pState->info.transitionCount) && (pDeferred == nullptr); ++j)
+                {
+                    if ((pState->transitions[j].imageInfo.pImage == transition.imageInfo.pImage) &&
+                        SubresRangesOverlap(pState->transitions[j].imageInfo.subresRange,
+                                            transition.imageInfo.subresRange))
+                    {
+                        pDeferred = &pState->transitions[j];
+                    }
+                }
+
+                if (pDeferred != nullptr)
+                {
+                    pDeferred->srcCacheMask        |= transition.srcCacheMask;
+                    pDeferred->dstCacheMask        |= transition.dstCacheMask;
+                    pDeferred->imageInfo.newLayout  = transition.imageInfo.newLayout;
+                }
+                else
+                {
+                    const uint32_t index = pState->info.transitionCount++;
+
+                    pState->transitions[index]       = transition;
+                    pState->pTransitionImages[index] = (pTransitionImages != nullptr) ? pTransitionImages[i] : nullptr;
+                }
+            }
+        }
+    }
+
+    return canDefer;
+}
+
+// =====================================================================================================================
+// Executes the barrier merged from all deferred vkCmdPipelineBarrier() barriers.
+void CmdBuffer::ExecuteDeferredBarriers()
+{
+    DeferredBarrierState* pState = m_pDeferredBarrier;
+
+    VK_ASSERT((pState != nullptr) && pState->pending);
+
+    // Clear this first, PalCmdBarrier() flushes any deferred barriers itself.
+    pState->pending = false;
+
+    pState->info.pPipePoints  = pState->pipePoints;
+    pState->info.pTransitions = pState->transitions;
+
+    PalCmdBarrier(&pState->info, pState->transitions, pState->pTransitionImages, pState->deviceMask);
+}
+
+// =====================================================================================================================
+// Returns the layout the given subresource range was last transitioned to within this command buffer.  Returns false
+// if it is unknown, e.g. because only part of the range was transitioned.
+bool CmdBuffer::GetTrackedImageLayout(
+    const Pal::IImage*      pImage,
+    const Pal::SubresRange& subresRange,
+    Pal::ImageLayout*       pLayout) const
+{
+    const ImageLayoutTrackerState* pTracker = m_pImageLayouts;
+
+    bool found = false;
+
+    for (uint32_t i = 0; (i < pTracker->entryCount) && (found == false); ++i)
+    {
+        const ImageLayoutTrackerState::Entry& entry = pTracker->entries[i];
+
+        if ((entry.pImage == pImage) &&
+            (memcmp(&entry.subresRange, &subresRange, sizeof(Pal::SubresRange)) == 0))
+        {
+            *pLayout = entry.layout;
+            found    = true;
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Records the layout the given subresource range was transitioned to, or forgets it if pLayout is null.  The layouts
+// of any other tracked ranges overlapping it are forgotten as well.
+void CmdBuffer::TrackImageLayout(
+    const Pal::IImage*      pImage,
+    const Pal::SubresRange& subresRange,
+    const Pal::ImageLayout* pLayout)
+{
+    ImageLayoutTrackerState* pTracker = m_pImageLayouts;
+
+    uint32_t i = 0;
+
+    while (i < pTracker->entryCount)
+    {
+        const ImageLayoutTrackerState::Entry& entry = pTracker->entries[i];
+
+        if ((entry.pImage == pImage) && SubresRangesOverlap(entry.subresRange, subresRange))
+        {
+            // Keep the entries packed
+            pTracker->entries[i] = pTracker->entries[--pTracker->entryCount];
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    if (pLayout != nullptr)
+    {
+        uint32_t index = pTracker->entryCount;
+
+        if (index < ImageLayoutTrackerState::MaxEntryCount)
+        {
+            pTracker->entryCount++;
+        }
+        else
+        {
+            index = pTracker->nextReplaced;
+
+            pTracker->nextReplaced = (index + 1) % ImageLayoutTrackerState::MaxEntryCount;
+        }
+
+        pTracker->entries[index].pImage      = pImage;
+        pTracker->entries[index].subresRange = subresRange;
+        pTracker->entries[index].layout      = *pLayout;
+    }
+}
+
+// =====================================================================================================================
+// Applies the layout tracking to an image layout transition built for the given image memory barrier.  Barriers that
+// preserve the contents transition from the layout the range was actually left in by this command buffer, and the
+// transition only does cache operations if that already is the new layout.
+void CmdBuffer::TrackImageLayoutTransition(
+    const VkImageMemoryBarrier& barrier,
+    Pal::BarrierTransition*     pTransition)
+{
+    const Pal::IImage* pPalImage = pTransition->imageInfo.pImage;
+
+    if (barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex)
+    {
+        // The other queue family of an ownership transfer may transition the image instead
+        TrackImageLayout(pPalImage, pTransition->imageInfo.subresRange, nullptr);
+    }
+    else
+    {
+        Pal::ImageLayout trackedLayout = {};
+
+        // Transitions from the undefined layout keep theirs, they are required e.g. after another resource aliasing
+        // the same memory was written.
+        if ((barrier.oldLayout != VK_IMAGE_LAYOUT_UNDEFINED) &&
+            GetTrackedImageLayout(pPalImage, pTransition->imageInfo.subresRange, &trackedLayout))
+        {
+            pTransition->imageInfo.oldLayout = trackedLayout;
+        }
+
+        TrackImageLayout(pPalImage, pTransition->imageInfo.subresRange, &pTransition->imageInfo.newLayout);
+
+        if ((pTransition->imageInfo.oldLayout.usages  == pTransition->imageInfo.newLayout.usages) &&
+            (pTransition->imageInfo.oldLayout.engines == pTransition->imageInfo.newLayout.engines))
+        {
+            pTransition->imageInfo.pImage = nullptr;
+        }
+    }
+}
+
 // =====================================================================================================================
 // ExecuteBarriers  Called by vkCmdWaitEvents() and vkCmdPipelineBarrier().
 void CmdBuffer::ExecuteBarriers(
@@ -3340,6 +3823,11 @@ void CmdBuffer::ExecuteBarriers(
                     pDestTransition[transitionIdx].imageInfo.pQuadSamplePattern = &pLocations[locationIndex];
                 }
 
+                if (m_pImageLayouts != nullptr)
+                {
+                    TrackImageLayoutTransition(pImageMemoryBarriers[i], &pDestTransition[transitionIdx]);
+                }
+
                 layoutIdx++;
                 palRangeIdx++;
             }
@@ -3357,6 +3845,16 @@ void CmdBuffer::ExecuteBarriers(
                 pDestTransition[transitionIdx].dstCacheMask     = barrierTransition.dstCacheMask;
                 pDestTransition[transitionIdx].imageInfo.pImage = nullptr;
             }
+
+            // The other queue family of an ownership transfer may transition the image instead
+            if ((m_pImageLayouts != nullptr) &&
+                (pImageMemoryBarriers[i].srcQueueFamilyIndex != pImageMemoryBarriers[i].dstQueueFamilyIndex))
+            {
+                for (uint32_t rangeIdx = 0; rangeIdx < palRangeCount; rangeIdx++)
+                {
+                    TrackImageLayout(pImage->PalImage(DefaultDeviceIndex), palRanges[rangeIdx], nullptr);
+                }
+            }
         }
 
         const uint32_t mainTransitionCount = static_cast<uint32_t>(pNextMain - pTransitions);
@@ -3433,6 +3931,20 @@ void CmdBuffer::WaitEvents(
         barrier.ppGpuEvents           = ppGpuEvents;
         barrier.pSplitBarrierGpuEvent = nullptr;
 
+        if (m_pBarrierLog != nullptr)
+        {
+            m_pBarrierLog->BeginBarrier(true,
+                                        srcStageMask,
+                                        dstStageMask,
+                                        eventCount,
+                                        memoryBarrierCount,
+                                        pMemoryBarriers,
+                                        bufferMemoryBarrierCount,
+                                        pBufferMemoryBarriers,
+                                        imageMemoryBarrierCount,
+                                        pImageMemoryBarriers);
+        }
+
         ExecuteBarriers(virtStackFrame,
                         memoryBarrierCount,
                         pMemoryBarriers,
@@ -3442,6 +3954,11 @@ void CmdBuffer::WaitEvents(
                         pImageMemoryBarriers,
                         &barrier);
 
+        if (m_pBarrierLog != nullptr)
+        {
+            m_pBarrierLog->EndBarrier();
+        }
+
         virtStackFrame.FreeArray(ppGpuEvents);
     }
     else
@@ -3483,6 +4000,20 @@ void CmdBuffer::PipelineBarrier(
     barrier.pPipePoints             = pipePoints;
     barrier.pSplitBarrierGpuEvent   = nullptr;
 
+    if (m_pBarrierLog != nullptr)
+    {
+        m_pBarrierLog->BeginBarrier(false,
+                                    srcStageMask,
+                                    destStageMask,
+                                    barrier.pipePointWaitCount,
+                                    memBarrierCount,
+                                    pMemoryBarriers,
+                                    bufferMemoryBarrierCount,
+                                    pBufferMemoryBarriers,
+                                    imageMemoryBarrierCount,
+                                    pImageMemoryBarriers);
+    }
+
     ExecuteBarriers(virtStackFrame,
                     memBarrierCount,
                     pMemoryBarriers,
@@ -3492,6 +4023,11 @@ void CmdBuffer::PipelineBarrier(
                     pImageMemoryBarriers,
                     &barrier);
 
+    if (m_pBarrierLog != nullptr)
+    {
+        m_pBarrierLog->EndBarrier();
+    }
+
     DbgBarrierPostCmd(DbgBarrierPipelineBarrierWaitEvents);
 }
 
@@ -3504,6 +4040,8 @@ void CmdBuffer::BeginQueryIndexed(
 {
     DbgBarrierPreCmd(DbgBarrierQueryBeginEnd);
 
+    FlushDeferredBarriers();
+
     const QueryPool* pBasePool = QueryPool::ObjectFromHandle(queryPool);
     const auto palQueryControlFlags = VkToPalQueryControlFlags(pBasePool->GetQueryType(), flags);
 
@@ -3576,6 +4114,8 @@ void CmdBuffer::EndQueryIndexed(
 {
     DbgBarrierPreCmd(DbgBarrierQueryBeginEnd);
 
+    FlushDeferredBarriers();
+
     // NOTE: This function is illegal to call for TimestampQueryPools
     const PalQueryPool* pQueryPool = QueryPool::ObjectFromHandle(queryPool)->AsPalQueryPool();
     Pal::QueryType queryType = pQueryPool->PalQueryType();
@@ -3707,6 +4247,8 @@ void CmdBuffer::ResetQueryPool(
 {
     DbgBarrierPreCmd(DbgBarrierQueryReset);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     const QueryPool* pBasePool = QueryPool::ObjectFromHandle(queryPool);
@@ -3755,6 +4297,9 @@ void CmdBuffer::PalCmdBarrier(
     // in the header, but temporarily you may use the generic "unknown" reason so as not to block your main code change.
     VK_ASSERT(info.reason != 0);
 
+    // Deferred barriers were recorded before this one, so they have to be executed first.
+    FlushDeferredBarriers();
+
 #if PAL_ENABLE_PRINTS_ASSERTS
     for (uint32_t i = 0; i < info.transitionCount; ++i)
     {
@@ -3789,6 +4334,8 @@ void CmdBuffer::PalCmdBarrier(
     // in the header, but temporarily you may use the generic "unknown" reason so as not to block you.
     VK_ASSERT(pInfo->reason != 0);
 
+    FlushDeferredBarriers();
+
     const Pal::IGpuEvent** ppOriginalGpuEvents = pInfo->ppGpuEvents;
 
     utils::IterateMask deviceGroup(deviceMask);
@@ -3827,6 +4374,9 @@ void CmdBuffer::PalCmdBarrier(
 void CmdBuffer::PalCmdBindMsaaStates(
     const Pal::IMsaaState* const * pStates)
 {
+    // This overrides the MSAA state bound with the current graphics pipeline
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
 
     do
@@ -3881,6 +4431,8 @@ void CmdBuffer::CopyQueryPoolResults(
 {
     DbgBarrierPreCmd(DbgBarrierCopyBuffer | DbgBarrierCopyQueryPool);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     const QueryPool* pBasePool = QueryPool::ObjectFromHandle(queryPool);
@@ -4055,6 +4607,8 @@ void CmdBuffer::WriteTimestamp(
 {
     DbgBarrierPreCmd(DbgBarrierWriteTimestamp);
 
+    FlushDeferredBarriers();
+
     PalCmdSuspendPredication(true);
 
     utils::IterateMask deviceGroup(m_curDeviceMask);
@@ -4149,6 +4703,8 @@ void CmdBuffer::BeginRenderPass(
 
     DbgBarrierPreCmd(DbgBarrierBeginRenderPass);
 
+    FlushDeferredBarriers();
+
     m_state.allGpuState.pRenderPass  = RenderPass::ObjectFromHandle(pRenderPassBegin->renderPass);
     m_state.allGpuState.pFramebuffer = Framebuffer::ObjectFromHandle(pRenderPassBegin->framebuffer);
 
@@ -4453,6 +5009,8 @@ void CmdBuffer::NextSubPass(
 
     DbgBarrierPreCmd(DbgBarrierNextSubpass);
 
+    FlushDeferredBarriers();
+
     if (m_renderPassInstance.subpass != VK_SUBPASS_EXTERNAL)
     {
         // End the previous subpass
@@ -4684,6 +5242,11 @@ void CmdBuffer::RPSyncPoint(
                     pLayoutTransition->imageInfo.pQuadSamplePattern = pQuadSamplePattern;
 
                     RPSetAttachmentLayout(tr.attachment, aspect, newLayout);
+
+                    if (m_pImageLayouts != nullptr)
+                    {
+                        TrackImageLayout(pLayoutTransition->imageInfo.pImage, attachment.subresRange[sr], &newLayout);
+                    }
                 }
             }
         }
@@ -5078,6 +5641,8 @@ void CmdBuffer::EndRenderPass()
 {
     DbgBarrierPreCmd(DbgBarrierEndRenderPass);
 
+    FlushDeferredBarriers();
+
     if (m_renderPassInstance.subpass != VK_SUBPASS_EXTERNAL)
     {
         // Close the previous subpass
@@ -5222,6 +5787,7 @@ void CmdBuffer::SetViewport(
 
     m_state.allGpuState.dirty.viewport         = 1;
     m_state.allGpuState.staticTokens.viewports = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline     = nullptr;
 }
 
 // =====================================================================================================================
@@ -5262,6 +5828,7 @@ void CmdBuffer::SetAllViewports(
 
     m_state.allGpuState.dirty.viewport         = 1;
     m_state.allGpuState.staticTokens.viewports = staticToken;
+    m_state.allGpuState.pDeltaBasePipeline     = nullptr;
 }
 
 // =====================================================================================================================
@@ -5284,6 +5851,7 @@ void CmdBuffer::SetScissor(
 
     m_state.allGpuState.dirty.scissor            = 1;
     m_state.allGpuState.staticTokens.scissorRect = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline       = nullptr;
 }
 
 // =====================================================================================================================
@@ -5324,6 +5892,7 @@ void CmdBuffer::SetAllScissors(
 
     m_state.allGpuState.dirty.scissor            = 1;
     m_state.allGpuState.staticTokens.scissorRect = staticToken;
+    m_state.allGpuState.pDeltaBasePipeline       = nullptr;
 }
 
 // =====================================================================================================================
@@ -5349,6 +5918,7 @@ void CmdBuffer::SetLineWidth(
     while (deviceGroup.IterateNext());
 
     m_state.allGpuState.staticTokens.pointLineRasterState = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
 
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
@@ -5372,6 +5942,7 @@ void CmdBuffer::SetDepthBias(
     while (deviceGroup.IterateNext());
 
     m_state.allGpuState.staticTokens.depthBiasState = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
 
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
@@ -5393,6 +5964,7 @@ void CmdBuffer::SetBlendConstants(
     while (deviceGroup.IterateNext());
 
     m_state.allGpuState.staticTokens.blendConst = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
 
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
@@ -5415,6 +5987,7 @@ void CmdBuffer::SetDepthBounds(
     while (deviceGroup.IterateNext());
 
     m_state.allGpuState.staticTokens.depthBounds = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
 
     DbgBarrierPostCmd(DbgBarrierSetDynamicPipelineState);
 }
@@ -5556,6 +6129,8 @@ void CmdBuffer::WriteBufferMarker(
     VkDeviceSize            dstOffset,
     uint32_t                marker)
 {
+    FlushDeferredBarriers();
+
     const Buffer* pDestBuffer        = Buffer::ObjectFromHandle(dstBuffer);
     const Pal::HwPipePoint pipePoint = VkToPalSrcPipePointForMarkers(pipelineStage, m_palEngineType);
 
@@ -5650,6 +6225,8 @@ void CmdBuffer::BeginTransformFeedback(
     const VkBuffer*     pCounterBuffers,
     const VkDeviceSize* pCounterBufferOffsets)
 {
+    FlushDeferredBarriers();
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     if (m_pTransformFeedbackState != nullptr)
     {
@@ -5699,6 +6276,8 @@ void CmdBuffer::EndTransformFeedback(
     const VkBuffer*     pCounterBuffers,
     const VkDeviceSize* pCounterBufferOffsets)
 {
+    FlushDeferredBarriers();
+
     if ((m_pTransformFeedbackState != nullptr) && (m_pTransformFeedbackState->enabled))
     {
         utils::IterateMask deviceGroup(m_curDeviceMask);
@@ -5750,6 +6329,8 @@ void CmdBuffer::DrawIndirectByteCount(
     uint32_t        counterOffset,
     uint32_t        vertexStride)
 {
+    FlushDeferredBarriers();
+
     Buffer* pCounterBuffer = Buffer::ObjectFromHandle(counterBuffer);
 
     ValidateStates();
@@ -5786,6 +6367,7 @@ void CmdBuffer::SetLineStippleEXT(
     while (deviceGroup.IterateNext());
 
     m_state.allGpuState.staticTokens.lineStippleState = staticToken;
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
 }
 
 // =====================================================================================================================
@@ -5807,12 +6389,15 @@ void CmdBuffer::SetLineStippleEXT(
     while (deviceGroup.IterateNext());
 
     m_state.allGpuState.staticTokens.lineStippleState = DynamicRenderStateToken;
+    m_state.allGpuState.pDeltaBasePipeline = nullptr;
 }
 
 // =====================================================================================================================
 void CmdBuffer::CmdBeginConditionalRendering(
     const VkConditionalRenderingBeginInfoEXT* pConditionalRenderingBegin)
 {
+    FlushDeferredBarriers();
+
     // Make sure we have a properly aligned buffer offset.
     VK_ASSERT(Util::IsPow2Aligned(pConditionalRenderingBegin->offset, 4));
 
@@ -5846,6 +6431,8 @@ void CmdBuffer::CmdBeginConditionalRendering(
 // =====================================================================================================================
 void CmdBuffer::CmdEndConditionalRendering()
 {
+    FlushDeferredBarriers();
+
     utils::IterateMask deviceGroup(m_curDeviceMask);
     do
     {
@@ -98,6 +98,7 @@ void ComputePipeline::ConvertComputePipelineInfo(
 ComputePipeline::ComputePipeline(
     Device* const                        pDevice,
     Pal::IPipeline**                     pPalPipeline,
+    SharedPalPipeline*                   pSharedPalPipeline,
     const PipelineLayout*                pPipelineLayout,
     PipelineBinaryInfo*                  pPipelineBinary,
     const ImmedInfo&                     immedInfo,
@@ -107,7 +108,7 @@ ComputePipeline::ComputePipeline(
     Pipeline(pDevice),
     m_info(immedInfo)
 {
-    Pipeline::Init(pPalPipeline, pPipelineLayout, pPipelineBinary, staticStateMask, apiHash);
+    Pipeline::Init(pPalPipeline, pSharedPalPipeline, pPipelineLayout, pPipelineBinary, staticStateMask, apiHash);
 
     CreateStaticState();
 }
@@ -153,13 +154,27 @@ VkResult ComputePipeline::Create(
     Util::MetroHash::Hash     cacheId[MaxPalDevices]             = {};
     PipelineCompiler*         pDefaultCompiler                   = pDevice->GetCompiler(DefaultDeviceIndex);
     ComputePipelineCreateInfo binaryCreateInfo                   = {};
-    uint64_t                  apiPsoHash                         = BuildApiHash(pCreateInfo, &binaryCreateInfo.basePipelineHash);
+    PipelineCreationProfiler* pProfiler                          = pDevice->GetPipelineCreationProfiler();
+    PipelineCreationTimes*    pCreationTimes                     = &binaryCreateInfo.creationTimes;
+
+    int64_t  phaseStart = pProfiler->StartPhase();
+    uint64_t apiPsoHash = BuildApiHash(pCreateInfo, &binaryCreateInfo.basePipelineHash);
+    pProfiler->EndPhase(PipelineCreationPhase::Hash, phaseStart, pCreationTimes);
 
     const VkPipelineCreationFeedbackCreateInfoEXT* pPipelineCreationFeadbackCreateInfo = nullptr;
+
+    phaseStart = pProfiler->StartPhase();
     VkResult result = pDefaultCompiler->ConvertComputePipelineInfo(
         pDevice, pCreateInfo, &binaryCreateInfo, &pPipelineCreationFeadbackCreateInfo);
+    pProfiler->EndPhase(PipelineCreationPhase::Convert, phaseStart, pCreationTimes);
 
+    phaseStart = pProfiler->StartPhase();
     uint64_t pipelineHash = Vkgc::IPipelineDumper::GetPipelineHash(&binaryCreateInfo.pipelineInfo);
+    pProfiler->EndPhase(PipelineCreationPhase::Hash, phaseStart, pCreationTimes);
+
+    // Let the compiler reuse the pipeline hash instead of computing it again
+    binaryCreateInfo.pipelineHash = pipelineHash;
+
     for (uint32_t deviceIdx = 0; (result == VK_SUCCESS) && (deviceIdx < pDevice->NumPalDevices()); deviceIdx++)
     {
         result = pDevice->GetCompiler(deviceIdx)->CreateComputePipelineBinary(
@@ -181,7 +196,9 @@ VkResult ComputePipeline::Create(
 
     if (result == VK_SUCCESS)
     {
+        phaseStart = pProfiler->StartPhase();
         ConvertComputePipelineInfo(pDevice, pCreateInfo, &localPipelineInfo);
+        pProfiler->EndPhase(PipelineCreationPhase::Convert, phaseStart, pCreationTimes);
 
         // Override pipeline creation parameters based on pipeline profile
         pDevice->GetShaderOptimizer()->OverrideComputePipelineCreateInfo(
@@ -189,39 +206,97 @@ VkResult ComputePipeline::Create(
             nullptr);
     }
 
+    // Look for PAL pipelines created from the same binaries by an earlier pipeline
+    PalPipelineTable*  pPipelineTable  = pDevice->GetPalPipelineTable();
+    SharedPalPipeline* pSharedPipeline = nullptr;
+    bool               createPalObject = true;
+
+    Util::MetroHash::Hash palPipelineKey = {};
+
+    if ((result == VK_SUCCESS) && pPipelineTable->IsEnabled())
+    {
+        Util::MetroHash128 keyHasher;
+
+        keyHasher.Update(localPipelineInfo.pipeline);
+
+        pPipelineTable->BuildKey(&keyHasher, cacheId, pipelineBinarySizes, pPipelineBinaries, &palPipelineKey);
+
+        pSharedPipeline = pPipelineTable->Find(palPipelineKey);
+        createPalObject = (pSharedPipeline == nullptr);
+    }
+
     // Get the pipeline and shader size from PAL and allocate memory.
     size_t pipelineSize = 0;
     void*  pSystemMem   = nullptr;
+    void*  pPalMem      = nullptr;
 
     Pal::Result palResult = Pal::Result::Success;
 
     if (result == VK_SUCCESS)
     {
-        localPipelineInfo.pipeline.pipelineBinarySize = pipelineBinarySizes[DefaultDeviceIndex];
-        localPipelineInfo.pipeline.pPipelineBinary    = pPipelineBinaries[DefaultDeviceIndex];
+        size_t palMemSize = 0;
 
-        pipelineSize =
-            pDevice->PalDevice(DefaultDeviceIndex)->GetComputePipelineSize(localPipelineInfo.pipeline, &palResult);
-        VK_ASSERT(palResult == Pal::Result::Success);
+        if (createPalObject)
+        {
+            localPipelineInfo.pipeline.pipelineBinarySize = pipelineBinarySizes[DefaultDeviceIndex];
+            localPipelineInfo.pipeline.pPipelineBinary    = pPipelineBinaries[DefaultDeviceIndex];
 
-        pSystemMem = pAllocator->pfnAllocation(
-            pAllocator->pUserData,
-            sizeof(ComputePipeline) + (pipelineSize * pDevice->NumPalDevices()),
-            VK_DEFAULT_MEM_ALIGN,
-            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            pipelineSize =
+                pDevice->PalDevice(DefaultDeviceIndex)->GetComputePipelineSize(localPipelineInfo.pipeline, &palResult);
+            VK_ASSERT(palResult == Pal::Result::Success);
 
-        if (pSystemMem == nullptr)
+            // Shared PAL objects live in their table entry instead of in the pipeline
+            if (pPipelineTable->IsEnabled())
+            {
+                pSharedPipeline = pPipelineTable->AllocPipeline(palPipelineKey, pipelineSize);
+
+                if (pSharedPipeline != nullptr)
+                {
+                    pPalMem = pSharedPipeline->pPalMemory;
+                }
+                else
+                {
+                    result = VK_ERROR_OUT_OF_HOST_MEMORY;
+                }
+            }
+            else
+            {
+                palMemSize = pipelineSize * pDevice->NumPalDevices();
+            }
+        }
+
+        if (result == VK_SUCCESS)
         {
-            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+            pSystemMem = pAllocator->pfnAllocation(
+                pAllocator->pUserData,
+                sizeof(ComputePipeline) + palMemSize,
+                VK_DEFAULT_MEM_ALIGN,
+                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+            if (pSystemMem == nullptr)
+            {
+                result = VK_ERROR_OUT_OF_HOST_MEMORY;
+            }
+            else if (pPalMem == nullptr)
+            {
+                pPalMem = Util::VoidPtrInc(pSystemMem, sizeof(ComputePipeline));
+            }
         }
     }
 
     // Create the PAL pipeline object.
     Pal::IPipeline* pPalPipeline[MaxPalDevices] = {};
 
-    if (result == VK_SUCCESS)
+    if ((result == VK_SUCCESS) && (createPalObject == false))
     {
-        void* pPalMem = Util::VoidPtrInc(pSystemMem, sizeof(ComputePipeline));
+        for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
+        {
+            pPalPipeline[deviceIdx] = pSharedPipeline->pPipelines[deviceIdx];
+        }
+    }
+    else if (result == VK_SUCCESS)
+    {
+        phaseStart = pProfiler->StartPhase();
 
         for (uint32_t deviceIdx = 0;
             ((deviceIdx < pDevice->NumPalDevices()) && (palResult == Pal::Result::Success));
@@ -277,6 +352,27 @@ VkResult ComputePipeline::Create(
 #endif
         }
 
+        pProfiler->EndPhase(PipelineCreationPhase::CreatePalPipeline, phaseStart, pCreationTimes);
+
+        if (pSharedPipeline != nullptr)
+        {
+            // The entry now owns whatever PAL objects were created
+            for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
+            {
+                pSharedPipeline->pPipelines[deviceIdx] = pPalPipeline[deviceIdx];
+            }
+
+            if (palResult == Pal::Result::Success)
+            {
+                pSharedPipeline = pPipelineTable->Insert(pSharedPipeline);
+
+                for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
+                {
+                    pPalPipeline[deviceIdx] = pSharedPipeline->pPipelines[deviceIdx];
+                }
+            }
+        }
+
         result = PalToVkResult(palResult);
     }
 
@@ -298,6 +394,7 @@ VkResult ComputePipeline::Create(
         // On success, wrap it up in a Vulkan object and return.
         VK_PLACEMENT_NEW(pSystemMem) ComputePipeline(pDevice,
                                                      pPalPipeline,
+                                                     pSharedPipeline,
                                                      localPipelineInfo.pLayout,
                                                      pBinary,
                                                      localPipelineInfo.immedInfo,
@@ -306,6 +403,10 @@ VkResult ComputePipeline::Create(
 
         *pPipeline = ComputePipeline::HandleFromVoidPointer(pSystemMem);
     }
+    else if (pSharedPipeline != nullptr)
+    {
+        pPipelineTable->Release(pSharedPipeline);
+    }
     else
     {
         for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
@@ -351,6 +452,9 @@ VkResult ComputePipeline::Create(
                 pPipelineCreationFeadbackCreateInfo,
                 &binaryCreateInfo.pipelineFeedback);
 
+        pCreationTimes->Add(PipelineCreationPhase::Total, duration);
+        pProfiler->Record(*pCreationTimes);
+
         const RuntimeSettings& settings = pDevice->GetRuntimeSettings();
         // The hash is same as pipline dump file name, we can easily analyze further.
         AmdvlkLog(settings.logTagIdMask, PipelineCompileTime, "0x%016llX-%llu", pipelineHash, duration);
@@ -95,7 +95,8 @@ VkResult DescriptorPool::Create(
 DescriptorPool::DescriptorPool(
     Device* pDevice)
     :
-    m_pDevice(pDevice)
+    m_pDevice(pDevice),
+    m_pStagingMem(nullptr)
 {
     memset(m_addresses, 0, sizeof(m_addresses));
 }
@@ -162,6 +163,11 @@ VkResult DescriptorPool::Init(
                     m_addresses[deviceIdx].fmaskCpuAddr = static_cast<uint32_t*>(m_gpuMemHeap.CpuShadowAddr(deviceIdx));
                 }
             }
+
+            if (m_pDevice->GetRuntimeSettings().enableDescriptorWriteStaging)
+            {
+                result = InitStagingMemory<numPalDevices>(static_cast<size_t>(memReqs.size));
+            }
         }
     }
 
@@ -219,6 +225,53 @@ VkResult DescriptorPool::Init(
     return result;
 }
 
+// =====================================================================================================================
+// Allocates a cacheable system memory copy of the pool's descriptor memory.  Descriptor sets then write to and read
+// from that copy, and updated ranges are copied to the write-combined GPU memory in one go after each update call
+// (see DescriptorSet::FlushStaging()).
+template <uint32_t numPalDevices>
+VkResult DescriptorPool::InitStagingMemory(
+    size_t gpuMemSize)
+{
+    VkResult     result        = VK_SUCCESS;
+    const bool   stageFmask    = (m_addresses[0].fmaskCpuAddr != nullptr);
+    const size_t perDeviceSize = gpuMemSize * (stageFmask ? 2 : 1);
+
+    m_pStagingMem = m_pDevice->VkInstance()->AllocMem(
+        perDeviceSize * numPalDevices,
+        VK_DEFAULT_MEM_ALIGN,
+        VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    if (m_pStagingMem != nullptr)
+    {
+        // Update templates flush the whole range between their first and last entry, so bytes no descriptor was ever
+        // written to are copied to GPU memory as well.  Starting out zeroed, the staging copy only ever holds zeros
+        // or what has already been copied to GPU memory, which is why it need not be cleared when the pool is reset.
+        memset(m_pStagingMem, 0, perDeviceSize * numPalDevices);
+
+        for (uint32_t deviceIdx = 0; deviceIdx < numPalDevices; deviceIdx++)
+        {
+            void* pDeviceStagingMem = Util::VoidPtrInc(m_pStagingMem, perDeviceSize * deviceIdx);
+
+            m_addresses[deviceIdx].staticMappedAddr = m_addresses[deviceIdx].staticCpuAddr;
+            m_addresses[deviceIdx].staticCpuAddr    = static_cast<uint32_t*>(pDeviceStagingMem);
+
+            if (stageFmask)
+            {
+                m_addresses[deviceIdx].fmaskMappedAddr = m_addresses[deviceIdx].fmaskCpuAddr;
+                m_addresses[deviceIdx].fmaskCpuAddr    =
+                    static_cast<uint32_t*>(Util::VoidPtrInc(pDeviceStagingMem, gpuMemSize));
+            }
+        }
+    }
+    else
+    {
+        result = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Resets the entire descriptor pool.  All storage becomes free for allocation and all previously allocated descriptor
 // sets become invalid.
@@ -255,6 +308,11 @@ VkResult DescriptorPool::Destroy(
         pDevice->MemMgr()->FreeGpuMem(&m_staticInternalMem);
     }
 
+    if (m_pStagingMem != nullptr)
+    {
+        pDevice->VkInstance()->FreeMem(m_pStagingMem);
+    }
+
     // Call destructor
     this->~DescriptorPool();
 
@@ -391,6 +449,7 @@ m_pDynamicAllocBlocks(nullptr),
 m_dynamicAllocBlockCount(0),
 m_pDynamicAllocBlockIndexStack(nullptr),
 m_dynamicAllocBlockIndexStackCount(0),
+m_dynamicAllocBlockHighWaterMark(0),
 m_gpuMemSize(0),
 m_gpuMemAddrAlignment(0),
 m_numPalDevices(0)
@@ -450,14 +509,12 @@ VkResult DescriptorGpuMemHeap::Init(
         m_dynamicAllocBlockFreeListHeader.pPrev     = nullptr;
         m_dynamicAllocBlockFreeListHeader.pNext     = nullptr;
 
+        // Block structures are handed out lazily (see AcquireDynamicAllocBlockIndex()), so neither the block storage
+        // nor the index stack needs to be initialized here.
         m_pDynamicAllocBlocks               = reinterpret_cast<DynamicAllocBlock*>(pMemory);
         m_pDynamicAllocBlockIndexStack      = reinterpret_cast<uint32_t*>(Util::VoidPtrInc(pMemory, blockStorageSize));
-        m_dynamicAllocBlockIndexStackCount  = m_dynamicAllocBlockCount;
-
-        for (uint32_t i = 0; i < m_dynamicAllocBlockIndexStackCount; ++i)
-        {
-            m_pDynamicAllocBlockIndexStack[i] = i;
-        }
+        m_dynamicAllocBlockIndexStackCount  = 0;
+        m_dynamicAllocBlockHighWaterMark    = 0;
     }
 
     return VK_SUCCESS;
@@ -510,9 +567,10 @@ void DescriptorGpuMemHeap::SanityCheckDynamicAllocBlockList()
         pBlock = pBlock->pNextFree;
     }
 
-    // Find the first node in the complete block list.
+    // Find the first node in the complete block list.  Block structures past the high-water mark have not been used
+    // since the last reset and may contain stale data.
     pBlock = nullptr;
-    for (uint32_t i = 0; i < m_dynamicAllocBlockCount; ++i)
+    for (uint32_t i = 0; i < m_dynamicAllocBlockHighWaterMark; ++i)
     {
         if (m_pDynamicAllocBlocks[i].pPrev == nullptr)
         {
@@ -648,8 +706,7 @@ bool DescriptorGpuMemHeap::AllocSetGpuMem(
                     else
                     // Otherwise create a new free block for the remaining range.
                     {
-                        VK_ASSERT(m_dynamicAllocBlockIndexStackCount > 0);
-                        uint32_t newBlockIndex = m_pDynamicAllocBlockIndexStack[--m_dynamicAllocBlockIndexStackCount];
+                        uint32_t newBlockIndex = AcquireDynamicAllocBlockIndex();
 
                         DynamicAllocBlock* pNewBlock      = &m_pDynamicAllocBlocks[newBlockIndex];
                         pNewBlock->pPrevFree              = pBlock;
@@ -883,17 +940,14 @@ void DescriptorGpuMemHeap::Reset()
         VK_ASSERT(m_pDynamicAllocBlocks != nullptr);
         VK_ASSERT(m_pDynamicAllocBlockIndexStack != nullptr);
 
-        // For dynamic allocations the only thing we have to do is release all blocks by resetting the free index stack
-        // and then reinitializing the free block list with a single entry covering the entire range.
+        // For dynamic allocations the only thing we have to do is release all blocks by emptying the free index stack
+        // and rewinding the high-water mark, and then reinitializing the free block list with a single entry covering
+        // the entire range.  This is constant time regardless of maxSets or of how many sets were allocated.
 
-        m_dynamicAllocBlockIndexStackCount = m_dynamicAllocBlockCount;
+        m_dynamicAllocBlockIndexStackCount = 0;
+        m_dynamicAllocBlockHighWaterMark   = 0;
 
-        for (uint32_t i = 0; i < m_dynamicAllocBlockIndexStackCount; ++i)
-        {
-            m_pDynamicAllocBlockIndexStack[i] = i;
-        }
-
-        uint32_t blockIndex = m_pDynamicAllocBlockIndexStack[--m_dynamicAllocBlockIndexStackCount];
+        uint32_t blockIndex = AcquireDynamicAllocBlockIndex();
 
         DynamicAllocBlock* pBlock      = &m_pDynamicAllocBlocks[blockIndex];
         pBlock->pPrevFree              = &m_dynamicAllocBlockFreeListHeader;
@@ -1048,6 +1102,10 @@ void DescriptorSetHeap::FreeSetState(
 template <uint32_t numPalDevices>
 void DescriptorSetHeap::Reset()
 {
+#if DEBUG
+    const uint32_t highWaterMark = m_nextFreeHandle;
+#endif
+
     // Reset the next free index to the start of all handles
     m_nextFreeHandle = 0;
 
@@ -1055,10 +1113,11 @@ void DescriptorSetHeap::Reset()
     m_freeIndexStackCount = 0;
 
 #if DEBUG
-    // Clear the descriptor set states for debugging purposes
+    // Clear the descriptor set states for debugging purposes.  Only sets below the previous high-water mark can have
+    // been handed out since the last reset.
     size_t setSize = SetSize<numPalDevices>();
 
-    for (uint32_t index = 0; index < m_maxSets; ++index)
+    for (uint32_t index = 0; index < highWaterMark; ++index)
     {
         VkDescriptorSet setHandle =
             DescriptorSet<numPalDevices>::HandleFromVoidPointer(Util::VoidPtrInc(m_pSetMemory, index * setSize));
@@ -49,7 +49,9 @@ DescriptorSet<numPalDevices>::DescriptorSet(
     :
     m_pLayout(nullptr),
     m_pAllocHandle(nullptr),
-    m_heapIndex(heapIndex)
+    m_heapIndex(heapIndex),
+    m_stagingDirtyDwBegin(UINT32_MAX),
+    m_stagingDirtyDwEnd(0)
 {
     memset(m_addresses, 0, sizeof(m_addresses));
 }
@@ -85,8 +87,22 @@ void DescriptorSet<numPalDevices>::Reassign(
             m_addresses[deviceIdx].fmaskCpuAddr = static_cast<uint32_t*>(Util::VoidPtrInc(pBaseAddrs[deviceIdx].fmaskCpuAddr, static_cast<intptr_t>(gpuMemOffset)));
             VK_ASSERT(Util::IsPow2Aligned(reinterpret_cast<uint64_t>(m_addresses[deviceIdx].fmaskCpuAddr), sizeof(uint32_t)));
         }
+
+        // If the pool stages descriptor writes, the CPU addresses above point into the staging copy and the mapped
+        // GPU memory is only written by FlushStaging().
+        if (pBaseAddrs[deviceIdx].staticMappedAddr != nullptr)
+        {
+            m_addresses[deviceIdx].staticMappedAddr = static_cast<uint32_t*>(Util::VoidPtrInc(pBaseAddrs[deviceIdx].staticMappedAddr, static_cast<intptr_t>(gpuMemOffset)));
+
+            if (pBaseAddrs[deviceIdx].fmaskMappedAddr != nullptr)
+            {
+                m_addresses[deviceIdx].fmaskMappedAddr = static_cast<uint32_t*>(Util::VoidPtrInc(pBaseAddrs[deviceIdx].fmaskMappedAddr, static_cast<intptr_t>(gpuMemOffset)));
+            }
+        }
     }
 
+    m_stagingDirtyDwBegin = UINT32_MAX;
+    m_stagingDirtyDwEnd   = 0;
 }
 
 // =====================================================================================================================
@@ -98,6 +114,49 @@ void DescriptorSet<numPalDevices>::Reset()
     m_pAllocHandle = nullptr;
 
     memset(m_addresses, 0, sizeof(m_addresses));
+
+    m_stagingDirtyDwBegin = UINT32_MAX;
+    m_stagingDirtyDwEnd   = 0;
+}
+
+// =====================================================================================================================
+// Copies the dirty range of a staged descriptor set to GPU memory and clears the dirty range.
+template <uint32_t numPalDevices>
+void DescriptorSet<numPalDevices>::FlushStaging()
+{
+    if (m_stagingDirtyDwEnd > m_stagingDirtyDwBegin)
+    {
+        FlushStagedRange(m_stagingDirtyDwBegin, m_stagingDirtyDwEnd - m_stagingDirtyDwBegin);
+
+        m_stagingDirtyDwBegin = UINT32_MAX;
+        m_stagingDirtyDwEnd   = 0;
+    }
+}
+
+// =====================================================================================================================
+// Copies a dword range of a staged descriptor set to GPU memory.  The range is written front to back with a single
+// copy per device so that the write-combined destination only sees full, sequential writes.
+template <uint32_t numPalDevices>
+void DescriptorSet<numPalDevices>::FlushStagedRange(
+    uint32_t dwOffset,
+    uint32_t dwCount)
+{
+    const size_t byteSize = dwCount * sizeof(uint32_t);
+
+    for (uint32_t deviceIdx = 0; deviceIdx < numPalDevices; deviceIdx++)
+    {
+        const DescriptorAddr& addr = m_addresses[deviceIdx];
+
+        if (addr.staticMappedAddr != nullptr)
+        {
+            memcpy(addr.staticMappedAddr + dwOffset, addr.staticCpuAddr + dwOffset, byteSize);
+
+            if (addr.fmaskMappedAddr != nullptr)
+            {
+                memcpy(addr.fmaskMappedAddr + dwOffset, addr.fmaskCpuAddr + dwOffset, byteSize);
+            }
+        }
+    }
 }
 
 // =====================================================================================================================
@@ -749,6 +808,102 @@ VKAPI_ATTR void VKAPI_CALL DescriptorUpdate::UpdateDescriptorSets(
                            descriptorCopyCount,
                            pDescriptorCopies);
     }
+
+    if (pDevice->GetRuntimeSettings().enableDescriptorWriteStaging)
+    {
+        FlushStagedDescriptorSets<numPalDevices>(
+            descriptorWriteCount,
+            pDescriptorWrites,
+            descriptorCopyCount,
+            pDescriptorCopies);
+    }
+}
+
+// =====================================================================================================================
+// Returns the dword range of a binding's static section touched by a write or copy of the given descriptors.  Dynamic
+// buffer descriptors live in client memory and touch no GPU memory.
+static void GetStaticDwRange(
+    const DescriptorSetLayout*              pLayout,
+    const DescriptorSetLayout::BindingInfo& binding,
+    uint32_t                                arrayElement,
+    uint32_t                                descriptorCount,
+    uint32_t*                               pDwOffset,
+    uint32_t*                               pDwCount)
+{
+    switch (static_cast<uint32_t>(binding.info.descriptorType))
+    {
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+        *pDwOffset = 0;
+        *pDwCount  = 0;
+        break;
+
+    case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+        // The array element and count are given in bytes
+        *pDwOffset = binding.sta.dwOffset + (arrayElement / 4);
+        *pDwCount  = Util::Pow2Align(descriptorCount, 4) / 4;
+        break;
+
+    default:
+        *pDwOffset = static_cast<uint32_t>(pLayout->GetDstStaOffset(binding, arrayElement));
+        *pDwCount  = descriptorCount * binding.sta.dwArrayStride;
+        break;
+    }
+}
+
+// =====================================================================================================================
+// Copies the staged contents of every descriptor set written by an update call to GPU memory.  All ranges of a set are
+// merged first so that each set is flushed with a single contiguous copy.
+template <uint32_t numPalDevices>
+void DescriptorUpdate::FlushStagedDescriptorSets(
+    uint32_t                     descriptorWriteCount,
+    const VkWriteDescriptorSet*  pDescriptorWrites,
+    uint32_t                     descriptorCopyCount,
+    const VkCopyDescriptorSet*   pDescriptorCopies)
+{
+    uint32_t dwOffset;
+    uint32_t dwCount;
+
+    for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+    {
+        const VkWriteDescriptorSet&   params   = pDescriptorWrites[i];
+        DescriptorSet<numPalDevices>* pDestSet = DescriptorSet<numPalDevices>::ObjectFromHandle(params.dstSet);
+
+        GetStaticDwRange(pDestSet->Layout(),
+                         pDestSet->Layout()->Binding(params.dstBinding),
+                         params.dstArrayElement,
+                         params.descriptorCount,
+                         &dwOffset,
+                         &dwCount);
+
+        pDestSet->MarkStagingDirty(dwOffset, dwCount);
+    }
+
+    for (uint32_t i = 0; i < descriptorCopyCount; ++i)
+    {
+        const VkCopyDescriptorSet&    params   = pDescriptorCopies[i];
+        DescriptorSet<numPalDevices>* pDestSet = DescriptorSet<numPalDevices>::ObjectFromHandle(params.dstSet);
+
+        GetStaticDwRange(pDestSet->Layout(),
+                         pDestSet->Layout()->Binding(params.dstBinding),
+                         params.dstArrayElement,
+                         params.descriptorCount,
+                         &dwOffset,
+                         &dwCount);
+
+        pDestSet->MarkStagingDirty(dwOffset, dwCount);
+    }
+
+    // Flushing clears the dirty range, so sets referenced by several writes are only copied once.
+    for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+    {
+        DescriptorSet<numPalDevices>::ObjectFromHandle(pDescriptorWrites[i].dstSet)->FlushStaging();
+    }
+
+    for (uint32_t i = 0; i < descriptorCopyCount; ++i)
+    {
+        DescriptorSet<numPalDevices>::ObjectFromHandle(pDescriptorCopies[i].dstSet)->FlushStaging();
+    }
 }
 
 // =====================================================================================================================
@@ -964,6 +1119,12 @@ void DescriptorSet<1>::Reassign(
 template
 void DescriptorSet<1>::Reset();
 
+template
+void DescriptorSet<1>::FlushStaging();
+
+template
+void DescriptorSet<1>::FlushStagedRange(uint32_t dwOffset, uint32_t dwCount);
+
 template
 DescriptorSet<2>::DescriptorSet(uint32_t heapIndex);
 
@@ -977,6 +1138,12 @@ void DescriptorSet<2>::Reassign(
 template
 void DescriptorSet<2>::Reset();
 
+template
+void DescriptorSet<2>::FlushStaging();
+
+template
+void DescriptorSet<2>::FlushStagedRange(uint32_t dwOffset, uint32_t dwCount);
+
 template
 DescriptorSet<3>::DescriptorSet(uint32_t heapIndex);
 
@@ -990,6 +1157,12 @@ void DescriptorSet<3>::Reassign(
 template
 void DescriptorSet<3>::Reset();
 
+template
+void DescriptorSet<3>::FlushStaging();
+
+template
+void DescriptorSet<3>::FlushStagedRange(uint32_t dwOffset, uint32_t dwCount);
+
 template
 DescriptorSet<4>::DescriptorSet(uint32_t heapIndex);
 
@@ -1003,4 +1176,10 @@ void DescriptorSet<4>::Reassign(
 template
 void DescriptorSet<4>::Reset();
 
+template
+void DescriptorSet<4>::FlushStaging();
+
+template
+void DescriptorSet<4>::FlushStagedRange(uint32_t dwOffset, uint32_t dwCount);
+
 } // namespace vk
@@ -36,6 +36,7 @@
 #include "include/vk_device.h"
 #include "include/vk_sampler.h"
 
+#include "palHashMapImpl.h"
 #include "palMetroHash.h"
 
 namespace vk
@@ -127,7 +128,9 @@ DescriptorSetLayout::DescriptorSetLayout(
     uint64_t          apiHash) :
     m_info(info),
     m_pDevice(pDevice),
-    m_apiHash(apiHash)
+    m_apiHash(apiHash),
+    m_refCount(1),
+    m_interned(false)
 {
 
 }
@@ -617,13 +620,73 @@ VkResult DescriptorSetLayout::Create(
         return result;
     }
 
-    VK_PLACEMENT_NEW (pSysMem) DescriptorSetLayout (pDevice, info, apiHash);
+    DescriptorSetLayout* pObject = VK_PLACEMENT_NEW (pSysMem) DescriptorSetLayout (pDevice, info, apiHash);
 
-    *pLayout = DescriptorSetLayout::HandleFromVoidPointer(pSysMem);
+    // Only layouts allocated through the instance allocator can be shared: a layout created with application
+    // callbacks must be freed through those same callbacks when its handle is destroyed.
+    if (pDevice->GetRuntimeSettings().optDedupDescriptorSetLayouts &&
+        (pAllocator == pDevice->VkInstance()->GetAllocCallbacks()))
+    {
+        DescriptorSetLayout* pInterned = pDevice->GetDescriptorSetLayoutCache()->FindOrInsert(pObject);
+
+        if (pInterned != pObject)
+        {
+            // An identical layout already exists.  Drop the one we just built and hand out another reference.
+            pObject->Destroy(pDevice, pAllocator, true);
+
+            pObject = pInterned;
+        }
+    }
+
+    *pLayout = DescriptorSetLayout::HandleFromObject(pObject);
 
     return result;
 }
 
+// =====================================================================================================================
+// Returns true if the two layouts are interchangeable, i.e. they produce identical bindings and immutable sampler data.
+bool DescriptorSetLayout::IsEqual(
+    const DescriptorSetLayout& other) const
+{
+    bool isEqual = (m_apiHash                            == other.m_apiHash) &&
+                   (m_info.count                         == other.m_info.count) &&
+                   (m_info.activeStageMask               == other.m_info.activeStageMask) &&
+                   (m_info.numDynamicDescriptors         == other.m_info.numDynamicDescriptors) &&
+                   (m_info.sta.dwSize                    == other.m_info.sta.dwSize) &&
+                   (m_info.sta.numRsrcMapNodes           == other.m_info.sta.numRsrcMapNodes) &&
+                   (m_info.dyn.dwSize                    == other.m_info.dyn.dwSize) &&
+                   (m_info.dyn.numRsrcMapNodes           == other.m_info.dyn.numRsrcMapNodes) &&
+                   (m_info.imm.numDescriptorValueNodes   == other.m_info.imm.numDescriptorValueNodes) &&
+                   (m_info.imm.numImmutableSamplers      == other.m_info.imm.numImmutableSamplers) &&
+                   (m_info.imm.numImmutableYCbCrMetaData == other.m_info.imm.numImmutableYCbCrMetaData) &&
+                   (m_info.varDescStride                 == other.m_info.varDescStride);
+
+    for (uint32_t i = 0; isEqual && (i < m_info.count); ++i)
+    {
+        const BindingInfo& lhs = Binding(i);
+        const BindingInfo& rhs = other.Binding(i);
+
+        // The immutable sampler pointer is application memory that is only valid during creation and is not compared.
+        isEqual = (lhs.info.binding         == rhs.info.binding)         &&
+                  (lhs.info.descriptorType  == rhs.info.descriptorType)  &&
+                  (lhs.info.descriptorCount == rhs.info.descriptorCount) &&
+                  (lhs.info.stageFlags      == rhs.info.stageFlags)      &&
+                  (lhs.bindingFlags         == rhs.bindingFlags)         &&
+                  (memcmp(&lhs.sta, &rhs.sta, sizeof(BindingSectionInfo)) == 0) &&
+                  (memcmp(&lhs.dyn, &rhs.dyn, sizeof(BindingSectionInfo)) == 0) &&
+                  (memcmp(&lhs.imm, &rhs.imm, sizeof(BindingSectionInfo)) == 0);
+    }
+
+    if (isEqual)
+    {
+        isEqual = (memcmp(m_info.imm.pImmutableSamplerData,
+                          other.m_info.imm.pImmutableSamplerData,
+                          GetImmSamplerArrayByteSize() + GetImmYCbCrMetaDataArrayByteSize()) == 0);
+    }
+
+    return isEqual;
+}
+
 // =====================================================================================================================
 // Copy descriptor set layout object
 void DescriptorSetLayout::Copy(
@@ -673,6 +736,12 @@ VkResult DescriptorSetLayout::Destroy(
     const VkAllocationCallbacks*    pAllocator,
     bool                            freeMemory)
 {
+    // An interned layout stays alive until the last handle referring to it is destroyed.
+    if (m_interned && (pDevice->GetDescriptorSetLayoutCache()->Release(this) == false))
+    {
+        return VK_SUCCESS;
+    }
+
     this->~DescriptorSetLayout();
 
     if (freeMemory)
@@ -683,6 +752,93 @@ VkResult DescriptorSetLayout::Destroy(
     return VK_SUCCESS;
 }
 
+// =====================================================================================================================
+DescriptorSetLayoutCache::DescriptorSetLayoutCache(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_layouts(NumLayoutBuckets, pDevice->VkInstance()->Allocator())
+{
+
+}
+
+// =====================================================================================================================
+// Initializes the descriptor set layout cache.  Should be called during device create.
+VkResult DescriptorSetLayoutCache::Init()
+{
+    Pal::Result result = m_mutex.Init();
+
+    if (result == Pal::Result::Success)
+    {
+        result = m_layouts.Init();
+    }
+
+    return PalToVkResult(result);
+}
+
+// =====================================================================================================================
+// Looks up a layout identical to the given newly created one.  If found, a reference to the existing layout is taken
+// and it is returned; the caller is then responsible for destroying the new layout.  Otherwise the new layout is
+// interned (when possible) and returned unchanged.
+DescriptorSetLayout* DescriptorSetLayoutCache::FindOrInsert(
+    DescriptorSetLayout* pLayout)
+{
+    VK_ASSERT(pLayout->m_interned == false);
+
+    DescriptorSetLayout* pResult = pLayout;
+
+    Util::MutexAuto lock(&m_mutex);
+
+    bool                  existed = false;
+    DescriptorSetLayout** ppEntry = nullptr;
+
+    Pal::Result result = m_layouts.FindAllocate(pLayout->GetApiHash(), &existed, &ppEntry);
+
+    if (result == Pal::Result::Success)
+    {
+        if (existed == false)
+        {
+            *ppEntry = pLayout;
+
+            pLayout->m_interned = true;
+            pLayout->m_refCount = 1;
+        }
+        else if ((*ppEntry)->IsEqual(*pLayout) && ((*ppEntry)->m_refCount < UINT32_MAX))
+        {
+            (*ppEntry)->m_refCount++;
+
+            pResult = *ppEntry;
+        }
+        // On a hash collision with a different layout the new layout simply stays private.
+    }
+
+    return pResult;
+}
+
+// =====================================================================================================================
+// Drops one reference to an interned layout.  Returns true if that was the last reference, in which case the layout has
+// been removed from the table and must be destroyed by the caller.
+bool DescriptorSetLayoutCache::Release(
+    DescriptorSetLayout* pLayout)
+{
+    VK_ASSERT(pLayout->m_interned);
+
+    Util::MutexAuto lock(&m_mutex);
+
+    VK_ASSERT(pLayout->m_refCount > 0);
+
+    pLayout->m_refCount--;
+
+    const bool lastReference = (pLayout->m_refCount == 0);
+
+    if (lastReference)
+    {
+        m_layouts.Erase(pLayout->GetApiHash());
+    }
+
+    return lastReference;
+}
+
 namespace entry
 {
 
@@ -69,6 +69,10 @@ VkResult DescriptorUpdateTemplate::Create(
 
         TemplateUpdateInfo* pEntries = static_cast<TemplateUpdateInfo*>(Util::VoidPtrInc(pSysMem, apiSize));
 
+        PfnFlushStagedRange pfnFlushStagedRange = GetFlushStagedRangeFunc(pDevice);
+        uint32_t            stagingDwBegin      = UINT32_MAX;
+        uint32_t            stagingDwEnd        = 0;
+
         for (uint32_t ii = 0; ii < numEntries; ii++)
         {
             const VkDescriptorUpdateTemplateEntry&  srcEntry   = pCreateInfo->pDescriptorUpdateEntries[ii];
@@ -100,9 +104,39 @@ VkResult DescriptorUpdateTemplate::Create(
 
             pEntries[ii].pFunc                          =
                 GetUpdateEntryFunc(pDevice, srcEntry.descriptorType, dstBinding);
+
+            // Dynamic buffer descriptors are kept in client memory, everything else is written to the static section.
+            if ((pfnFlushStagedRange != nullptr)                                              &&
+                (dstBinding.info.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) &&
+                (dstBinding.info.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC))
+            {
+                const uint32_t dwCount =
+                    (dstBinding.info.descriptorType == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) ?
+                        (Util::Pow2Align(srcEntry.descriptorCount, 4) / 4) :
+                        (srcEntry.descriptorCount * dstBinding.sta.dwArrayStride);
+
+                if (dwCount > 0)
+                {
+                    const uint32_t dwOffset = static_cast<uint32_t>(pEntries[ii].dstStaOffset);
+
+                    stagingDwBegin = Util::Min(stagingDwBegin, dwOffset);
+                    stagingDwEnd   = Util::Max(stagingDwEnd, dwOffset + dwCount);
+                }
+            }
+        }
+
+        if (stagingDwEnd <= stagingDwBegin)
+        {
+            pfnFlushStagedRange = nullptr;
+            stagingDwBegin      = 0;
+            stagingDwEnd        = 0;
         }
 
-        VK_PLACEMENT_NEW(pSysMem) DescriptorUpdateTemplate(pCreateInfo->descriptorUpdateEntryCount);
+        VK_PLACEMENT_NEW(pSysMem) DescriptorUpdateTemplate(
+            pCreateInfo->descriptorUpdateEntryCount,
+            pfnFlushStagedRange,
+            stagingDwBegin,
+            stagingDwEnd - stagingDwBegin);
 
         *pDescriptorUpdateTemplate = DescriptorUpdateTemplate::HandleFromVoidPointer(pSysMem);
     }
@@ -266,11 +300,56 @@ DescriptorUpdateTemplate::PfnUpdateEntry DescriptorUpdateTemplate::GetUpdateEntr
     return pFunc;
 }
 
+// =====================================================================================================================
+// Returns the function used to flush staged descriptor writes to GPU memory, or null if writes are not staged.
+DescriptorUpdateTemplate::PfnFlushStagedRange DescriptorUpdateTemplate::GetFlushStagedRangeFunc(
+    const Device*                           pDevice)
+{
+    DescriptorUpdateTemplate::PfnFlushStagedRange pFunc = nullptr;
+
+    if (pDevice->GetRuntimeSettings().enableDescriptorWriteStaging)
+    {
+        switch (pDevice->NumPalDevices())
+        {
+            case 1:
+                pFunc = &DescriptorSet<1>::FlushStagedRangeFromHandle;
+                break;
+#if (VKI_BUILD_MAX_NUM_GPUS > 1)
+            case 2:
+                pFunc = &DescriptorSet<2>::FlushStagedRangeFromHandle;
+                break;
+#endif
+#if (VKI_BUILD_MAX_NUM_GPUS > 2)
+            case 3:
+                pFunc = &DescriptorSet<3>::FlushStagedRangeFromHandle;
+                break;
+#endif
+#if (VKI_BUILD_MAX_NUM_GPUS > 3)
+            case 4:
+                pFunc = &DescriptorSet<4>::FlushStagedRangeFromHandle;
+                break;
+#endif
+            default:
+                VK_NEVER_CALLED();
+                pFunc = nullptr;
+                break;
+        }
+    }
+
+    return pFunc;
+}
+
 // =====================================================================================================================
 DescriptorUpdateTemplate::DescriptorUpdateTemplate(
-    uint32_t                    numEntries)
+    uint32_t                    numEntries,
+    PfnFlushStagedRange         pfnFlushStagedRange,
+    uint32_t                    stagingDwOffset,
+    uint32_t                    stagingDwCount)
     :
-    m_numEntries(numEntries)
+    m_numEntries(numEntries),
+    m_pfnFlushStagedRange(pfnFlushStagedRange),
+    m_stagingDwOffset(stagingDwOffset),
+    m_stagingDwCount(stagingDwCount)
 {
 }
 
@@ -305,6 +384,11 @@ void DescriptorUpdateTemplate::Update(
 
         pEntries[i].pFunc(pDevice, descriptorSet, pDescriptorInfo, pEntries[i]);
     }
+
+    if (m_pfnFlushStagedRange != nullptr)
+    {
+        m_pfnFlushStagedRange(descriptorSet, m_stagingDwOffset, m_stagingDwCount);
+    }
 }
 
 // =====================================================================================================================
@@ -215,10 +215,17 @@ Device::Device(
     m_pInstance(pPhysicalDevices[DefaultDeviceIndex]->VkInstance()),
     m_settings(pPhysicalDevices[DefaultDeviceIndex]->GetRuntimeSettings()),
     m_palDeviceCount(palDeviceCount),
-    m_internalMemMgr(this, pPhysicalDevices[DefaultDeviceIndex]->VkInstance()),
+    m_internalMemMgr(this, pPhysicalDevices[DefaultDeviceIndex]->VkInstance(), false),
+    m_appMemMgr(this, pPhysicalDevices[DefaultDeviceIndex]->VkInstance(), true),
     m_shaderOptimizer(this, pPhysicalDevices[DefaultDeviceIndex]),
     m_resourceOptimizer(this, pPhysicalDevices[DefaultDeviceIndex]),
     m_renderStateCache(this),
+    m_descriptorSetLayoutCache(this),
+    m_graphicsSubStateCache(this),
+    m_palPipelineTable(this),
+    m_pipelineCreationProfiler(this),
+    m_barrierAnalyzer(this),
+    m_graphicsPipelineBindIdCounter(0),
     m_barrierPolicy(barrierPolicy),
     m_enabledExtensions(enabledExtensions),
     m_dispatchTable(DispatchTable::Type::DEVICE, m_pInstance, this),
@@ -1106,12 +1113,48 @@ VkResult Device::Initialize(
     // Initialize the internal memory manager
     VkResult result = m_internalMemMgr.Init();
 
+    // Initialize the memory manager that sub-allocates small application memory allocations
+    if (result == VK_SUCCESS)
+    {
+        result = m_appMemMgr.Init();
+    }
+
     // Initialize the render state cache
     if (result == VK_SUCCESS)
     {
         result = m_renderStateCache.Init();
     }
 
+    // Initialize the descriptor set layout interning table
+    if (result == VK_SUCCESS)
+    {
+        result = m_descriptorSetLayoutCache.Init();
+    }
+
+    // Initialize the cache of converted graphics pipeline sub-states
+    if (result == VK_SUCCESS)
+    {
+        result = m_graphicsSubStateCache.Init();
+    }
+
+    // Initialize the table of PAL pipelines shared by identical pipelines
+    if (result == VK_SUCCESS)
+    {
+        result = m_palPipelineTable.Init();
+    }
+
+    // Initialize the per-phase pipeline creation timers
+    if (result == VK_SUCCESS)
+    {
+        m_pipelineCreationProfiler.Init();
+    }
+
+    // Initialize the command buffer barrier analysis
+    if (result == VK_SUCCESS)
+    {
+        result = m_barrierAnalyzer.Init();
+    }
+
     if (result == VK_SUCCESS)
     {
         // Create a common CmdAllocator for internal use. For the driver setting, useSharedCmdAllocator,
@@ -1711,6 +1754,8 @@ VkResult Device::Destroy(const VkAllocationCallbacks* pAllocator)
 
     DestroyInternalPipelines();
 
+    m_pipelineCreationProfiler.Dump();
+
     for (uint32_t deviceIdx = 0; deviceIdx < NumPalDevices(); deviceIdx++)
     {
         if (m_perGpu[deviceIdx].pSharedPalCmdAllocator != nullptr)
@@ -2001,6 +2046,50 @@ VkResult Device::WaitIdle(void)
     return result;
 }
 
+// =====================================================================================================================
+// Waits until the operation identified by a submit point, see Queue::GetSubmitPoint(), has been issued to PAL by the
+// submission thread of its queue.  Nothing is waited for if the point is 0 or belongs to pSkipQueue, whose operations
+// are issued in order anyway.
+void Device::WaitForSubmitPoint(
+    uint64_t     submitPoint,
+    const Queue* pSkipQueue)
+{
+    if (submitPoint != 0)
+    {
+        Queue* pQueue = GetQueueOfPoint(submitPoint);
+
+        if (pQueue != pSkipQueue)
+        {
+            pQueue->WaitSubmitThreadIssued(submitPoint & ((1ull << Queue::SubmitPointQueueShift) - 1));
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns whether the Submit() or BindSparse() call identified by a completion point, see Queue::GetCompletionPoint(),
+// is known to have completed on the GPU.
+bool Device::IsCompletionPointReached(
+    uint64_t completionPoint) const
+{
+    return (completionPoint != 0) &&
+           (GetQueueOfPoint(completionPoint)->GetCompletedSubmitSerial() >=
+            (completionPoint & ((1ull << Queue::SubmitPointQueueShift) - 1)));
+}
+
+// =====================================================================================================================
+// Returns the queue a non-zero submit or completion point belongs to.
+Queue* Device::GetQueueOfPoint(
+    uint64_t point) const
+{
+    const uint32_t queueSlot   = static_cast<uint32_t>(point >> Queue::SubmitPointQueueShift) - 1;
+    const uint32_t familyIndex = queueSlot / Queue::MaxQueuesPerFamily;
+    const uint32_t queueIndex  = queueSlot % Queue::MaxQueuesPerFamily;
+
+    VK_ASSERT((familyIndex < Queue::MaxQueueFamilies) && (m_pQueues[familyIndex][queueIndex] != nullptr));
+
+    return *m_pQueues[familyIndex][queueIndex];
+}
+
 // =====================================================================================================================
 // Creates a new GPU memory object
 VkResult Device::AllocMemory(
@@ -2055,6 +2144,9 @@ Pal::PrtFeatureFlags Device::GetPrtFeatures() const
     return featureFlags;
 }
 
+// Number of fences or semaphores a host wait gathers without acquiring a virtual stack allocator
+static constexpr uint32_t InlineHostWaitObjectCount = 16;
+
 // =====================================================================================================================
 VkResult Device::WaitForFences(
     uint32_t       fenceCount,
@@ -2064,16 +2156,55 @@ VkResult Device::WaitForFences(
 {
     Pal::Result palResult = Pal::Result::Success;
 
-    Pal::IFence** ppPalFences = static_cast<Pal::IFence**>(VK_ALLOC_A(sizeof(Pal::IFence*) * fenceCount));
+    // Fences that are known to be signaled need no driver call.  The remaining ones are then queried in one batch.
+    uint32_t knownSignaledCount = 0;
+
+    for (uint32_t i = 0; i < fenceCount; ++i)
+    {
+        if (Fence::ObjectFromHandle(pFences[i])->IsKnownSignaled())
+        {
+            knownSignaledCount++;
+        }
+    }
+
+    if ((knownSignaledCount == fenceCount) || ((waitAll == VK_FALSE) && (knownSignaledCount > 0)))
+    {
+        return VK_SUCCESS;
+    }
+
+    VirtualStackArray<Pal::IFence*, InlineHostWaitObjectCount> palFenceArray(VkInstance()->StackMgr());
+
+    Pal::IFence** ppPalFences = palFenceArray.Alloc(fenceCount);
+
+    if (ppPalFences == nullptr)
+    {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    // Submission threads have to issue the submissions of the fences before PAL can wait for them
+    for (uint32_t i = 0; i < fenceCount; ++i)
+    {
+        Fence::ObjectFromHandle(pFences[i])->WaitForSubmission();
+    }
 
     if (IsMultiGpu() == false)
     {
+        uint32_t palFenceCount = 0;
+
         for (uint32_t i = 0; i < fenceCount; ++i)
         {
-            ppPalFences[i] = Fence::ObjectFromHandle(pFences[i])->PalFence(DefaultDeviceIndex);
+            Fence* pFence = Fence::ObjectFromHandle(pFences[i]);
+
+            if (pFence->IsKnownSignaled() == false)
+            {
+                ppPalFences[palFenceCount++] = pFence->PalFence(DefaultDeviceIndex);
+            }
         }
 
-        palResult = PalDevice(DefaultDeviceIndex)->WaitForFences(fenceCount, ppPalFences, waitAll != VK_FALSE, timeout);
+        palResult = PalDevice(DefaultDeviceIndex)->WaitForFences(palFenceCount,
+                                                                 ppPalFences,
+                                                                 waitAll != VK_FALSE,
+                                                                 timeout);
     }
     else
     {
@@ -2092,6 +2223,11 @@ VkResult Device::WaitForFences(
                 // for these cases.
                 const bool forceWait = (pFence->GetActiveDeviceMask() == 0) && (deviceIdx == DefaultDeviceIndex);
 
+                if (pFence->IsKnownSignaled())
+                {
+                    continue;
+                }
+
                 if (forceWait || ((currentDeviceMask & pFence->GetActiveDeviceMask()) != 0))
                 {
                     ppPalFences[perDeviceFenceCount++] = pFence->PalFence(deviceIdx);
@@ -2107,6 +2243,16 @@ VkResult Device::WaitForFences(
             }
         }
     }
+
+    // After waiting for all of them, every fence is known to be signaled
+    if ((palResult == Pal::Result::Success) && (waitAll != VK_FALSE))
+    {
+        for (uint32_t i = 0; i < fenceCount; ++i)
+        {
+            Fence::ObjectFromHandle(pFences[i])->SetKnownSignaled();
+        }
+    }
+
     return PalToVkResult(palResult);
 }
 
@@ -2116,13 +2262,23 @@ VkResult Device::ResetFences(
     uint32_t       fenceCount,
     const VkFence* pFences)
 {
-    Pal::IFence** ppPalFences = static_cast<Pal::IFence**>(VK_ALLOC_A(sizeof(Pal::IFence*) * fenceCount));
+    VirtualStackArray<Pal::IFence*, InlineHostWaitObjectCount> palFenceArray(VkInstance()->StackMgr());
+
+    Pal::IFence** ppPalFences = palFenceArray.Alloc(fenceCount);
+
+    if (ppPalFences == nullptr)
+    {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
 
     Pal::Result palResult = Pal::Result::Success;
 
     // Clear the wait masks for each fence
     for (uint32_t i = 0; i < fenceCount; ++i)
     {
+        Fence::ObjectFromHandle(pFences[i])->WaitForSubmission();
+        Fence::ObjectFromHandle(pFences[i])->ClearPendingSubmission();
+        Fence::ObjectFromHandle(pFences[i])->ClearKnownSignaled();
         Fence::ObjectFromHandle(pFences[i])->ClearActiveDeviceMask();
         Fence::ObjectFromHandle(pFences[i])->RestoreFence(this);
     }
@@ -2688,8 +2844,43 @@ VkResult Device::WaitSemaphores(
     Pal::Result palResult = Pal::Result::Success;
     uint32_t flags = 0;
 
-    Pal::IQueueSemaphore** ppPalSemaphores = static_cast<Pal::IQueueSemaphore**>(VK_ALLOC_A(
-                sizeof(Pal::IQueueSemaphore*) * pWaitInfo->semaphoreCount));
+    const bool waitAny = (pWaitInfo->flags == VK_SEMAPHORE_WAIT_ANY_BIT);
+
+    // Answer waits for values that have already been observed on the host without a round trip to the kernel driver.
+    // This is the common case for job systems that poll timelines with a zero timeout.
+    uint32_t reachedCount = 0;
+
+    for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; ++i)
+    {
+        Semaphore* pSemaphore = Semaphore::ObjectFromHandle(pWaitInfo->pSemaphores[i]);
+
+        pSemaphore->RefreshTimelineValue(this);
+
+        if (pSemaphore->IsTimelineValueReached(pWaitInfo->pValues[i]))
+        {
+            reachedCount++;
+        }
+    }
+
+    if ((reachedCount == pWaitInfo->semaphoreCount) || (waitAny && (reachedCount > 0)))
+    {
+        return VK_SUCCESS;
+    }
+
+    // The semaphores may be signaled by submissions that submission threads have yet to issue
+    for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; ++i)
+    {
+        WaitForSubmitPoint(Semaphore::ObjectFromHandle(pWaitInfo->pSemaphores[i])->GetSignalSubmitPoint(), nullptr);
+    }
+
+    VirtualStackArray<Pal::IQueueSemaphore*, InlineHostWaitObjectCount> palSemaphoreArray(VkInstance()->StackMgr());
+
+    Pal::IQueueSemaphore** ppPalSemaphores = palSemaphoreArray.Alloc(pWaitInfo->semaphoreCount);
+
+    if (ppPalSemaphores == nullptr)
+    {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
 
     for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; ++i)
     {
@@ -2699,12 +2890,21 @@ VkResult Device::WaitSemaphores(
     }
 
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 508
-    if (pWaitInfo->flags == VK_SEMAPHORE_WAIT_ANY_BIT)
+    if (waitAny)
     {
         flags |= Pal::HostWaitFlags::HostWaitAny;
     }
     palResult = PalDevice(DefaultDeviceIndex)->WaitForSemaphores(pWaitInfo->semaphoreCount, ppPalSemaphores,
             pWaitInfo->pValues, flags, timeout);
+
+    // After waiting for all of them, every value is known to be reached
+    if ((palResult == Pal::Result::Success) && (waitAny == false))
+    {
+        for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; ++i)
+        {
+            Semaphore::ObjectFromHandle(pWaitInfo->pSemaphores[i])->ObserveTimelineValue(pWaitInfo->pValues[i]);
+        }
+    }
 #endif
     return PalToVkResult(palResult);
 }
@@ -34,6 +34,8 @@
 #include "include/vk_device.h"
 #include "include/vk_instance.h"
 #include "include/vk_object.h"
+#include "include/vk_queue.h"
+#include "include/queue_submit_thread.h"
 
 #include "palFence.h"
 
@@ -115,7 +117,10 @@ VkResult Fence::Create(
     if (palResult == Pal::Result::Success)
     {
         // On success, wrap it in an API object and return to application
-        VK_PLACEMENT_NEW (pMemory) Fence(numGroupedFences, pPalFences, palFenceCreateInfo.flags.eventCanBeInherited);
+        VK_PLACEMENT_NEW (pMemory) Fence(numGroupedFences,
+                                         pPalFences,
+                                         palFenceCreateInfo.flags.eventCanBeInherited,
+                                         palFenceCreateInfo.flags.signaled);
 
         *pFence = Fence::HandleFromVoidPointer(pMemory);
 
@@ -135,6 +140,8 @@ VkResult Fence::Destroy(
 {
     VK_ASSERT(m_groupedFenceCount == pDevice->NumPalDevices());
 
+    WaitForSubmission();
+
     RestoreFence(pDevice);
 
     for (uint32_t groupIdx = 0; groupIdx < m_groupedFenceCount; groupIdx++)
@@ -158,6 +165,18 @@ VkResult Fence::GetStatus(void)
 {
     Pal::Result palResult = Pal::Result::Success;
 
+    // Fences stay signaled until they are reset, so repeated polls need not ask PAL again
+    if (IsKnownSignaled())
+    {
+        return VK_SUCCESS;
+    }
+
+    // PAL does not know about the submission yet, so the fence cannot be signaled
+    if (IsSubmissionPending())
+    {
+        return VK_NOT_READY;
+    }
+
     for (uint32_t deviceIdx = 0; (deviceIdx < m_groupedFenceCount) && (palResult == Pal::Result::Success); deviceIdx++)
     {
         // Some conformance tests will wait on fences that were never submitted, so use only the first device
@@ -175,6 +194,8 @@ VkResult Fence::GetStatus(void)
     if (palResult == Pal::Result::Success)
     {
         result = VK_SUCCESS;
+
+        SetKnownSignaled();
     }
     else if ((palResult == Pal::Result::ErrorUnavailable) ||
              (palResult == Pal::Result::NotReady)         ||
@@ -206,6 +227,10 @@ VkResult Fence::ImportFenceFd(
 
     bool isPermanence = (pImportFenceFdInfo->flags & VK_FENCE_IMPORT_TEMPORARY_BIT_KHR) == 0;
 
+    WaitForSubmission();
+    ClearPendingSubmission();
+    ClearKnownSignaled();
+
     m_flags.isOpened       = 1;
     m_flags.isPermanence   = isPermanence;
     m_flags.isReference    = openInfo.flags.isReference;
@@ -254,6 +279,21 @@ VkResult Fence::GetFenceFd(
     VK_ASSERT((pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_OPAQUE_FD_BIT_KHR) ||
               (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_SYNC_FD_BIT_KHR));
 
+    WaitForSubmission();
+
+    if (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_SYNC_FD_BIT_KHR)
+    {
+        ClearPendingSubmission();
+    }
+
+    // Exporting a sync file resets the fence, and a referenced payload may be reset through the exported handle
+    ClearKnownSignaled();
+
+    if (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_OPAQUE_FD_BIT_KHR)
+    {
+        m_flags.isExported = 1;
+    }
+
     Pal::FenceExportInfo exportInfo = {};
     exportInfo.flags.isReference   = (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_OPAQUE_FD_BIT_KHR);
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 566
@@ -265,6 +305,41 @@ VkResult Fence::GetFenceFd(
 }
 #endif
 
+// =====================================================================================================================
+// Returns whether the fence was passed to a submission that a queue's submission thread has not issued to PAL yet.
+bool Fence::IsSubmissionPending() const
+{
+    const QueueSubmitThread* pSubmitThread = m_pSubmitThread;
+
+    return (pSubmitThread != nullptr) && (pSubmitThread->IsIssued(m_submitOpCount) == false);
+}
+
+// =====================================================================================================================
+// Records that PAL has reported the fence as signaled.  Unless the payload is shared, this also tells the queue that
+// the fence's submission and everything submitted before it have completed.
+void Fence::SetKnownSignaled()
+{
+    m_knownSignaled = (m_flags.isOpened == 0) && (m_flags.isExported == 0);
+
+    if (m_knownSignaled && (m_pSubmitQueue != nullptr))
+    {
+        m_pSubmitQueue->ObserveCompletedSubmitSerial(m_submitSerial);
+    }
+}
+
+// =====================================================================================================================
+// Waits until the submission the fence was passed to, if any, has been issued to PAL.  PAL fences must not be waited
+// on, reset or exported before that.
+void Fence::WaitForSubmission() const
+{
+    QueueSubmitThread* pSubmitThread = m_pSubmitThread;
+
+    if (pSubmitThread != nullptr)
+    {
+        pSubmitThread->WaitIssued(m_submitOpCount);
+    }
+}
+
 // =====================================================================================================================
 
 // =====================================================================================================================
@@ -275,6 +350,9 @@ VkResult Fence::RestoreFence(
 
     if ((m_flags.isPermanence == 0) && m_flags.isOpened)
     {
+        // The permanent payload may be in another state than the temporary one was
+        ClearKnownSignaled();
+
         m_pPalTemporaryFences->Destroy();
         m_pPalTemporaryFences = nullptr;
         m_flags.isPermanence  = 1;
@@ -428,6 +428,22 @@ void GraphicsPipeline::GenerateHashFromDynamicStateCreateInfo(
     }
 }
 
+// =====================================================================================================================
+// Finishes the hashes of a sub-state that was hashed with its own pair of hashers and adds them to the pipeline hashes.
+static void FinalizeSubStateHash(
+    Util::MetroHash128*   pSubStateBaseHasher,
+    Util::MetroHash128*   pSubStateApiHasher,
+    Util::MetroHash128*   pBaseHasher,
+    Util::MetroHash128*   pApiHasher,
+    GraphicsSubStateHash* pSubStateHash)
+{
+    pSubStateBaseHasher->Finalize(pSubStateHash->base.bytes);
+    pSubStateApiHasher->Finalize(pSubStateHash->api.bytes);
+
+    pBaseHasher->Update(pSubStateHash->base);
+    pApiHasher->Update(pSubStateHash->api);
+}
+
 // =====================================================================================================================
 // Generates the API PSO hash using the contents of the VkGraphicsPipelineCreateInfo struct
 // Pipeline compilation affected by:
@@ -443,11 +459,21 @@ void GraphicsPipeline::GenerateHashFromDynamicStateCreateInfo(
 //     - pCreateInfo->subpass
 uint64_t GraphicsPipeline::BuildApiHash(
     const VkGraphicsPipelineCreateInfo* pCreateInfo,
-    Util::MetroHash::Hash*              pBaseHash)
+    Util::MetroHash::Hash*              pBaseHash,
+    SubStateHashes*                     pSubStateHashes)
 {
     Util::MetroHash128 baseHasher;
     Util::MetroHash128 apiHasher;
 
+    // The sub-state hashes are computed whether or not the caller wants them, so the pipeline hashes do not depend on
+    // the GraphicsSubStateCache setting.
+    SubStateHashes localSubStateHashes;
+
+    if (pSubStateHashes == nullptr)
+    {
+        pSubStateHashes = &localSubStateHashes;
+    }
+
     baseHasher.Update(pCreateInfo->flags);
     baseHasher.Update(pCreateInfo->stageCount);
 
@@ -478,12 +504,32 @@ uint64_t GraphicsPipeline::BuildApiHash(
 
     if (pCreateInfo->pRasterizationState != nullptr)
     {
-        GenerateHashFromRasterizationStateCreateInfo(&baseHasher, &apiHasher, *pCreateInfo->pRasterizationState);
+        Util::MetroHash128 subStateBaseHasher;
+        Util::MetroHash128 subStateApiHasher;
+
+        GenerateHashFromRasterizationStateCreateInfo(&subStateBaseHasher,
+                                                     &subStateApiHasher,
+                                                     *pCreateInfo->pRasterizationState);
+        FinalizeSubStateHash(&subStateBaseHasher,
+                             &subStateApiHasher,
+                             &baseHasher,
+                             &apiHasher,
+                             &pSubStateHashes->rasterization);
     }
 
     if (pCreateInfo->pMultisampleState != nullptr)
     {
-        GenerateHashFromMultisampleStateCreateInfo(&baseHasher, &apiHasher, *pCreateInfo->pMultisampleState);
+        Util::MetroHash128 subStateBaseHasher;
+        Util::MetroHash128 subStateApiHasher;
+
+        GenerateHashFromMultisampleStateCreateInfo(&subStateBaseHasher,
+                                                   &subStateApiHasher,
+                                                   *pCreateInfo->pMultisampleState);
+        FinalizeSubStateHash(&subStateBaseHasher,
+                             &subStateApiHasher,
+                             &baseHasher,
+                             &apiHasher,
+                             &pSubStateHashes->multisample);
     }
 
     if (pCreateInfo->pDepthStencilState != nullptr)
@@ -493,7 +539,17 @@ uint64_t GraphicsPipeline::BuildApiHash(
 
     if (pCreateInfo->pColorBlendState != nullptr)
     {
-        GenerateHashFromColorBlendStateCreateInfo(&baseHasher, &apiHasher, *pCreateInfo->pColorBlendState);
+        Util::MetroHash128 subStateBaseHasher;
+        Util::MetroHash128 subStateApiHasher;
+
+        GenerateHashFromColorBlendStateCreateInfo(&subStateBaseHasher,
+                                                  &subStateApiHasher,
+                                                  *pCreateInfo->pColorBlendState);
+        FinalizeSubStateHash(&subStateBaseHasher,
+                             &subStateApiHasher,
+                             &baseHasher,
+                             &apiHasher,
+                             &pSubStateHashes->colorBlend);
     }
 
     if (pCreateInfo->pDynamicState != nullptr)
@@ -610,12 +666,12 @@ bool GetDualSourceBlendEnableState(const VkPipelineColorBlendAttachmentState& pC
 }
 
 // =====================================================================================================================
-// Parses input pipeline rasterization create info state.
+// Converts the rasterization state into a sub-state block.
 void GraphicsPipeline::BuildRasterizationState(
     Device*                                       pDevice,
     const VkPipelineRasterizationStateCreateInfo* pIn,
-    CreateInfo*                                   pInfo,
-    const bool                                    dynamicStateFlags[])
+    const bool                                    dynamicStateFlags[],
+    GraphicsRasterizationBlock*                   pBlock)
 {
     union
     {
@@ -633,7 +689,7 @@ void GraphicsPipeline::BuildRasterizationState(
     const VkPhysicalDeviceLimits& limits          = pPhysicalDevice->GetLimits();
 
     // Enable perpendicular end caps if we report strictLines semantics
-    pInfo->pipeline.rsState.perpLineEndCapsEnable = (limits.strictLines == VK_TRUE);
+    pBlock->perpLineEndCapsEnable = (limits.strictLines == VK_TRUE);
 
     for (pRs = pIn; pHeader != nullptr; pHeader = pHeader->pNext)
     {
@@ -647,41 +703,41 @@ void GraphicsPipeline::BuildRasterizationState(
                 if ((pRs->depthClampEnable == VK_FALSE) &&
                     (pDevice->IsExtensionEnabled(DeviceExtensions::EXT_DEPTH_RANGE_UNRESTRICTED)))
                 {
-                    pInfo->pipeline.rsState.depthClampDisable = true;
+                    pBlock->depthClampDisable = true;
                 }
                 else
                 {
                     // When depth clamping is enabled, depth clipping should be disabled, and vice versa.
                     // Clipping is updated in pipeline compiler.
-                    pInfo->pipeline.rsState.depthClampDisable = false;
+                    pBlock->depthClampDisable = false;
                 }
 
-                pInfo->immedInfo.triangleRasterState.frontFillMode = VkToPalFillMode(pRs->polygonMode);
-                pInfo->immedInfo.triangleRasterState.backFillMode  = VkToPalFillMode(pRs->polygonMode);
-                pInfo->immedInfo.triangleRasterState.cullMode  = VkToPalCullMode(pRs->cullMode);
-                pInfo->immedInfo.triangleRasterState.frontFace = VkToPalFaceOrientation(pRs->frontFace);
-                pInfo->immedInfo.triangleRasterState.flags.depthBiasEnable = pRs->depthBiasEnable;
+                pBlock->triangleRasterState.frontFillMode = VkToPalFillMode(pRs->polygonMode);
+                pBlock->triangleRasterState.backFillMode  = VkToPalFillMode(pRs->polygonMode);
+                pBlock->triangleRasterState.cullMode  = VkToPalCullMode(pRs->cullMode);
+                pBlock->triangleRasterState.frontFace = VkToPalFaceOrientation(pRs->frontFace);
+                pBlock->triangleRasterState.flags.depthBiasEnable = pRs->depthBiasEnable;
 
-                pInfo->immedInfo.depthBiasParams.depthBias = pRs->depthBiasConstantFactor;
-                pInfo->immedInfo.depthBiasParams.depthBiasClamp = pRs->depthBiasClamp;
-                pInfo->immedInfo.depthBiasParams.slopeScaledDepthBias = pRs->depthBiasSlopeFactor;
+                pBlock->depthBiasParams.depthBias = pRs->depthBiasConstantFactor;
+                pBlock->depthBiasParams.depthBiasClamp = pRs->depthBiasClamp;
+                pBlock->depthBiasParams.slopeScaledDepthBias = pRs->depthBiasSlopeFactor;
 
                 if (pRs->depthBiasEnable && (dynamicStateFlags[VK_DYNAMIC_STATE_DEPTH_BIAS] == false))
                 {
-                    pInfo->staticStateMask |= 1 << VK_DYNAMIC_STATE_DEPTH_BIAS;
+                    pBlock->staticStateMask |= 1 << VK_DYNAMIC_STATE_DEPTH_BIAS;
                 }
 
                 // point size must be set via gl_PointSize, otherwise it must be 1.0f.
                 constexpr float DefaultPointSize = 1.0f;
 
-                pInfo->immedInfo.pointLineRasterParams.lineWidth    = pRs->lineWidth;
-                pInfo->immedInfo.pointLineRasterParams.pointSize    = DefaultPointSize;
-                pInfo->immedInfo.pointLineRasterParams.pointSizeMin = limits.pointSizeRange[0];
-                pInfo->immedInfo.pointLineRasterParams.pointSizeMax = limits.pointSizeRange[1];
+                pBlock->pointLineRasterParams.lineWidth    = pRs->lineWidth;
+                pBlock->pointLineRasterParams.pointSize    = DefaultPointSize;
+                pBlock->pointLineRasterParams.pointSizeMin = limits.pointSizeRange[0];
+                pBlock->pointLineRasterParams.pointSizeMax = limits.pointSizeRange[1];
 
                 if (dynamicStateFlags[VK_DYNAMIC_STATE_LINE_WIDTH] == false)
                 {
-                    pInfo->staticStateMask |= 1 << VK_DYNAMIC_STATE_LINE_WIDTH;
+                    pBlock->staticStateMask |= 1 << VK_DYNAMIC_STATE_LINE_WIDTH;
                 }
             }
             break;
@@ -696,7 +752,7 @@ void GraphicsPipeline::BuildRasterizationState(
                 if (pPhysicalDevice->PalProperties().gfxipProperties.flags.supportOutOfOrderPrimitives)
 #endif
                 {
-                    pInfo->pipeline.rsState.outOfOrderPrimsEnable =
+                    pBlock->outOfOrderPrimsEnable =
                         VkToPalRasterizationOrder(pRsOrder->rasterizationOrder);
                 }
                 break;
@@ -713,19 +769,19 @@ void GraphicsPipeline::BuildRasterizationState(
                     {
                     case VK_CONSERVATIVE_RASTERIZATION_MODE_DISABLED_EXT:
                         {
-                            pInfo->msaa.flags.enableConservativeRasterization = false;
+                            pBlock->enableConservativeRasterization = false;
                         }
                         break;
                     case VK_CONSERVATIVE_RASTERIZATION_MODE_OVERESTIMATE_EXT:
                         {
-                            pInfo->msaa.flags.enableConservativeRasterization = true;
-                            pInfo->msaa.conservativeRasterizationMode         = Pal::ConservativeRasterizationMode::Overestimate;
+                            pBlock->enableConservativeRasterization = true;
+                            pBlock->conservativeRasterizationMode   = Pal::ConservativeRasterizationMode::Overestimate;
                         }
                         break;
                     case VK_CONSERVATIVE_RASTERIZATION_MODE_UNDERESTIMATE_EXT:
                         {
-                            pInfo->msaa.flags.enableConservativeRasterization = true;
-                            pInfo->msaa.conservativeRasterizationMode         = Pal::ConservativeRasterizationMode::Underestimate;
+                            pBlock->enableConservativeRasterization = true;
+                            pBlock->conservativeRasterizationMode   = Pal::ConservativeRasterizationMode::Underestimate;
                         }
                         break;
 
@@ -737,33 +793,33 @@ void GraphicsPipeline::BuildRasterizationState(
                 break;
             case VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_STREAM_CREATE_INFO_EXT:
                 {
-                    pInfo->rasterizationStream = pRsStream->rasterizationStream;
+                    pBlock->rasterizationStream = pRsStream->rasterizationStream;
                 }
                 break;
             case VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_LINE_STATE_CREATE_INFO_EXT:
                 {
-                    pInfo->bresenhamEnable =
+                    pBlock->bresenhamEnable =
                         (pRsRasterizationLine->lineRasterizationMode == VK_LINE_RASTERIZATION_MODE_BRESENHAM_EXT);
 
                     // Bresenham Lines need axis aligned end caps
-                    if (pInfo->bresenhamEnable)
+                    if (pBlock->bresenhamEnable)
                     {
-                        pInfo->pipeline.rsState.perpLineEndCapsEnable = false;
+                        pBlock->perpLineEndCapsEnable = false;
                     }
                     else if (pRsRasterizationLine->lineRasterizationMode == VK_LINE_RASTERIZATION_MODE_RECTANGULAR_EXT)
                     {
-                        pInfo->pipeline.rsState.perpLineEndCapsEnable = true;
+                        pBlock->perpLineEndCapsEnable = true;
                     }
 
-                    pInfo->msaa.flags.enableLineStipple                   = pRsRasterizationLine->stippledLineEnable;
+                    pBlock->enableLineStipple                  = pRsRasterizationLine->stippledLineEnable;
 
-                    pInfo->immedInfo.lineStippleParams.lineStippleScale   = (pRsRasterizationLine->lineStippleFactor - 1);
-                    pInfo->immedInfo.lineStippleParams.lineStippleValue   = pRsRasterizationLine->lineStipplePattern;
+                    pBlock->lineStippleParams.lineStippleScale = (pRsRasterizationLine->lineStippleFactor - 1);
+                    pBlock->lineStippleParams.lineStippleValue = pRsRasterizationLine->lineStipplePattern;
 
                     if (pRsRasterizationLine->stippledLineEnable &&
                        (dynamicStateFlags[static_cast<uint32_t>(DynamicStatesInternal::LINE_STIPPLE_EXT)] == false))
                     {
-                        pInfo->staticStateMask |= 1 << static_cast<uint32_t>(DynamicStatesInternal::LINE_STIPPLE_EXT);
+                        pBlock->staticStateMask |= 1 << static_cast<uint32_t>(DynamicStatesInternal::LINE_STIPPLE_EXT);
                     }
                 }
                 break;
@@ -777,28 +833,274 @@ void GraphicsPipeline::BuildRasterizationState(
     }
 }
 
+// =====================================================================================================================
+// Converts the multisample state of a pipeline rendering to the given subpass into a sub-state block.  The MSAA flags
+// that come from the rasterization state are not touched.
+void GraphicsPipeline::BuildMultisampleState(
+    const VkPipelineMultisampleStateCreateInfo* pMs,
+    const RenderPass*                           pRenderPass,
+    uint32_t                                    subpass,
+    bool                                        bresenhamEnable,
+    const bool                                  dynamicStateFlags[],
+    GraphicsMultisampleBlock*                   pBlock)
+{
+    // Fill in necessary non-zero defaults in case some information is missing
+    pBlock->msaa.coverageSamples         = 1;
+    pBlock->msaa.pixelShaderSamples      = 1;
+    pBlock->msaa.depthStencilSamples     = 1;
+    pBlock->msaa.shaderExportMaskSamples = 1;
+    pBlock->msaa.sampleClusters          = 1;
+    pBlock->msaa.alphaToCoverageSamples  = 1;
+    pBlock->msaa.occlusionQuerySamples   = 1;
+    pBlock->msaa.sampleMask              = 1;
+    pBlock->sampleCoverage               = 1;
+
+    if (pMs != nullptr)
+    {
+        // Sample Locations
+        EXTRACT_VK_STRUCTURES_1(
+            SampleLocations,
+            PipelineMultisampleStateCreateInfo,
+            PipelineSampleLocationsStateCreateInfoEXT,
+            pMs,
+            PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+            PIPELINE_SAMPLE_LOCATIONS_STATE_CREATE_INFO_EXT)
+
+        bool multisampleEnable     = (pMs->rasterizationSamples != 1) &&
+                                     (bresenhamEnable == false);
+
+        bool customSampleLocations = ((pPipelineSampleLocationsStateCreateInfoEXT != nullptr) &&
+                                      (pPipelineSampleLocationsStateCreateInfoEXT->sampleLocationsEnable));
+
+        if (multisampleEnable || customSampleLocations)
+        {
+            VK_ASSERT(pRenderPass != nullptr);
+
+            uint32_t rasterizationSampleCount   = pMs->rasterizationSamples;
+            uint32_t subpassCoverageSampleCount = pRenderPass->GetSubpassMaxSampleCount(subpass);
+            uint32_t subpassColorSampleCount    = pRenderPass->GetSubpassColorSampleCount(subpass);
+            uint32_t subpassDepthSampleCount    = pRenderPass->GetSubpassDepthSampleCount(subpass);
+
+            // subpassCoverageSampleCount would be equal to zero if there are zero attachments.
+            subpassCoverageSampleCount = subpassCoverageSampleCount == 0 ? rasterizationSampleCount : subpassCoverageSampleCount;
+
+            // In case we are rendering to color only, we make sure to set the DepthSampleCount to CoverageSampleCount.
+            // CoverageSampleCount is really the ColorSampleCount in this case. This makes sure we have a consistent
+            // sample count and that we get correct MSAA behavior.
+            // Similar thing for when we are rendering to depth only. The expectation in that case is that all
+            // sample counts should match.
+            // This shouldn't interfere with EQAA. For EQAA, if ColorSampleCount is not equal to DepthSampleCount
+            // and they are both greater than one, then we do not force them to match.
+            subpassColorSampleCount = subpassColorSampleCount == 0 ? subpassCoverageSampleCount : subpassColorSampleCount;
+            subpassDepthSampleCount = subpassDepthSampleCount == 0 ? subpassCoverageSampleCount : subpassDepthSampleCount;
+
+            VK_ASSERT(rasterizationSampleCount == subpassCoverageSampleCount);
+
+            pBlock->msaa.coverageSamples = subpassCoverageSampleCount;
+            pBlock->msaa.exposedSamples  = subpassCoverageSampleCount;
+
+            if (pMs->sampleShadingEnable && (pMs->minSampleShading > 0.0f))
+            {
+                pBlock->msaa.pixelShaderSamples =
+                    Pow2Pad(static_cast<uint32_t>(ceil(subpassColorSampleCount * pMs->minSampleShading)));
+            }
+            else
+            {
+                pBlock->msaa.pixelShaderSamples = 1;
+            }
+
+            pBlock->msaa.depthStencilSamples = subpassDepthSampleCount;
+            pBlock->msaa.shaderExportMaskSamples = subpassCoverageSampleCount;
+            pBlock->msaa.sampleMask = (pMs->pSampleMask != nullptr)
+                                      ? pMs->pSampleMask[0]
+                                      : 0xffffffff;
+            pBlock->msaa.sampleClusters         = subpassCoverageSampleCount;
+            pBlock->msaa.alphaToCoverageSamples = subpassCoverageSampleCount;
+            pBlock->msaa.occlusionQuerySamples  = subpassDepthSampleCount;
+            pBlock->sampleCoverage              = subpassCoverageSampleCount;
+
+            if (customSampleLocations)
+            {
+                // Enable single-sampled custom sample locations if necessary
+                pBlock->msaa.flags.enable1xMsaaSampleLocations = (pBlock->msaa.coverageSamples == 1);
+
+                if (dynamicStateFlags[static_cast<uint32_t>(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT)] == false)
+                {
+                    // We store the custom sample locations if custom sample locations are enabled and the
+                    // sample locations state is static.
+                    pBlock->samplePatternCount =
+                        (uint32_t)pPipelineSampleLocationsStateCreateInfoEXT->sampleLocationsInfo.sampleLocationsPerPixel;
+
+                    ConvertToPalMsaaQuadSamplePattern(
+                        &pPipelineSampleLocationsStateCreateInfoEXT->sampleLocationsInfo,
+                        &pBlock->samplePatternLocations);
+
+                    VK_ASSERT(pBlock->samplePatternCount == rasterizationSampleCount);
+
+                    pBlock->staticStateMask |=
+                        (1 << static_cast<uint32_t>(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT));
+                }
+            }
+            else
+            {
+                // We store the standard sample locations if custom sample locations are not enabled.
+                pBlock->samplePatternCount = rasterizationSampleCount;
+                pBlock->samplePatternLocations =
+                    *Device::GetDefaultQuadSamplePattern(rasterizationSampleCount);
+
+                pBlock->staticStateMask |=
+                    1 << static_cast<uint32_t>(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT);
+            }
+        }
+
+        // The alpha component of the fragment's first color output is replaced with one if alphaToOneEnable is set.
+        pBlock->forceAlphaToOne       = (pMs->alphaToOneEnable == VK_TRUE);
+        pBlock->alphaToCoverageEnable = (pMs->alphaToCoverageEnable == VK_TRUE);
+    }
+
+}
+
+// =====================================================================================================================
+// Converts the color blend state of a pipeline rendering to the given subpass into a sub-state block.
+void GraphicsPipeline::BuildColorBlendState(
+    const VkPipelineColorBlendStateCreateInfo* pCb,
+    const RenderPass*                          pRenderPass,
+    uint32_t                                   subpass,
+    const bool                                 dynamicStateFlags[],
+    GraphicsColorBlendBlock*                   pBlock)
+{
+    bool blendingEnabled = false;
+    bool dualSourceBlend = false;
+
+    if (pCb == nullptr)
+    {
+        pBlock->logicOp = Pal::LogicOp::Copy;
+    }
+    else
+    {
+        pBlock->logicOp = (pCb->logicOpEnable) ?
+                          VkToPalLogicOp(pCb->logicOp) :
+                          Pal::LogicOp::Copy;
+
+        const uint32_t numColorTargets = Min(pCb->attachmentCount, Pal::MaxColorTargets);
+
+        for (uint32_t i = 0; i < numColorTargets; ++i)
+        {
+            const VkPipelineColorBlendAttachmentState& src = pCb->pAttachments[i];
+
+            auto pCbDst     = &pBlock->targets[i];
+            auto pBlendDst  = &pBlock->blend.targets[i];
+
+            if (pRenderPass)
+            {
+                pCbDst->swizzledFormat = VkToPalFormat(pRenderPass->GetColorAttachmentFormat(subpass, i));
+            }
+
+            // If the sub pass attachment format is UNDEFINED, then it means that that subpass does not
+            // want to write to any attachment for that output (VK_ATTACHMENT_UNUSED).  Under such cases,
+            // disable shader writes through that target.
+            if (pCbDst->swizzledFormat.format != Pal::ChNumFormat::Undefined)
+            {
+                pCbDst->channelWriteMask         = src.colorWriteMask;
+                blendingEnabled |= (src.blendEnable == VK_TRUE);
+            }
+
+            pBlendDst->blendEnable    = (src.blendEnable == VK_TRUE);
+            pBlendDst->srcBlendColor  = VkToPalBlend(src.srcColorBlendFactor);
+            pBlendDst->dstBlendColor  = VkToPalBlend(src.dstColorBlendFactor);
+            pBlendDst->blendFuncColor = VkToPalBlendFunc(src.colorBlendOp);
+            pBlendDst->srcBlendAlpha  = VkToPalBlend(src.srcAlphaBlendFactor);
+            pBlendDst->dstBlendAlpha  = VkToPalBlend(src.dstAlphaBlendFactor);
+            pBlendDst->blendFuncAlpha = VkToPalBlendFunc(src.alphaBlendOp);
+
+            dualSourceBlend |= GetDualSourceBlendEnableState(src);
+        }
+    }
+
+    pBlock->dualSourceBlendEnable = dualSourceBlend;
+
+    if (blendingEnabled == true && dynamicStateFlags[VK_DYNAMIC_STATE_BLEND_CONSTANTS] == false)
+    {
+        static_assert(sizeof(pBlock->blendConstParams) == sizeof(pCb->blendConstants),
+            "Blend constant structure size mismatch!");
+
+        memcpy(&pBlock->blendConstParams, pCb->blendConstants, sizeof(pCb->blendConstants));
+
+        pBlock->staticStateMask |= 1 << VK_DYNAMIC_STATE_BLEND_CONSTANTS;
+    }
+
+}
+
+// =====================================================================================================================
+// Copies a converted rasterization sub-state into the pipeline create info.  This must come after
+// ApplyMultisampleState() since both write the MSAA state.
+void GraphicsPipeline::ApplyRasterizationState(
+    const GraphicsRasterizationBlock& block,
+    CreateInfo*                       pInfo)
+{
+    pInfo->pipeline.rsState.depthClampDisable     = block.depthClampDisable;
+    pInfo->pipeline.rsState.perpLineEndCapsEnable = block.perpLineEndCapsEnable;
+    pInfo->pipeline.rsState.outOfOrderPrimsEnable = block.outOfOrderPrimsEnable;
+
+    pInfo->immedInfo.triangleRasterState   = block.triangleRasterState;
+    pInfo->immedInfo.depthBiasParams       = block.depthBiasParams;
+    pInfo->immedInfo.pointLineRasterParams = block.pointLineRasterParams;
+    pInfo->immedInfo.lineStippleParams     = block.lineStippleParams;
+
+    pInfo->msaa.flags.enableConservativeRasterization = block.enableConservativeRasterization;
+    pInfo->msaa.flags.enableLineStipple               = block.enableLineStipple;
+    pInfo->msaa.conservativeRasterizationMode         = block.conservativeRasterizationMode;
+
+    pInfo->rasterizationStream = block.rasterizationStream;
+    pInfo->bresenhamEnable     = block.bresenhamEnable;
+    pInfo->staticStateMask    |= block.staticStateMask;
+}
+
+// =====================================================================================================================
+// Copies a converted multisample sub-state into the pipeline create info.
+void GraphicsPipeline::ApplyMultisampleState(
+    const GraphicsMultisampleBlock& block,
+    CreateInfo*                     pInfo)
+{
+    pInfo->msaa                                       = block.msaa;
+    pInfo->sampleCoverage                             = block.sampleCoverage;
+    pInfo->immedInfo.samplePattern.locations          = block.samplePatternLocations;
+    pInfo->immedInfo.samplePattern.sampleCount        = block.samplePatternCount;
+    pInfo->pipeline.cbState.target[0].forceAlphaToOne = block.forceAlphaToOne;
+    pInfo->pipeline.cbState.alphaToCoverageEnable     = block.alphaToCoverageEnable;
+    pInfo->staticStateMask                           |= block.staticStateMask;
+}
+
+// =====================================================================================================================
+// Copies a converted color blend sub-state into the pipeline create info.
+void GraphicsPipeline::ApplyColorBlendState(
+    const GraphicsColorBlendBlock& block,
+    CreateInfo*                    pInfo)
+{
+    pInfo->blend                                  = block.blend;
+    pInfo->pipeline.cbState.logicOp               = block.logicOp;
+    pInfo->pipeline.cbState.dualSourceBlendEnable = block.dualSourceBlendEnable;
+
+    for (uint32_t i = 0; i < Pal::MaxColorTargets; ++i)
+    {
+        pInfo->pipeline.cbState.target[i].swizzledFormat   = block.targets[i].swizzledFormat;
+        pInfo->pipeline.cbState.target[i].channelWriteMask = block.targets[i].channelWriteMask;
+    }
+
+    pInfo->immedInfo.blendConstParams = block.blendConstParams;
+    pInfo->staticStateMask           |= block.staticStateMask;
+}
+
 // =====================================================================================================================
 // Converts Vulkan graphics pipeline parameters to an internal structure
 void GraphicsPipeline::ConvertGraphicsPipelineInfo(
     Device*                             pDevice,
     const VkGraphicsPipelineCreateInfo* pIn,
     const VbBindingInfo*                pVbInfo,
+    const SubStateHashes&               subStateHashes,
     CreateInfo*                         pInfo)
 {
     const RuntimeSettings& settings = pDevice->GetRuntimeSettings();
-    VkFormat cbFormat[Pal::MaxColorTargets] = {};
-
-    // Fill in necessary non-zero defaults in case some information is missing
-    pInfo->msaa.coverageSamples                 = 1;
-    pInfo->msaa.pixelShaderSamples              = 1;
-    pInfo->msaa.depthStencilSamples             = 1;
-    pInfo->msaa.shaderExportMaskSamples         = 1;
-    pInfo->msaa.sampleClusters                  = 1;
-    pInfo->msaa.alphaToCoverageSamples          = 1;
-    pInfo->msaa.occlusionQuerySamples           = 1;
-    pInfo->msaa.sampleMask                      = 1;
-    pInfo->sampleCoverage                       = 1;
-    pInfo->rasterizationStream                  = 0;
 
     EXTRACT_VK_STRUCTURES_0(
         gfxPipeline,
@@ -933,198 +1235,129 @@ void GraphicsPipeline::ConvertGraphicsPipelineInfo(
 
         }
 
-        BuildRasterizationState(pDevice,
-                                pGraphicsPipelineCreateInfo->pRasterizationState,
-                                pInfo,
-                                dynamicStateFlags);
+        // Convert the rasterization, multisample and color blend states.  Pipelines sharing these sub-states with an
+        // earlier pipeline reuse its conversion.  Each cache key extends the hash of the Vulkan sub-state, computed by
+        // BuildApiHash(), with the other inputs of its conversion.
+        const VkPipelineRasterizationStateCreateInfo* pRs     = pGraphicsPipelineCreateInfo->pRasterizationState;
+        const VkPipelineMultisampleStateCreateInfo*   pMs     = pGraphicsPipelineCreateInfo->pMultisampleState;
+        const VkPipelineColorBlendStateCreateInfo*    pCb     = pGraphicsPipelineCreateInfo->pColorBlendState;
+        const uint32_t                                subpass = pGraphicsPipelineCreateInfo->subpass;
 
-        pInfo->pipeline.rsState.pointCoordOrigin       = Pal::PointOrigin::UpperLeft;
-        pInfo->pipeline.rsState.shadeMode              = Pal::ShadeMode::Flat;
-        pInfo->pipeline.rsState.rasterizeLastLinePixel = 0;
+        GraphicsSubStateCache* pSubStateCache = settings.enableGraphicsSubStateCache ?
+                                                pDevice->GetGraphicsSubStateCache() : nullptr;
 
-        // Pipeline Binning Override
-        switch (settings.pipelineBinningMode)
-        {
-        case PipelineBinningModeEnable:
-            pInfo->pipeline.rsState.binningOverride = Pal::BinningOverride::Enable;
-            break;
+        static_assert(uint32_t(DynamicStatesInternal::DynamicStatesInternalCount) <= 32,
+            "Dynamic state flags no longer fit in a mask!");
 
-        case PipelineBinningModeDisable:
-            pInfo->pipeline.rsState.binningOverride = Pal::BinningOverride::Disable;
-            break;
+        uint32_t dynamicStateMask = 0;
 
-        case PipelineBinningModeDefault:
-        default:
-            pInfo->pipeline.rsState.binningOverride = Pal::BinningOverride::Default;
-            break;
+        for (uint32_t i = 0; i < uint32_t(DynamicStatesInternal::DynamicStatesInternalCount); ++i)
+        {
+            dynamicStateMask |= (dynamicStateFlags[i] ? (1u << i) : 0u);
         }
 
-        const VkPipelineMultisampleStateCreateInfo* pMs = pGraphicsPipelineCreateInfo->pMultisampleState;
+        GraphicsRasterizationBlock rsBlock     = {};
+        Util::MetroHash::Hash      rsHash      = {};
+        const bool                 rsCacheable = (pSubStateCache != nullptr) && (pRs != nullptr);
 
-        if (pMs != nullptr)
+        if (rsCacheable)
         {
-            // Sample Locations
-            EXTRACT_VK_STRUCTURES_1(
-                SampleLocations,
-                PipelineMultisampleStateCreateInfo,
-                PipelineSampleLocationsStateCreateInfoEXT,
-                pMs,
-                PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-                PIPELINE_SAMPLE_LOCATIONS_STATE_CREATE_INFO_EXT)
-
-            bool multisampleEnable     = (pMs->rasterizationSamples != 1) &&
-                                         (pInfo->bresenhamEnable == false);
-
-            bool customSampleLocations = ((pPipelineSampleLocationsStateCreateInfoEXT != nullptr) &&
-                                          (pPipelineSampleLocationsStateCreateInfoEXT->sampleLocationsEnable));
-
-            if (multisampleEnable || customSampleLocations)
-            {
-                VK_ASSERT(pRenderPass != nullptr);
+            Util::MetroHash128 hasher;
 
-                uint32_t rasterizationSampleCount   = pMs->rasterizationSamples;
-                uint32_t subpassCoverageSampleCount = pRenderPass->GetSubpassMaxSampleCount(pGraphicsPipelineCreateInfo->subpass);
-                uint32_t subpassColorSampleCount    = pRenderPass->GetSubpassColorSampleCount(pGraphicsPipelineCreateInfo->subpass);
-                uint32_t subpassDepthSampleCount    = pRenderPass->GetSubpassDepthSampleCount(pGraphicsPipelineCreateInfo->subpass);
+            hasher.Update(subStateHashes.rasterization);
+            hasher.Update(dynamicStateMask);
 
-                // subpassCoverageSampleCount would be equal to zero if there are zero attachments.
-                subpassCoverageSampleCount = subpassCoverageSampleCount == 0 ? rasterizationSampleCount : subpassCoverageSampleCount;
-
-                // In case we are rendering to color only, we make sure to set the DepthSampleCount to CoverageSampleCount.
-                // CoverageSampleCount is really the ColorSampleCount in this case. This makes sure we have a consistent
-                // sample count and that we get correct MSAA behavior.
-                // Similar thing for when we are rendering to depth only. The expectation in that case is that all
-                // sample counts should match.
-                // This shouldn't interfere with EQAA. For EQAA, if ColorSampleCount is not equal to DepthSampleCount
-                // and they are both greater than one, then we do not force them to match.
-                subpassColorSampleCount = subpassColorSampleCount == 0 ? subpassCoverageSampleCount : subpassColorSampleCount;
-                subpassDepthSampleCount = subpassDepthSampleCount == 0 ? subpassCoverageSampleCount : subpassDepthSampleCount;
-
-                VK_ASSERT(rasterizationSampleCount == subpassCoverageSampleCount);
+            hasher.Finalize(rsHash.bytes);
+        }
 
-                pInfo->msaa.coverageSamples = subpassCoverageSampleCount;
-                pInfo->msaa.exposedSamples  = subpassCoverageSampleCount;
+        if ((rsCacheable == false) || (pSubStateCache->Find(rsHash, &rsBlock) == false))
+        {
+            BuildRasterizationState(pDevice, pRs, dynamicStateFlags, &rsBlock);
 
-                if (pMs->sampleShadingEnable && (pMs->minSampleShading > 0.0f))
-                {
-                    pInfo->msaa.pixelShaderSamples =
-                        Pow2Pad(static_cast<uint32_t>(ceil(subpassColorSampleCount * pMs->minSampleShading)));
-                }
-                else
-                {
-                    pInfo->msaa.pixelShaderSamples = 1;
-                }
+            if (rsCacheable)
+            {
+                pSubStateCache->Insert(rsHash, rsBlock);
+            }
+        }
 
-                pInfo->msaa.depthStencilSamples = subpassDepthSampleCount;
-                pInfo->msaa.shaderExportMaskSamples = subpassCoverageSampleCount;
-                pInfo->msaa.sampleMask = (pMs->pSampleMask != nullptr)
-                                         ? pMs->pSampleMask[0]
-                                         : 0xffffffff;
-                pInfo->msaa.sampleClusters         = subpassCoverageSampleCount;
-                pInfo->msaa.alphaToCoverageSamples = subpassCoverageSampleCount;
-                pInfo->msaa.occlusionQuerySamples  = subpassDepthSampleCount;
-                pInfo->sampleCoverage              = subpassCoverageSampleCount;
-
-                if (customSampleLocations)
-                {
-                    // Enable single-sampled custom sample locations if necessary
-                    pInfo->msaa.flags.enable1xMsaaSampleLocations = (pInfo->msaa.coverageSamples == 1);
+        GraphicsMultisampleBlock msBlock     = {};
+        Util::MetroHash::Hash    msHash      = {};
+        const bool               msCacheable = (pSubStateCache != nullptr) && (pMs != nullptr) &&
+                                               (pRenderPass != nullptr);
 
-                    if (dynamicStateFlags[static_cast<uint32_t>(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT)] == false)
-                    {
-                        // We store the custom sample locations if custom sample locations are enabled and the
-                        // sample locations state is static.
-                        pInfo->immedInfo.samplePattern.sampleCount =
-                            (uint32_t)pPipelineSampleLocationsStateCreateInfoEXT->sampleLocationsInfo.sampleLocationsPerPixel;
+        if (msCacheable)
+        {
+            Util::MetroHash128 hasher;
 
-                        ConvertToPalMsaaQuadSamplePattern(
-                            &pPipelineSampleLocationsStateCreateInfoEXT->sampleLocationsInfo,
-                            &pInfo->immedInfo.samplePattern.locations);
+            hasher.Update(subStateHashes.multisample);
+            hasher.Update(pRenderPass->GetHash());
+            hasher.Update(subpass);
+            hasher.Update(rsBlock.bresenhamEnable);
+            hasher.Update(dynamicStateMask);
 
-                        VK_ASSERT(pInfo->immedInfo.samplePattern.sampleCount == rasterizationSampleCount);
+            hasher.Finalize(msHash.bytes);
+        }
 
-                        pInfo->staticStateMask |=
-                            (1 << static_cast<uint32_t>(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT));
-                    }
-                }
-                else
-                {
-                    // We store the standard sample locations if custom sample locations are not enabled.
-                    pInfo->immedInfo.samplePattern.sampleCount = rasterizationSampleCount;
-                    pInfo->immedInfo.samplePattern.locations =
-                        *Device::GetDefaultQuadSamplePattern(rasterizationSampleCount);
+        if ((msCacheable == false) || (pSubStateCache->Find(msHash, &msBlock) == false))
+        {
+            BuildMultisampleState(pMs, pRenderPass, subpass, rsBlock.bresenhamEnable, dynamicStateFlags, &msBlock);
 
-                    pInfo->staticStateMask |=
-                        1 << static_cast<uint32_t>(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT);
-                }
+            if (msCacheable)
+            {
+                pSubStateCache->Insert(msHash, msBlock);
             }
-
-            // The alpha component of the fragment's first color output is replaced with one if alphaToOneEnable is set.
-            pInfo->pipeline.cbState.target[0].forceAlphaToOne = (pMs->alphaToOneEnable == VK_TRUE);
-            pInfo->pipeline.cbState.alphaToCoverageEnable     = (pMs->alphaToCoverageEnable == VK_TRUE);
         }
 
-        const VkPipelineColorBlendStateCreateInfo* pCb = pGraphicsPipelineCreateInfo->pColorBlendState;
+        GraphicsColorBlendBlock cbBlock     = {};
+        Util::MetroHash::Hash   cbHash      = {};
+        const bool              cbCacheable = (pSubStateCache != nullptr) && (pCb != nullptr) &&
+                                              (pRenderPass != nullptr);
 
-        bool blendingEnabled = false;
-        bool dualSourceBlend = false;
-
-        if (pCb == nullptr)
+        if (cbCacheable)
         {
-            pInfo->pipeline.cbState.logicOp = Pal::LogicOp::Copy;
-        }
-        else
-        {
-            pInfo->pipeline.cbState.logicOp = (pCb->logicOpEnable) ?
-                                              VkToPalLogicOp(pCb->logicOp) :
-                                              Pal::LogicOp::Copy;
-
-            const uint32_t numColorTargets = Min(pCb->attachmentCount, Pal::MaxColorTargets);
-
-            for (uint32_t i = 0; i < numColorTargets; ++i)
-            {
-                const VkPipelineColorBlendAttachmentState& src = pCb->pAttachments[i];
-
-                auto pCbDst     = &pInfo->pipeline.cbState.target[i];
-                auto pBlendDst  = &pInfo->blend.targets[i];
+            Util::MetroHash128 hasher;
 
-                if (pRenderPass)
-                {
-                    cbFormat[i] = pRenderPass->GetColorAttachmentFormat(pGraphicsPipelineCreateInfo->subpass, i);
-                    pCbDst->swizzledFormat = VkToPalFormat(cbFormat[i]);
-                }
+            hasher.Update(subStateHashes.colorBlend);
+            hasher.Update(pRenderPass->GetHash());
+            hasher.Update(subpass);
+            hasher.Update(dynamicStateMask);
 
-                // If the sub pass attachment format is UNDEFINED, then it means that that subpass does not
-                // want to write to any attachment for that output (VK_ATTACHMENT_UNUSED).  Under such cases,
-                // disable shader writes through that target.
-                if (pCbDst->swizzledFormat.format != Pal::ChNumFormat::Undefined)
-                {
-                    pCbDst->channelWriteMask         = src.colorWriteMask;
-                    blendingEnabled |= (src.blendEnable == VK_TRUE);
-                }
+            hasher.Finalize(cbHash.bytes);
+        }
 
-                pBlendDst->blendEnable    = (src.blendEnable == VK_TRUE);
-                pBlendDst->srcBlendColor  = VkToPalBlend(src.srcColorBlendFactor);
-                pBlendDst->dstBlendColor  = VkToPalBlend(src.dstColorBlendFactor);
-                pBlendDst->blendFuncColor = VkToPalBlendFunc(src.colorBlendOp);
-                pBlendDst->srcBlendAlpha  = VkToPalBlend(src.srcAlphaBlendFactor);
-                pBlendDst->dstBlendAlpha  = VkToPalBlend(src.dstAlphaBlendFactor);
-                pBlendDst->blendFuncAlpha = VkToPalBlendFunc(src.alphaBlendOp);
+        if ((cbCacheable == false) || (pSubStateCache->Find(cbHash, &cbBlock) == false))
+        {
+            BuildColorBlendState(pCb, pRenderPass, subpass, dynamicStateFlags, &cbBlock);
 
-                dualSourceBlend |= GetDualSourceBlendEnableState(src);
+            if (cbCacheable)
+            {
+                pSubStateCache->Insert(cbHash, cbBlock);
             }
         }
 
-        pInfo->pipeline.cbState.dualSourceBlendEnable     = dualSourceBlend;
+        ApplyMultisampleState(msBlock, pInfo);
+        ApplyRasterizationState(rsBlock, pInfo);
+        ApplyColorBlendState(cbBlock, pInfo);
+
+        pInfo->pipeline.rsState.pointCoordOrigin       = Pal::PointOrigin::UpperLeft;
+        pInfo->pipeline.rsState.shadeMode              = Pal::ShadeMode::Flat;
+        pInfo->pipeline.rsState.rasterizeLastLinePixel = 0;
 
-        if (blendingEnabled == true && dynamicStateFlags[VK_DYNAMIC_STATE_BLEND_CONSTANTS] == false)
+        // Pipeline Binning Override
+        switch (settings.pipelineBinningMode)
         {
-            static_assert(sizeof(pInfo->immedInfo.blendConstParams) == sizeof(pCb->blendConstants),
-                "Blend constant structure size mismatch!");
+        case PipelineBinningModeEnable:
+            pInfo->pipeline.rsState.binningOverride = Pal::BinningOverride::Enable;
+            break;
 
-            memcpy(&pInfo->immedInfo.blendConstParams, pCb->blendConstants, sizeof(pCb->blendConstants));
+        case PipelineBinningModeDisable:
+            pInfo->pipeline.rsState.binningOverride = Pal::BinningOverride::Disable;
+            break;
 
-            pInfo->staticStateMask |= 1 << VK_DYNAMIC_STATE_BLEND_CONSTANTS;
+        case PipelineBinningModeDefault:
+        default:
+            pInfo->pipeline.rsState.binningOverride = Pal::BinningOverride::Default;
+            break;
         }
 
         VkFormat dbFormat = { };
@@ -1240,18 +1473,36 @@ VkResult GraphicsPipeline::Create(
     Util::MetroHash::Hash       cacheId[MaxPalDevices]             = {};
     Pal::Result                 palResult                          = Pal::Result::Success;
     PipelineCompiler*           pDefaultCompiler                   = pDevice->GetCompiler(DefaultDeviceIndex);
-    uint64_t                    apiPsoHash                         = BuildApiHash(pCreateInfo,
-                                                                        &binaryCreateInfo.basePipelineHash);
+    SubStateHashes              subStateHashes                     = {};
     Util::MetroHash64           palPipelineHasher;
+    PipelineCreationProfiler*   pProfiler                          = pDevice->GetPipelineCreationProfiler();
+    PipelineCreationTimes*      pCreationTimes                     = &binaryCreateInfo.creationTimes;
+
+    // The sub-state hashes are only needed to look up the sub-state cache
+    SubStateHashes* pSubStateHashes = pDevice->GetRuntimeSettings().enableGraphicsSubStateCache ? &subStateHashes :
+                                                                                                  nullptr;
+
+    int64_t  phaseStart = pProfiler->StartPhase();
+    uint64_t apiPsoHash = BuildApiHash(pCreateInfo, &binaryCreateInfo.basePipelineHash, pSubStateHashes);
+    pProfiler->EndPhase(PipelineCreationPhase::Hash, phaseStart, pCreationTimes);
 
     const VkPipelineCreationFeedbackCreateInfoEXT* pPipelineCreationFeadbackCreateInfo = nullptr;
 
+    phaseStart = pProfiler->StartPhase();
     VkResult result = pDefaultCompiler->ConvertGraphicsPipelineInfo(
         pDevice, pCreateInfo, &binaryCreateInfo, &vbInfo, &pPipelineCreationFeadbackCreateInfo);
-    ConvertGraphicsPipelineInfo(pDevice, pCreateInfo, &vbInfo, &localPipelineInfo);
+    ConvertGraphicsPipelineInfo(pDevice, pCreateInfo, &vbInfo, subStateHashes, &localPipelineInfo);
+    pProfiler->EndPhase(PipelineCreationPhase::Convert, phaseStart, pCreationTimes);
 
     const uint32_t numPalDevices = pDevice->NumPalDevices();
+
+    phaseStart = pProfiler->StartPhase();
     uint64_t pipelineHash = Vkgc::IPipelineDumper::GetPipelineHash(&binaryCreateInfo.pipelineInfo);
+    pProfiler->EndPhase(PipelineCreationPhase::Hash, phaseStart, pCreationTimes);
+
+    // Let the compiler reuse the pipeline hash instead of computing it again
+    binaryCreateInfo.pipelineHash = pipelineHash;
+
     for (uint32_t i = 0; (result == VK_SUCCESS) && (i < numPalDevices); ++i)
     {
         if (i == DefaultDeviceIndex)
@@ -1273,6 +1524,9 @@ VkResult GraphicsPipeline::Create(
             pDefaultCompiler->ConvertGraphicsPipelineInfo(
                     pDevice, pCreateInfo, &binaryCreateInfoMGPU, &vbInfoMGPU, nullptr);
 
+            // The conversion is identical to the one for the default device
+            binaryCreateInfoMGPU.pipelineHash = pipelineHash;
+
             result = pDevice->GetCompiler(i)->CreateGraphicsPipelineBinary(
                 pDevice,
                 i,
@@ -1307,28 +1561,79 @@ VkResult GraphicsPipeline::Create(
 
     RenderStateCache* pRSCache = pDevice->GetRenderStateCache();
 
+    // Look for PAL pipelines created from the same binaries by an earlier pipeline
+    PalPipelineTable*  pPipelineTable  = pDevice->GetPalPipelineTable();
+    SharedPalPipeline* pSharedPipeline = nullptr;
+    bool               createPalObject = true;
+
+    Util::MetroHash::Hash palPipelineKey = {};
+
+    if ((result == VK_SUCCESS) && pPipelineTable->IsEnabled())
+    {
+        Util::MetroHash128 keyHasher;
+
+        keyHasher.Update(localPipelineInfo.pipeline);
+
+        pPipelineTable->BuildKey(&keyHasher, cacheId, pipelineBinarySizes, pPipelineBinaries, &palPipelineKey);
+
+        pSharedPipeline = pPipelineTable->Find(palPipelineKey);
+        createPalObject = (pSharedPipeline == nullptr);
+    }
+
     // Get the pipeline size from PAL and allocate memory.
     void*  pSystemMem = nullptr;
+    void*  pPalMem    = nullptr;
     size_t palSize    = 0;
 
     if (result == VK_SUCCESS)
     {
-        localPipelineInfo.pipeline.pipelineBinarySize = pipelineBinarySizes[DefaultDeviceIndex];
-        localPipelineInfo.pipeline.pPipelineBinary    = pPipelineBinaries[DefaultDeviceIndex];
+        size_t palMemSize = 0;
 
-        palSize =
-            pDevice->PalDevice(DefaultDeviceIndex)->GetGraphicsPipelineSize(localPipelineInfo.pipeline, &palResult);
-        VK_ASSERT(palResult == Pal::Result::Success);
+        if (createPalObject)
+        {
+            localPipelineInfo.pipeline.pipelineBinarySize = pipelineBinarySizes[DefaultDeviceIndex];
+            localPipelineInfo.pipeline.pPipelineBinary    = pPipelineBinaries[DefaultDeviceIndex];
 
-        pSystemMem = pAllocator->pfnAllocation(
-            pAllocator->pUserData,
-            sizeof(GraphicsPipeline) + (palSize * numPalDevices),
-            VK_DEFAULT_MEM_ALIGN,
-            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            palSize =
+                pDevice->PalDevice(DefaultDeviceIndex)->GetGraphicsPipelineSize(localPipelineInfo.pipeline, &palResult);
+            VK_ASSERT(palResult == Pal::Result::Success);
+
+            // Shared PAL objects live in their table entry instead of in the pipeline
+            if (pPipelineTable->IsEnabled())
+            {
+                pSharedPipeline = pPipelineTable->AllocPipeline(palPipelineKey, palSize);
+
+                if (pSharedPipeline != nullptr)
+                {
+                    pPalMem = pSharedPipeline->pPalMemory;
+                }
+                else
+                {
+                    result = VK_ERROR_OUT_OF_HOST_MEMORY;
+                }
+            }
+            else
+            {
+                palMemSize = palSize * numPalDevices;
+            }
+        }
 
-        if (pSystemMem == nullptr)
+        if (result == VK_SUCCESS)
         {
-            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+            pSystemMem = pAllocator->pfnAllocation(
+                pAllocator->pUserData,
+                sizeof(GraphicsPipeline) + palMemSize,
+                VK_DEFAULT_MEM_ALIGN,
+                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+            if (pSystemMem == nullptr)
+            {
+                result = VK_ERROR_OUT_OF_HOST_MEMORY;
+            }
+            else if (pPalMem == nullptr)
+            {
+                pPalMem = Util::VoidPtrInc(pSystemMem, sizeof(GraphicsPipeline));
+            }
         }
     }
 
@@ -1340,13 +1645,17 @@ VkResult GraphicsPipeline::Create(
 
     if (result == VK_SUCCESS)
     {
-        size_t palOffset = sizeof(GraphicsPipeline);
+        size_t palOffset = 0;
 
         for (uint32_t deviceIdx = 0; deviceIdx < numPalDevices; deviceIdx++)
         {
             Pal::IDevice* pPalDevice = pDevice->PalDevice(deviceIdx);
 
-            if (palResult == Pal::Result::Success)
+            if ((palResult == Pal::Result::Success) && (createPalObject == false))
+            {
+                pPalPipeline[deviceIdx] = pSharedPipeline->pPipelines[deviceIdx];
+            }
+            else if (palResult == Pal::Result::Success)
             {
                 // If pPipelineBinaries[DefaultDeviceIndex] is sufficient for all devices, the other pipeline binaries
                 // won't be created.  Otherwise, like if gl_DeviceIndex is used, they will be.
@@ -1356,9 +1665,11 @@ VkResult GraphicsPipeline::Create(
                     localPipelineInfo.pipeline.pPipelineBinary    = pPipelineBinaries[deviceIdx];
                 }
 
+                phaseStart = pProfiler->StartPhase();
+
                 palResult = pPalDevice->CreateGraphicsPipeline(
                     localPipelineInfo.pipeline,
-                    Util::VoidPtrInc(pSystemMem, palOffset),
+                    Util::VoidPtrInc(pPalMem, palOffset),
                     &pPalPipeline[deviceIdx]);
 
 #if ICD_GPUOPEN_DEVMODE_BUILD
@@ -1383,7 +1694,7 @@ VkResult GraphicsPipeline::Create(
 
                         palResult = pPalDevice->CreateGraphicsPipeline(
                             localPipelineInfo.pipeline,
-                            Util::VoidPtrInc(pSystemMem, palOffset),
+                            Util::VoidPtrInc(pPalMem, palOffset),
                             &pPalPipeline[deviceIdx]);
                     }
                     else if (palResult == Util::Result::NotFound)
@@ -1394,10 +1705,14 @@ VkResult GraphicsPipeline::Create(
                 }
 #endif
 
+                pProfiler->EndPhase(PipelineCreationPhase::CreatePalPipeline, phaseStart, pCreationTimes);
+
                 VK_ASSERT(palSize == pPalDevice->GetGraphicsPipelineSize(localPipelineInfo.pipeline, nullptr));
                 palOffset += palSize;
             }
 
+            phaseStart = pProfiler->StartPhase();
+
             // Create the PAL MSAA state object
             if (palResult == Pal::Result::Success)
             {
@@ -1441,6 +1756,27 @@ VkResult GraphicsPipeline::Create(
                     VK_SYSTEM_ALLOCATION_SCOPE_OBJECT,
                     pPalDepthStencil);
             }
+
+            pProfiler->EndPhase(PipelineCreationPhase::CreateStaticState, phaseStart, pCreationTimes);
+        }
+
+        if (createPalObject && (pSharedPipeline != nullptr))
+        {
+            // The entry now owns whatever PAL objects were created
+            for (uint32_t deviceIdx = 0; deviceIdx < numPalDevices; deviceIdx++)
+            {
+                pSharedPipeline->pPipelines[deviceIdx] = pPalPipeline[deviceIdx];
+            }
+
+            if (palResult == Pal::Result::Success)
+            {
+                pSharedPipeline = pPipelineTable->Insert(pSharedPipeline);
+
+                for (uint32_t deviceIdx = 0; deviceIdx < numPalDevices; deviceIdx++)
+                {
+                    pPalPipeline[deviceIdx] = pSharedPipeline->pPipelines[deviceIdx];
+                }
+            }
         }
 
         result = PalToVkResult(palResult);
@@ -1469,6 +1805,7 @@ VkResult GraphicsPipeline::Create(
         VK_PLACEMENT_NEW(pSystemMem) GraphicsPipeline(
             pDevice,
             pPalPipeline,
+            pSharedPipeline,
             localPipelineInfo.pLayout,
             localPipelineInfo.immedInfo,
             localPipelineInfo.staticStateMask,
@@ -1503,11 +1840,18 @@ VkResult GraphicsPipeline::Create(
         pRSCache->DestroyDepthStencilState(pPalDepthStencil, pAllocator);
 
         // Something went wrong with creating the PAL object. Free memory and return error.
-        for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
+        if (pSharedPipeline != nullptr)
+        {
+            pPipelineTable->Release(pSharedPipeline);
+        }
+        else
         {
-            if (pPalPipeline[deviceIdx] != nullptr)
+            for (uint32_t deviceIdx = 0; deviceIdx < pDevice->NumPalDevices(); deviceIdx++)
             {
-                pPalPipeline[deviceIdx]->Destroy();
+                if (pPalPipeline[deviceIdx] != nullptr)
+                {
+                    pPalPipeline[deviceIdx]->Destroy();
+                }
             }
         }
 
@@ -1527,6 +1871,9 @@ VkResult GraphicsPipeline::Create(
             pPipelineCreationFeadbackCreateInfo,
             &binaryCreateInfo.pipelineFeedback);
 
+        pCreationTimes->Add(PipelineCreationPhase::Total, duration);
+        pProfiler->Record(*pCreationTimes);
+
         const RuntimeSettings& settings = pDevice->GetRuntimeSettings();
         // The hash is same as pipline dump file name, we can easily analyze further.
         AmdvlkLog(settings.logTagIdMask, PipelineCompileTime, "0x%016llX-%llu", pipelineHash, duration);
@@ -1539,6 +1886,7 @@ VkResult GraphicsPipeline::Create(
 GraphicsPipeline::GraphicsPipeline(
     Device* const                          pDevice,
     Pal::IPipeline**                       pPalPipeline,
+    SharedPalPipeline*                     pSharedPalPipeline,
     const PipelineLayout*                  pLayout,
     const ImmedInfo&                       immedInfo,
     uint32_t                               staticStateMask,
@@ -1556,9 +1904,12 @@ GraphicsPipeline::GraphicsPipeline(
     m_info(immedInfo),
     m_vbInfo(vbInfo),
     m_coverageSamples(coverageSamples),
+    m_bindId(pDevice->AllocGraphicsPipelineBindId()),
     m_flags()
 {
-    Pipeline::Init(pPalPipeline, pLayout, pBinary, staticStateMask, apiHash);
+    Pipeline::Init(pPalPipeline, pSharedPalPipeline, pLayout, pBinary, staticStateMask, apiHash);
+
+    memset(const_cast<uint64_t*>(m_bindDeltaCache), 0, sizeof(m_bindDeltaCache));
 
     m_flags.viewIndexFromDeviceIndex = viewIndexFromDeviceIndex;
 
@@ -1690,6 +2041,126 @@ GraphicsPipeline::~GraphicsPipeline()
 
 }
 
+// =====================================================================================================================
+// Computes which state groups have to be redundancy checked when this pipeline is bound right after the given one.
+// A static group can only be skipped if the previous pipeline also programmed it statically with the same token.
+uint32_t GraphicsPipeline::ComputeBindDelta(
+    const GraphicsPipeline* pPrevPipeline) const
+{
+    const auto& prevTokens = pPrevPipeline->m_info.staticTokens;
+    const auto& newTokens  = m_info.staticTokens;
+
+    uint32_t delta = 0;
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::VIEWPORT) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.viewport, newTokens.viewport))
+    {
+        delta |= BindDeltaViewport;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::SCISSOR) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.scissorRect, newTokens.scissorRect))
+    {
+        delta |= BindDeltaScissor;
+    }
+
+    if (pPrevPipeline->PalPipelineHash() != PalPipelineHash())
+    {
+        delta |= BindDeltaPipeline;
+    }
+
+    for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); deviceIdx++)
+    {
+        if (pPrevPipeline->m_pPalDepthStencil[deviceIdx] != m_pPalDepthStencil[deviceIdx])
+        {
+            delta |= BindDeltaDepthStencil;
+        }
+
+        if (pPrevPipeline->m_pPalColorBlend[deviceIdx] != m_pPalColorBlend[deviceIdx])
+        {
+            delta |= BindDeltaColorBlend;
+        }
+
+        if (pPrevPipeline->m_pPalMsaa[deviceIdx] != m_pPalMsaa[deviceIdx])
+        {
+            delta |= BindDeltaMsaa;
+        }
+    }
+
+    if (CmdBuffer::IsStaticStateDifferent(prevTokens.inputAssemblyState, newTokens.inputAssemblyState))
+    {
+        delta |= BindDeltaInputAssembly;
+    }
+
+    if (CmdBuffer::IsStaticStateDifferent(prevTokens.triangleRasterState, newTokens.triangleRasterState))
+    {
+        delta |= BindDeltaTriangleRaster;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::LINE_WIDTH) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.pointLineRasterState, newTokens.pointLineRasterState))
+    {
+        delta |= BindDeltaPointLineRaster;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::LINE_STIPPLE_EXT) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.lineStippleState, newTokens.lineStippleState))
+    {
+        delta |= BindDeltaLineStipple;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::DEPTH_BIAS) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.depthBias, newTokens.depthBias))
+    {
+        delta |= BindDeltaDepthBias;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::BLEND_CONSTANTS) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.blendConst, newTokens.blendConst))
+    {
+        delta |= BindDeltaBlendConst;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::DEPTH_BOUNDS) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.depthBounds, newTokens.depthBounds))
+    {
+        delta |= BindDeltaDepthBounds;
+    }
+
+    if ((pPrevPipeline->ContainsStaticState(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT) == false) ||
+        CmdBuffer::IsStaticStateDifferent(prevTokens.samplePattern, newTokens.samplePattern))
+    {
+        delta |= BindDeltaSamplePattern;
+    }
+
+    return delta;
+}
+
+// =====================================================================================================================
+// Returns the bind delta from the given previous pipeline to this one, computing and memoizing it on a cache miss.
+uint32_t GraphicsPipeline::GetBindDelta(
+    const GraphicsPipeline* pPrevPipeline) const
+{
+    const uint32_t     prevBindId = pPrevPipeline->m_bindId;
+    volatile uint64_t* pEntry     = &m_bindDeltaCache[prevBindId % BindDeltaCacheSize];
+    const uint64_t     entry      = *pEntry;
+
+    uint32_t delta;
+
+    if (static_cast<uint32_t>(entry >> 32) == prevBindId)
+    {
+        delta = static_cast<uint32_t>(entry);
+    }
+    else
+    {
+        delta = ComputeBindDelta(pPrevPipeline);
+
+        Util::AtomicExchange64(pEntry, (static_cast<uint64_t>(prevBindId) << 32) | delta);
+    }
+
+    return delta;
+}
+
 // =====================================================================================================================
 // Binds this graphics pipeline's state to the given command buffer (using waveLimits created from the pipeline)
 void GraphicsPipeline::BindToCmdBuffer(
@@ -1714,6 +2185,14 @@ void GraphicsPipeline::BindToCmdBuffer(
     // Get the old static tokens.  Copy these by value because in MGPU cases we update the new token state in a loop.
     const auto oldTokens = pRenderState->allGpuState.staticTokens;
 
+    // If the state programmed by the previous pipeline has not been touched since it was bound, only the state groups
+    // in the memoized delta from that pipeline can differ.  Otherwise every group is redundancy checked.
+    const GraphicsPipeline* pPrevPipeline = pRenderState->allGpuState.pDeltaBasePipeline;
+
+    VK_ASSERT((pPrevPipeline == nullptr) || (pPrevPipeline == pRenderState->allGpuState.pGraphicsPipeline));
+
+    const uint32_t bindDelta = (pPrevPipeline != nullptr) ? GetBindDelta(pPrevPipeline) : BindDeltaAll;
+
     // Program static pipeline state.
 
     // This code will attempt to skip programming state state based on redundant value checks.  These checks are often
@@ -1722,7 +2201,8 @@ void GraphicsPipeline::BindToCmdBuffer(
     // If VIEWPORT is static, VIEWPORT_COUNT must be static as well
     if (ContainsStaticState(DynamicStatesInternal::VIEWPORT))
     {
-        if (CmdBuffer::IsStaticStateDifferent(oldTokens.viewports, newTokens.viewport))
+        if (((bindDelta & BindDeltaViewport) != 0) &&
+            CmdBuffer::IsStaticStateDifferent(oldTokens.viewports, newTokens.viewport))
         {
             pCmdBuffer->SetAllViewports(m_info.viewportParams, newTokens.viewport);
         }
@@ -1741,7 +2221,8 @@ void GraphicsPipeline::BindToCmdBuffer(
 
     if (ContainsStaticState(DynamicStatesInternal::SCISSOR))
     {
-        if (CmdBuffer::IsStaticStateDifferent(oldTokens.scissorRect, newTokens.scissorRect))
+        if (((bindDelta & BindDeltaScissor) != 0) &&
+            CmdBuffer::IsStaticStateDifferent(oldTokens.scissorRect, newTokens.scissorRect))
         {
             pCmdBuffer->SetAllScissors(m_info.scissorRectParams, newTokens.scissorRect);
         }
@@ -1758,20 +2239,35 @@ void GraphicsPipeline::BindToCmdBuffer(
         pRenderState->allGpuState.dirty.scissor = 1;
     }
 
-    utils::IterateMask deviceGroup(pCmdBuffer->GetDeviceMask());
-    do
+    if ((bindDelta & BindDeltaPerDevice) != 0)
     {
-        const uint32_t deviceIdx = deviceGroup.Index();
+        utils::IterateMask deviceGroup(pCmdBuffer->GetDeviceMask());
+        do
+        {
+            const uint32_t deviceIdx = deviceGroup.Index();
 
-        Pal::ICmdBuffer* pPalCmdBuf = pCmdBuffer->PalCmdBuffer(deviceIdx);
+            Pal::ICmdBuffer* pPalCmdBuf = pCmdBuffer->PalCmdBuffer(deviceIdx);
 
-        if (pRenderState->allGpuState.pGraphicsPipeline != nullptr)
-        {
-            const uint64_t oldHash = pRenderState->allGpuState.pGraphicsPipeline->PalPipelineHash();
-            const uint64_t newHash = PalPipelineHash();
+            if (pRenderState->allGpuState.pGraphicsPipeline != nullptr)
+            {
+                const uint64_t oldHash = pRenderState->allGpuState.pGraphicsPipeline->PalPipelineHash();
+                const uint64_t newHash = PalPipelineHash();
+
+                if (((bindDelta & BindDeltaPipeline) != 0) &&
+                    (oldHash != newHash))
+                {
+                    Pal::PipelineBindParams params = {};
+                    params.pipelineBindPoint = Pal::PipelineBindPoint::Graphics;
+                    params.pPipeline         = m_pPalPipeline[deviceIdx];
+                    params.graphics          = graphicsShaderInfos;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 471
+                    params.apiPsoHash = m_apiHash;
+#endif
 
-            if ((oldHash != newHash)
-                )
+                    pPalCmdBuf->CmdBindPipeline(params);
+                }
+            }
+            else
             {
                 Pal::PipelineBindParams params = {};
                 params.pipelineBindPoint = Pal::PipelineBindPoint::Graphics;
@@ -1783,83 +2279,91 @@ void GraphicsPipeline::BindToCmdBuffer(
 
                 pPalCmdBuf->CmdBindPipeline(params);
             }
-        }
-        else
-        {
-            Pal::PipelineBindParams params = {};
-            params.pipelineBindPoint = Pal::PipelineBindPoint::Graphics;
-            params.pPipeline         = m_pPalPipeline[deviceIdx];
-            params.graphics          = graphicsShaderInfos;
-#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 471
-            params.apiPsoHash = m_apiHash;
-#endif
 
-            pPalCmdBuf->CmdBindPipeline(params);
-        }
+            // Bind state objects that are always static; these are redundancy checked by the pointer in the command
+            // buffer.
+            if ((bindDelta & BindDeltaDepthStencil) != 0)
+            {
+                pCmdBuffer->PalCmdBindDepthStencilState(pPalCmdBuf, deviceIdx, m_pPalDepthStencil[deviceIdx]);
+            }
 
-        // Bind state objects that are always static; these are redundancy checked by the pointer in the command buffer.
-        pCmdBuffer->PalCmdBindDepthStencilState(pPalCmdBuf, deviceIdx, m_pPalDepthStencil[deviceIdx]);
-        pCmdBuffer->PalCmdBindColorBlendState(pPalCmdBuf, deviceIdx, m_pPalColorBlend[deviceIdx]);
-        pCmdBuffer->PalCmdBindMsaaState(pPalCmdBuf, deviceIdx, m_pPalMsaa[deviceIdx]);
+            if ((bindDelta & BindDeltaColorBlend) != 0)
+            {
+                pCmdBuffer->PalCmdBindColorBlendState(pPalCmdBuf, deviceIdx, m_pPalColorBlend[deviceIdx]);
+            }
 
-        // Write parameters that are marked static pipeline state.  Redundancy check these based on static tokens:
-        // skip the write if the previously written static token matches.
-        if (CmdBuffer::IsStaticStateDifferent(oldTokens.inputAssemblyState, newTokens.inputAssemblyState))
-        {
-            pPalCmdBuf->CmdSetInputAssemblyState(m_info.inputAssemblyState);
-            pRenderState->allGpuState.staticTokens.inputAssemblyState = newTokens.inputAssemblyState;
-        }
+            if ((bindDelta & BindDeltaMsaa) != 0)
+            {
+                pCmdBuffer->PalCmdBindMsaaState(pPalCmdBuf, deviceIdx, m_pPalMsaa[deviceIdx]);
+            }
 
-        if (CmdBuffer::IsStaticStateDifferent(oldTokens.triangleRasterState, newTokens.triangleRasterState))
-        {
-            pPalCmdBuf->CmdSetTriangleRasterState(m_info.triangleRasterState);
-            pRenderState->allGpuState.staticTokens.triangleRasterState = newTokens.triangleRasterState;
-        }
+            // Write parameters that are marked static pipeline state.  Redundancy check these based on static tokens:
+            // skip the write if the previously written static token matches.
+            if (((bindDelta & BindDeltaInputAssembly) != 0) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.inputAssemblyState, newTokens.inputAssemblyState))
+            {
+                pPalCmdBuf->CmdSetInputAssemblyState(m_info.inputAssemblyState);
+                pRenderState->allGpuState.staticTokens.inputAssemblyState = newTokens.inputAssemblyState;
+            }
 
-        if (ContainsStaticState(DynamicStatesInternal::LINE_WIDTH) &&
-            CmdBuffer::IsStaticStateDifferent(oldTokens.pointLineRasterState, newTokens.pointLineRasterState))
-        {
-            pPalCmdBuf->CmdSetPointLineRasterState(m_info.pointLineRasterParams);
-            pRenderState->allGpuState.staticTokens.pointLineRasterState = newTokens.pointLineRasterState;
-        }
+            if (((bindDelta & BindDeltaTriangleRaster) != 0) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.triangleRasterState, newTokens.triangleRasterState))
+            {
+                pPalCmdBuf->CmdSetTriangleRasterState(m_info.triangleRasterState);
+                pRenderState->allGpuState.staticTokens.triangleRasterState = newTokens.triangleRasterState;
+            }
 
-        if (ContainsStaticState(DynamicStatesInternal::LINE_STIPPLE_EXT) &&
-            CmdBuffer::IsStaticStateDifferent(oldTokens.lineStippleState, newTokens.lineStippleState))
-        {
-            pPalCmdBuf->CmdSetLineStippleState(m_info.lineStippleParams);
-            pRenderState->allGpuState.staticTokens.lineStippleState = newTokens.lineStippleState;
-        }
+            if (((bindDelta & BindDeltaPointLineRaster) != 0) &&
+                ContainsStaticState(DynamicStatesInternal::LINE_WIDTH) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.pointLineRasterState, newTokens.pointLineRasterState))
+            {
+                pPalCmdBuf->CmdSetPointLineRasterState(m_info.pointLineRasterParams);
+                pRenderState->allGpuState.staticTokens.pointLineRasterState = newTokens.pointLineRasterState;
+            }
 
-        if (ContainsStaticState(DynamicStatesInternal::DEPTH_BIAS) &&
-            CmdBuffer::IsStaticStateDifferent(oldTokens.depthBiasState, newTokens.depthBias))
-        {
-            pPalCmdBuf->CmdSetDepthBiasState(m_info.depthBiasParams);
-            pRenderState->allGpuState.staticTokens.depthBiasState = newTokens.depthBias;
-        }
+            if (((bindDelta & BindDeltaLineStipple) != 0) &&
+                ContainsStaticState(DynamicStatesInternal::LINE_STIPPLE_EXT) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.lineStippleState, newTokens.lineStippleState))
+            {
+                pPalCmdBuf->CmdSetLineStippleState(m_info.lineStippleParams);
+                pRenderState->allGpuState.staticTokens.lineStippleState = newTokens.lineStippleState;
+            }
 
-        if (ContainsStaticState(DynamicStatesInternal::BLEND_CONSTANTS) &&
-            CmdBuffer::IsStaticStateDifferent(oldTokens.blendConst, newTokens.blendConst))
-        {
-            pPalCmdBuf->CmdSetBlendConst(m_info.blendConstParams);
-            pRenderState->allGpuState.staticTokens.blendConst = newTokens.blendConst;
-        }
+            if (((bindDelta & BindDeltaDepthBias) != 0) &&
+                ContainsStaticState(DynamicStatesInternal::DEPTH_BIAS) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.depthBiasState, newTokens.depthBias))
+            {
+                pPalCmdBuf->CmdSetDepthBiasState(m_info.depthBiasParams);
+                pRenderState->allGpuState.staticTokens.depthBiasState = newTokens.depthBias;
+            }
 
-        if (ContainsStaticState(DynamicStatesInternal::DEPTH_BOUNDS) &&
-            CmdBuffer::IsStaticStateDifferent(oldTokens.depthBounds, newTokens.depthBounds))
-        {
-            pPalCmdBuf->CmdSetDepthBounds(m_info.depthBoundParams);
-            pRenderState->allGpuState.staticTokens.depthBounds = newTokens.depthBounds;
-        }
+            if (((bindDelta & BindDeltaBlendConst) != 0) &&
+                ContainsStaticState(DynamicStatesInternal::BLEND_CONSTANTS) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.blendConst, newTokens.blendConst))
+            {
+                pPalCmdBuf->CmdSetBlendConst(m_info.blendConstParams);
+                pRenderState->allGpuState.staticTokens.blendConst = newTokens.blendConst;
+            }
 
-        if (ContainsStaticState(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT) &&
-            CmdBuffer::IsStaticStateDifferent(oldTokens.samplePattern, newTokens.samplePattern))
-        {
-            pCmdBuffer->PalCmdSetMsaaQuadSamplePattern(
-                m_info.samplePattern.sampleCount, m_info.samplePattern.locations);
-            pRenderState->allGpuState.staticTokens.samplePattern = newTokens.samplePattern;
+            if (((bindDelta & BindDeltaDepthBounds) != 0) &&
+                ContainsStaticState(DynamicStatesInternal::DEPTH_BOUNDS) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.depthBounds, newTokens.depthBounds))
+            {
+                pPalCmdBuf->CmdSetDepthBounds(m_info.depthBoundParams);
+                pRenderState->allGpuState.staticTokens.depthBounds = newTokens.depthBounds;
+            }
+
+            if (((bindDelta & BindDeltaSamplePattern) != 0) &&
+                ContainsStaticState(DynamicStatesInternal::SAMPLE_LOCATIONS_EXT) &&
+                CmdBuffer::IsStaticStateDifferent(oldTokens.samplePattern, newTokens.samplePattern))
+            {
+                pCmdBuffer->PalCmdSetMsaaQuadSamplePattern(
+                    m_info.samplePattern.sampleCount, m_info.samplePattern.locations);
+                pRenderState->allGpuState.staticTokens.samplePattern = newTokens.samplePattern;
+            }
         }
+        while (deviceGroup.IterateNext());
     }
-    while (deviceGroup.IterateNext());
 
     const bool stencilMasks = ContainsStaticState(DynamicStatesInternal::STENCIL_COMPARE_MASK) |
                               ContainsStaticState(DynamicStatesInternal::STENCIL_WRITE_MASK)   |
@@ -1908,6 +2412,8 @@ void GraphicsPipeline::BindToCmdBuffer(
         // Sync ViewMask state in CommandBuffer.
         pCmdBuffer->SetViewInstanceMask(pCmdBuffer->GetDeviceMask());
     }
+    // The command buffer's static state now matches this pipeline; it is the base for the next pipeline's delta.
+    pRenderState->allGpuState.pDeltaBasePipeline = this;
 }
 
 // =====================================================================================================================
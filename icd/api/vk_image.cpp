@@ -1250,6 +1250,12 @@ static VkDeviceSize CalcBaseAddrSizePadding(
     // types.
     VkDeviceSize minBaseAlignment = device.GetMemoryBaseAddrAlignment(memReqs.memoryTypeBits);
 
+    // Images small enough to fit in a sub-allocated VkMemory can only rely on the sub-allocation alignment
+    if (Memory::IsSubAllocSize(&device, memReqs.size))
+    {
+        minBaseAlignment = Util::Min(minBaseAlignment, MemorySubAllocAlignment);
+    }
+
     // If the base address alignment requirements of the image exceed the base address alignment requirements of
     // the memory object, we need to pad the size of the image by the difference so that we can align the base
     // address at bind-time using an offset.
@@ -1306,12 +1312,21 @@ VkResult Image::BindMemory(
     uint32_t           rectCount,
     const VkRect2D*    pRects)
 {
-    VkMemoryRequirements reqs = {};
+    VkMemoryRequirements reqs    = {};
+    Memory*              pMemory = (mem != VK_NULL_HANDLE) ? Memory::ObjectFromHandle(mem) : nullptr;
+    VkResult             result  = VK_SUCCESS;
 
-    if (GetMemoryRequirements(pDevice, &reqs) == VK_SUCCESS)
+    if (GetMemoryRequirements(pDevice, &reqs) != VK_SUCCESS)
+    {
+        result = VK_ERROR_INITIALIZATION_FAILED;
+    }
+    else if (pMemory != nullptr)
     {
-        Memory* pMemory = (mem != VK_NULL_HANDLE) ? Memory::ObjectFromHandle(mem) : nullptr;
+        result = pMemory->CommitResidency();
+    }
 
+    if (result == VK_SUCCESS)
+    {
         if (m_internalFlags.externallyShareable && (pMemory->GetExternalPalImage() != nullptr))
         {
             // For MGPU, the external sharing resource only uses the first PAL image.
@@ -1320,7 +1335,7 @@ VkResult Image::BindMemory(
             m_internalFlags.boundToExternalMemory = 1;
         }
 
-        Pal::Result result = Pal::Result::Success;
+        Pal::Result palResult = Pal::Result::Success;
 
         const uint32_t numDevices = pDevice->NumPalDevices();
 
@@ -1340,6 +1355,7 @@ VkResult Image::BindMemory(
             Pal::IImage*     pPalImage      = m_perGpu[localDeviceIdx].pPalImage;
             Pal::IGpuMemory* pGpuMem        = nullptr;
             Pal::gpusize     baseAddrOffset = 0;
+            Pal::gpusize     palMemOffset   = 0;
 
             if (pMemory != nullptr)
             {
@@ -1348,7 +1364,10 @@ VkResult Image::BindMemory(
                 // The bind offset within the memory should already be pre-aligned
                 VK_ASSERT(Util::IsPow2Aligned(memOffset, reqs.alignment));
 
-                VkDeviceSize baseGpuAddr = pGpuMem->Desc().gpuVirtAddr;
+                // Sub-allocated memory starts at an offset within its PAL memory object
+                palMemOffset = pMemory->PalOffset();
+
+                VkDeviceSize baseGpuAddr = pGpuMem->Desc().gpuVirtAddr + palMemOffset;
 
                 // If the base address of the VkMemory is not already aligned
                 if ((Util::IsPow2Aligned(baseGpuAddr, reqs.alignment) == false) &&
@@ -1356,7 +1375,7 @@ VkResult Image::BindMemory(
                 {
                     // This should only happen in situations where the image's alignment is extremely larger than
                     // the VkMemory object.
-                    VK_ASSERT(pGpuMem->Desc().alignment < reqs.alignment);
+                    VK_ASSERT((pGpuMem->Desc().alignment < reqs.alignment) || (palMemOffset != 0));
 
                     // Calculate the necessary offset to make the base address align to the image's requirements.
                     baseAddrOffset = Util::Pow2Align(baseGpuAddr, reqs.alignment) - baseGpuAddr;
@@ -1374,9 +1393,9 @@ VkResult Image::BindMemory(
                 }
             }
 
-            result = pPalImage->BindGpuMemory(pGpuMem, baseAddrOffset + memOffset);
+            palResult = pPalImage->BindGpuMemory(pGpuMem, palMemOffset + baseAddrOffset + memOffset);
 
-            if (result == Pal::Result::Success)
+            if (palResult == Pal::Result::Success)
             {
                 // Record the private base address offset.  This is necessary for things like subresource layout
                 // calculation for linear images.
@@ -1384,12 +1403,10 @@ VkResult Image::BindMemory(
             }
         }
 
-        return PalToVkResult(result);
-    }
-    else
-    {
-        return VK_ERROR_INITIALIZATION_FAILED;
+        result = PalToVkResult(palResult);
     }
+
+    return result;
 }
 
 // =====================================================================================================================
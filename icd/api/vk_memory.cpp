@@ -314,7 +314,33 @@ VkResult Memory::Create(
             createInfo.priority       = priority.PalPriority();
             createInfo.priorityOffset = priority.PalOffset();
 
-            if (pPinnedHostPtr == nullptr)
+            const MemoryPriority defaultPriority =
+                MemoryPriority::FromSetting(pDevice->GetRuntimeSettings().memoryPriorityDefault);
+
+            const bool hostVisible = (memoryProperties.memoryTypes[pAllocInfo->memoryTypeIndex].propertyFlags &
+                                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+
+            // Small allocations with default properties share the PAL memory objects of pools instead of each making
+            // a kernel allocation and a residency list entry of their own.  Pools only differ by heap and mapping, so
+            // anything that needs a PAL memory object of its own is excluded.  Sub-allocations reuse memory freed by
+            // the application instead of memory the kernel cleared, so when they must be cleared only host visible
+            // ones, which can be cleared through the pool's mapping, are sub-allocated.
+            const bool zeroInit    = pDevice->GetRuntimeSettings().memorySubAllocZeroInit;
+            const bool subAllocate = IsSubAllocSize(pDevice, createInfo.size)           &&
+                                     (hostVisible || (zeroInit == false))               &&
+                                     (pDevice->NumPalDevices() == 1)                    &&
+                                     (pPinnedHostPtr == nullptr)                        &&
+                                     (createInfo.flags.interprocess == 0)               &&
+                                     (createInfo.vaRange == Pal::VaRange::Default)      &&
+                                     (dedicatedImage == VK_NULL_HANDLE)                 &&
+                                     (dedicatedBuffer == VK_NULL_HANDLE)                &&
+                                     (priority.u32All == defaultPriority.u32All);
+
+            if (subAllocate)
+            {
+                vkResult = CreateSubAllocatedMemory(pDevice, pAllocator, createInfo, hostVisible, &pMemory);
+            }
+            else if (pPinnedHostPtr == nullptr)
             {
                 vkResult = CreateGpuMemory(
                     pDevice,
@@ -342,11 +368,17 @@ VkResult Memory::Create(
 
     if (vkResult == VK_SUCCESS)
     {
-        // Account for committed size in logical device. The destructor will decrease the counter accordingly.
-        pDevice->IncreaseAllocatedMemorySize(pMemory->m_info.size, allocationMask, pMemory->m_info.heaps[0]);
+        // Account for committed size in logical device. The destructor will decrease the counter accordingly.  The
+        // pools of sub-allocations account for their whole size instead.
+        const uint32_t sizeAccountedForDeviceMask = pMemory->m_subAllocated ? 0 : allocationMask;
+
+        if (sizeAccountedForDeviceMask != 0)
+        {
+            pDevice->IncreaseAllocatedMemorySize(pMemory->m_info.size, allocationMask, pMemory->m_info.heaps[0]);
+        }
 
         // Notify the memory object that it is counted so that the destructor can decrease the counter accordingly
-        pMemory->SetAllocationCounted(allocationMask);
+        pMemory->SetAllocationCounted(sizeAccountedForDeviceMask);
 
         *pMemoryHandle = Memory::HandleFromObject(pMemory);
 
@@ -376,7 +408,7 @@ VkResult Memory::Create(
             bindData.pObj               = pMemory;
             bindData.pGpuMemory         = pPalGpuMem;
             bindData.requiredGpuMemSize = pMemory->PalInfo().size;
-            bindData.offset             = 0;
+            bindData.offset             = pMemory->PalOffset();
 
             pDevice->VkInstance()->PalPlatform()->LogEvent(
                 Pal::PalEvent::GpuMemoryResourceBind,
@@ -442,6 +474,15 @@ VkResult Memory::CreateGpuMemory(
 
     GetPrimaryDeviceIndex(pDevice->NumPalDevices(), allocationMask, &primaryIndex, &multiInstance);
 
+    // Device local memory that is neither shared with other processes nor instanced on several devices can be added to
+    // the residency list when it is first bound or mapped instead of now, which keeps mostly unused pools out of every
+    // submission's residency list.  PAL still backs the memory here, so it counts towards its heap's usage regardless.
+    const bool lazyResidency = pDevice->GetRuntimeSettings().enableLazyMemoryResidency &&
+                               (multiInstance == false)                                 &&
+                               (createInfo.flags.interprocess == 0)                     &&
+                               ((createInfo.heaps[0] == Pal::GpuHeapLocal) ||
+                                (createInfo.heaps[0] == Pal::GpuHeapInvisible));
+
     Pal::Result palResult;
     VkResult    vkResult = VK_SUCCESS;
 
@@ -479,7 +520,7 @@ VkResult Memory::CreateGpuMemory(
                     palResult = pPalDevice->CreateGpuMemory(
                         createInfo, Util::VoidPtrInc(pSystemMem, palMemOffset), &pGpuMemory[deviceIdx]);
 
-                    if (palResult == Pal::Result::Success)
+                    if ((palResult == Pal::Result::Success) && (lazyResidency == false))
                     {
                         // Add the GPU memory object to the residency list
                         palResult = pDevice->AddMemReference(pPalDevice, pGpuMemory[deviceIdx]);
@@ -505,6 +546,9 @@ VkResult Memory::CreateGpuMemory(
                                                                 createInfo,
                                                                 multiInstance,
                                                                 primaryIndex);
+
+                (*ppMemory)->m_lazyResidency     = lazyResidency;
+                (*ppMemory)->m_residencyDeferred = lazyResidency;
             }
             else
             {
@@ -515,7 +559,11 @@ VkResult Memory::CreateGpuMemory(
                     {
                         Pal::IDevice* pPalDevice = pDevice->PalDevice(deviceIdx);
 
-                        pDevice->RemoveMemReference(pPalDevice, pGpuMemory[deviceIdx]);
+                        if (lazyResidency == false)
+                        {
+                            pDevice->RemoveMemReference(pPalDevice, pGpuMemory[deviceIdx]);
+                        }
+
                         pGpuMemory[deviceIdx]->Destroy();
                     }
                 }
@@ -567,6 +615,106 @@ VkResult Memory::CreateGpuMemory(
     return vkResult;
 }
 
+// =====================================================================================================================
+// Returns whether application memory allocations of the given size are small enough to be sub-allocated from the pools
+// of the device's application memory manager.
+bool Memory::IsSubAllocSize(
+    const Device* pDevice,
+    VkDeviceSize  size)
+{
+    const VkDeviceSize settingSize = pDevice->GetRuntimeSettings().memorySubAllocMaxSize;
+    const VkDeviceSize maxSize     = Util::Min(settingSize, MemorySubAllocLimit);
+
+    return (size != 0) && (size <= maxSize);
+}
+
+// =====================================================================================================================
+// Creates a memory object that is sub-allocated from a pool of the device's application memory manager.  Host visible
+// pools are persistently mapped, so mapping the memory only offsets the pool's CPU address.
+VkResult Memory::CreateSubAllocatedMemory(
+    Device*                         pDevice,
+    const VkAllocationCallbacks*    pAllocator,
+    const Pal::GpuMemoryCreateInfo& createInfo,
+    bool                            hostVisible,
+    Memory**                        ppMemory)
+{
+    VK_ASSERT(pDevice->NumPalDevices() == 1);
+
+    const VkDeviceSize pageSize = pDevice->GetProperties().virtualMemPageSize;
+
+    InternalMemCreateInfo subAllocInfo = {};
+
+    subAllocInfo.pal                    = createInfo;
+    subAllocInfo.flags.persistentMapped = hostVisible;
+    subAllocInfo.flags.needGl2Uncached  = createInfo.flags.gl2Uncached;
+
+    // Memory large enough to back a sparse page keeps the alignment that sparse binding requires
+    subAllocInfo.pal.alignment = (createInfo.size >= pageSize) ? pageSize : MemorySubAllocAlignment;
+
+    VkResult vkResult = VK_SUCCESS;
+
+    void* pSystemMem = pAllocator->pfnAllocation(
+        pAllocator->pUserData,
+        sizeof(Memory),
+        VK_DEFAULT_MEM_ALIGN,
+        VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    if (pSystemMem != nullptr)
+    {
+        InternalMemory subAllocation;
+
+        vkResult = pDevice->AppMemMgr()->AllocGpuMem(subAllocInfo, &subAllocation, 1 << DefaultDeviceIndex);
+
+        // Clear the memory through the pool's persistent mapping since it may hold data of freed allocations
+        if ((vkResult == VK_SUCCESS) && pDevice->GetRuntimeSettings().memorySubAllocZeroInit)
+        {
+            void* pData = nullptr;
+
+            VK_ASSERT(hostVisible);
+
+            if (subAllocation.Map(DefaultDeviceIndex, &pData) == Pal::Result::Success)
+            {
+                memset(pData, 0, static_cast<size_t>(createInfo.size));
+            }
+            else
+            {
+                pDevice->AppMemMgr()->FreeGpuMem(&subAllocation);
+
+                vkResult = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+            }
+        }
+
+        if (vkResult == VK_SUCCESS)
+        {
+            Pal::IGpuMemory* pGpuMemory[MaxPalDevices] = {};
+
+            pGpuMemory[DefaultDeviceIndex] = subAllocation.PalMemory(DefaultDeviceIndex);
+
+            Memory* pMemory = VK_PLACEMENT_NEW(pSystemMem) Memory(pDevice,
+                                                                  pGpuMemory,
+                                                                  0,
+                                                                  createInfo,
+                                                                  false,
+                                                                  DefaultDeviceIndex);
+
+            pMemory->m_subAllocated  = true;
+            pMemory->m_subAllocation = subAllocation;
+
+            *ppMemory = pMemory;
+        }
+        else
+        {
+            pAllocator->pfnFree(pAllocator->pUserData, pSystemMem);
+        }
+    }
+    else
+    {
+        vkResult = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    return vkResult;
+}
+
 // =====================================================================================================================
 // Create Pinned Memory on each required device.
 // The function only create the PalMemory from device I and can be used on device I.
@@ -829,6 +977,9 @@ Memory::Memory(
     m_sizeAccountedForDeviceMask(0),
     m_pExternalPalImage(pExternalImage),
     m_primaryDeviceIndex(primaryIndex),
+    m_lazyResidency(false),
+    m_residencyDeferred(false),
+    m_subAllocated(false),
     m_sharedGpuMemoryHandle(sharedGpuMemoryHandle)
 {
     Init(ppPalMemory);
@@ -847,6 +998,9 @@ Memory::Memory(
     m_sizeAccountedForDeviceMask(0),
     m_pExternalPalImage(nullptr),
     m_primaryDeviceIndex(primaryIndex),
+    m_lazyResidency(false),
+    m_residencyDeferred(false),
+    m_subAllocated(false),
     m_sharedGpuMemoryHandle(0)
 {
     // PAL info is not available for memory objects allocated for presentable images
@@ -897,6 +1051,14 @@ void Memory::Free(
         }
     }
 
+    if (m_subAllocated)
+    {
+        // The PAL memory objects belong to the pool the memory was sub-allocated from
+        memset(m_pPalMemory, 0, sizeof(m_pPalMemory));
+
+        pDevice->AppMemMgr()->FreeGpuMem(&m_subAllocation);
+    }
+
     // Free the parent memory
     for (uint32_t i = 0; i < m_pDevice->NumPalDevices(); ++i)
     {
@@ -904,7 +1066,11 @@ void Memory::Free(
         if (pGpuMemory != nullptr)
         {
             Pal::IDevice* pPalDevice = pDevice->PalDevice(i);
-            pDevice->RemoveMemReference(pPalDevice, pGpuMemory);
+
+            if (m_residencyDeferred == false)
+            {
+                pDevice->RemoveMemReference(pPalDevice, pGpuMemory);
+            }
 
             // Destroy PAL memory object
             pGpuMemory->Destroy();
@@ -1049,11 +1215,13 @@ VkResult Memory::Map(
     if (!m_multiInstance)
     {
         Pal::Result palResult = Pal::Result::Success;
-        if (PalMemory(m_primaryDeviceIndex) != nullptr)
+        if ((PalMemory(m_primaryDeviceIndex) != nullptr) && (CommitResidency() == VK_SUCCESS))
         {
             void* pData;
 
-            palResult = PalMemory(m_primaryDeviceIndex)->Map(&pData);
+            // Sub-allocations add their offset within the pool
+            palResult = m_subAllocated ? m_subAllocation.Map(m_primaryDeviceIndex, &pData) :
+                                         PalMemory(m_primaryDeviceIndex)->Map(&pData);
 
             if (palResult == Pal::Result::Success)
             {
@@ -1083,8 +1251,12 @@ void Memory::Unmap(void)
 
     VK_ASSERT(m_multiInstance == false);
 
-    palResult = PalMemory(m_primaryDeviceIndex)->Unmap();
-    VK_ASSERT(palResult == Pal::Result::Success);
+    // The pools of sub-allocations stay persistently mapped
+    if (m_subAllocated == false)
+    {
+        palResult = PalMemory(m_primaryDeviceIndex)->Unmap();
+        VK_ASSERT(palResult == Pal::Result::Success);
+    }
 }
 
 // =====================================================================================================================
@@ -1094,12 +1266,39 @@ VkResult Memory::GetCommitment(
 {
     VK_ASSERT(pCommittedMemoryInBytes != nullptr);
 
-    // We never allocate memory lazily, so just return the size of the memory object
+    // We never allocate memory lazily, so just return the size of the memory object.  Lazily committed memory is only
+    // added to the residency list late; PAL backs it when it is created.
     *pCommittedMemoryInBytes = m_info.size;
 
     return VK_SUCCESS;
 }
 
+// =====================================================================================================================
+// Adds lazily committed memory to the residency list the first time it is bound or mapped.  Memory that was made
+// resident when it was allocated is left alone.
+VkResult Memory::CommitResidency()
+{
+    Pal::Result palResult = Pal::Result::Success;
+
+    if (m_lazyResidency)
+    {
+        Util::MutexAuto lock(m_pDevice->GetMemoryMutex());
+
+        if (m_residencyDeferred)
+        {
+            palResult = m_pDevice->AddMemReference(m_pDevice->PalDevice(m_primaryDeviceIndex),
+                                                   PalMemory(m_primaryDeviceIndex));
+
+            if (palResult == Pal::Result::Success)
+            {
+                m_residencyDeferred = false;
+            }
+        }
+    }
+
+    return PalToVkResult(palResult);
+}
+
 // =====================================================================================================================
 // This function increases the priority of this memory's allocation to be at least that of the given priority.  This
 // function may be called e.g. when this memory is bound to a high-priority VkImage.
@@ -1107,8 +1306,8 @@ void Memory::ElevatePriority(
     MemoryPriority priority)
 {
     // Update PAL memory object's priority using a double-checked lock if the current priority is lower than
-    // the new given priority.
-    if (m_priority < priority)
+    // the new given priority.  Sub-allocations share their PAL memory object with others and keep the pool's priority.
+    if ((m_subAllocated == false) && (m_priority < priority))
     {
         Util::MutexAuto lock(m_pDevice->GetMemoryMutex());
 
@@ -1378,7 +1577,7 @@ VKAPI_ATTR uint64_t VKAPI_CALL vkGetDeviceMemoryOpaqueCaptureAddress(
 {
     const Memory* pMemory = Memory::ObjectFromHandle(pInfo->memory);
 
-    return pMemory->PalMemory(DefaultDeviceIndex)->Desc().gpuVirtAddr;
+    return pMemory->PalMemory(DefaultDeviceIndex)->Desc().gpuVirtAddr + pMemory->PalOffset();
 }
 
 } // namespace entry
@@ -6487,30 +6487,40 @@ void PhysicalDevice::GetMemoryBudgetProperties(
                     m_memoryUsageTracker.allocatedMemorySize[Pal::GpuHeapGartCacheable];
             }
 
-            uint32_t budgetRatio = 100;
+            pMemBudgetProps->heapBudget[heapIndex] = GetHeapBudget(heapIndex);
+        }
+    }
+}
 
-            const RuntimeSettings& settings = GetRuntimeSettings();
+// =====================================================================================================================
+// Returns the budget of the given Vulkan memory heap as reported through VK_EXT_memory_budget
+Pal::gpusize PhysicalDevice::GetHeapBudget(
+    uint32_t heapIndex
+    ) const
+{
+    const Pal::GpuHeap palHeap = GetPalHeapFromVkHeapIndex(heapIndex);
 
-            switch (palHeap)
-            {
-            case Pal::GpuHeapLocal:
-                budgetRatio = settings.heapBudgetRatioOfHeapSizeLocal;
-                break;
-            case Pal::GpuHeapInvisible:
-                budgetRatio = settings.heapBudgetRatioOfHeapSizeInvisible;
-                break;
-            case Pal::GpuHeapGartUswc:
-                budgetRatio = settings.heapBudgetRatioOfHeapSizeNonlocal;
-                break;
-            default:
-                VK_NEVER_CALLED();
-                break;
-            }
+    uint32_t budgetRatio = 100;
 
-            pMemBudgetProps->heapBudget[heapIndex] =
-                static_cast<VkDeviceSize>(m_memoryProperties.memoryHeaps[heapIndex].size / 100.0f * budgetRatio + 0.5f);
-        }
+    const RuntimeSettings& settings = GetRuntimeSettings();
+
+    switch (palHeap)
+    {
+    case Pal::GpuHeapLocal:
+        budgetRatio = settings.heapBudgetRatioOfHeapSizeLocal;
+        break;
+    case Pal::GpuHeapInvisible:
+        budgetRatio = settings.heapBudgetRatioOfHeapSizeInvisible;
+        break;
+    case Pal::GpuHeapGartUswc:
+        budgetRatio = settings.heapBudgetRatioOfHeapSizeNonlocal;
+        break;
+    default:
+        VK_NEVER_CALLED();
+        break;
     }
+
+    return static_cast<Pal::gpusize>(m_memoryProperties.memoryHeaps[heapIndex].size / 100.0f * budgetRatio + 0.5f);
 }
 
 // C-style entry points
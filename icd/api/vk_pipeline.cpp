@@ -143,6 +143,7 @@ Pipeline::Pipeline(
     :
     m_pDevice(pDevice),
     m_userDataLayout(),
+    m_pSharedPalPipeline(nullptr),
     m_palPipelineHash(0),
     m_staticStateMask(0),
     m_apiHash(0),
@@ -153,6 +154,7 @@ Pipeline::Pipeline(
 
 void Pipeline::Init(
     Pal::IPipeline**      pPalPipeline,
+    SharedPalPipeline*    pSharedPalPipeline,
     const PipelineLayout* pLayout,
     PipelineBinaryInfo*   pBinary,
     uint32_t              staticStateMask,
@@ -163,6 +165,7 @@ void Pipeline::Init(
     m_apiHash = apiHash;
     m_pBinary = pBinary;
     m_palPipelineHash = pPalPipeline[DefaultDeviceIndex]->GetInfo().internalPipelineHash.unique;
+    m_pSharedPalPipeline = pSharedPalPipeline;
 
     for (uint32_t devIdx = 0; devIdx < m_pDevice->NumPalDevices(); devIdx++)
     {
@@ -173,10 +176,20 @@ void Pipeline::Init(
 // =====================================================================================================================
 Pipeline::~Pipeline()
 {
-    // Destroy PAL object
-    for (uint32_t deviceIdx = 0; (deviceIdx < m_pDevice->NumPalDevices()) && (m_pPalPipeline[deviceIdx] != nullptr); deviceIdx++)
+    if (m_pSharedPalPipeline != nullptr)
     {
-        m_pPalPipeline[deviceIdx]->Destroy();
+        // Shared PAL objects are destroyed along with the last pipeline referencing them
+        m_pDevice->GetPalPipelineTable()->Release(m_pSharedPalPipeline);
+    }
+    else
+    {
+        // Destroy PAL object
+        for (uint32_t deviceIdx = 0;
+             (deviceIdx < m_pDevice->NumPalDevices()) && (m_pPalPipeline[deviceIdx] != nullptr);
+             deviceIdx++)
+        {
+            m_pPalPipeline[deviceIdx]->Destroy();
+        }
     }
 }
 
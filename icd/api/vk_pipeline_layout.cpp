@@ -83,7 +83,7 @@ PipelineLayout::PipelineLayout(
     m_pDevice(pDevice),
     m_apiHash(apiHash)
 {
-
+    memset(&m_mappingCache, 0, sizeof(m_mappingCache));
 }
 
 // =====================================================================================================================
@@ -105,6 +105,7 @@ VkResult PipelineLayout::ConvertCreateInfo(
     VkResult result = VK_SUCCESS;
 
     pPipelineInfo->numRsrcMapNodes        = 0;
+    pPipelineInfo->numStaRsrcMapNodes     = 0;
     pPipelineInfo->numDescRangeValueNodes = 0;
 
     // Always allocates:
@@ -176,7 +177,8 @@ VkResult PipelineLayout::ConvertCreateInfo(
         if (setLayoutInfo.activeStageMask != 0)
         {
             // Accumulate the space needed by all resource nodes for this set
-            pPipelineInfo->numRsrcMapNodes += setLayoutInfo.sta.numRsrcMapNodes;
+            pPipelineInfo->numRsrcMapNodes    += setLayoutInfo.sta.numRsrcMapNodes;
+            pPipelineInfo->numStaRsrcMapNodes += setLayoutInfo.sta.numRsrcMapNodes;
 
             // Add count for FMASK nodes
             if (pDevice->GetRuntimeSettings().enableFmaskBasedMsaaRead)
@@ -223,9 +225,14 @@ VkResult PipelineLayout::ConvertCreateInfo(
     // Add the user data nodes count to the total number of resource mapping nodes
     pPipelineInfo->numRsrcMapNodes += pPipelineInfo->numUserDataNodes;
 
-    pPipelineInfo->tempStageSize = (pPipelineInfo->numRsrcMapNodes * sizeof(Vkgc::ResourceMappingNode));
+    // The static section nodes and immutable sampler ranges are identical for every pipeline using this layout, so
+    // they live in the layout's mapping cache.  Only the top-level user data nodes, which also depend on the vertex
+    // input and transform feedback state of the pipeline, are built per stage in the scratch buffer.
+    pPipelineInfo->mappingCacheSize =
+        ((pPipelineInfo->numUserDataNodes + pPipelineInfo->numStaRsrcMapNodes) * sizeof(Vkgc::ResourceMappingNode)) +
+        (pPipelineInfo->numDescRangeValueNodes * sizeof(Vkgc::DescriptorRangeValue));
 
-    pPipelineInfo->tempStageSize += (pPipelineInfo->numDescRangeValueNodes * sizeof(Vkgc::DescriptorRangeValue));
+    pPipelineInfo->tempStageSize = (pPipelineInfo->numUserDataNodes * sizeof(Vkgc::ResourceMappingNode));
 
     // Calculate scratch buffer size for building pipeline mappings for all shader stages based on this layout
     pPipelineInfo->tempBufferSize = (ShaderStageNativeStageCount * pPipelineInfo->tempStageSize);
@@ -252,8 +259,21 @@ VkResult PipelineLayout::Create(
 
     Info info = {};
     PipelineInfo pipelineInfo = {};
+    SetUserDataLayout setUserData[MaxDescriptorSets] = {};
     uint64_t apiHash = BuildApiHash(pCreateInfo);
 
+    VkResult result = ConvertCreateInfo(
+        pDevice,
+        pCreateInfo,
+        &info,
+        &pipelineInfo,
+        setUserData);
+
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
     size_t setLayoutsArraySize = 0;
 
     for (uint32_t i = 0; i < pCreateInfo->setLayoutCount; ++i)
@@ -262,10 +282,14 @@ VkResult PipelineLayout::Create(
         setLayoutsArraySize += pLayout->GetObjectSize();
     }
 
-    // Need to add extra storage for DescriptorSetLayout*, SetUserDataLayout, and the descriptor set layouts themselves
-    const size_t apiSize = sizeof(PipelineLayout);
-    const size_t objSize = apiSize + (pCreateInfo->setLayoutCount * sizeof(SetUserDataLayout)) +
-        (pCreateInfo->setLayoutCount * sizeof(DescriptorSetLayout*)) + setLayoutsArraySize;
+    // Need to add extra storage for DescriptorSetLayout*, SetUserDataLayout, the descriptor set layouts themselves
+    // and the cached resource mapping
+    const size_t apiSize            = sizeof(PipelineLayout);
+    const size_t mappingCacheOffset = Util::Pow2Align(
+        apiSize + (pCreateInfo->setLayoutCount * sizeof(SetUserDataLayout)) +
+        (pCreateInfo->setLayoutCount * sizeof(DescriptorSetLayout*)) + setLayoutsArraySize,
+        VK_DEFAULT_MEM_ALIGN);
+    const size_t objSize            = mappingCacheOffset + pipelineInfo.mappingCacheSize;
 
     void* pSysMem = pDevice->AllocApiObject(objSize, pAllocator);
 
@@ -278,18 +302,7 @@ VkResult PipelineLayout::Create(
     DescriptorSetLayout** ppSetLayouts = static_cast<DescriptorSetLayout**>(
         Util::VoidPtrInc(pSysMem, apiSize + (pCreateInfo->setLayoutCount * sizeof(SetUserDataLayout))));
 
-    VkResult result = ConvertCreateInfo(
-        pDevice,
-        pCreateInfo,
-        &info,
-        &pipelineInfo,
-        pSetUserData);
-
-    if (result != VK_SUCCESS)
-    {
-        pAllocator->pfnFree(pAllocator->pUserData, pSysMem);
-        return result;
-    }
+    memcpy(pSetUserData, setUserData, pCreateInfo->setLayoutCount * sizeof(SetUserDataLayout));
 
     size_t currentSetLayoutOffset = apiSize + (pCreateInfo->setLayoutCount * sizeof(SetUserDataLayout)) +
         (pCreateInfo->setLayoutCount * sizeof(DescriptorSetLayout*));
@@ -306,7 +319,11 @@ VkResult PipelineLayout::Create(
         currentSetLayoutOffset += pLayout->GetObjectSize();
     }
 
-    VK_PLACEMENT_NEW(pSysMem) PipelineLayout(pDevice, info, pipelineInfo, apiHash);
+    PipelineLayout* pObject = VK_PLACEMENT_NEW(pSysMem) PipelineLayout(pDevice, info, pipelineInfo, apiHash);
+
+    // Build the pipeline-independent part of the LLPC resource mapping from the copied set layouts, so that the
+    // immutable sampler data it points to lives as long as this object.
+    pObject->BuildLlpcMappingCache(Util::VoidPtrInc(pSysMem, mappingCacheOffset));
 
     *pPipelineLayout = PipelineLayout::HandleFromVoidPointer(pSysMem);
 
@@ -491,73 +508,52 @@ int32_t PipelineLayout::BuildLlpcVertexInputDescriptors(
 }
 
 // =====================================================================================================================
-// This function populates the resource mapping node details to the shader-stage specific pipeline info structure.
-VkResult PipelineLayout::BuildLlpcPipelineMapping(
-    ShaderStage                                 stage,
-    void*                                       pBuffer,
-    const VkPipelineVertexInputStateCreateInfo* pVertexInput,
-    Vkgc::PipelineShaderInfo*                   pShaderInfo,
-    VbBindingInfo*                              pVbInfo,
-    bool                                        isLastVertexStage
-    ) const
+// Builds the part of the VKGC resource mapping that is the same for every pipeline compiled with this layout: the push
+// constant node, the dynamic descriptor and set pointer user data nodes, the static section nodes of each set and the
+// immutable sampler ranges.  BuildLlpcPipelineMapping() only has to add the pipeline-specific nodes on top of this.
+void PipelineLayout::BuildLlpcMappingCache(
+    void* pCacheMem)
 {
-    VkResult result = VK_SUCCESS;
-    // Vertex binding information should only be specified for the VS stage
-    VK_ASSERT(stage == ShaderStageVertex || (pVertexInput == nullptr && pVbInfo == nullptr));
-
-    uint32_t stageIndex = stage;
-    uint32_t stageMask = (1 << stage);
-    // Buffer of all resource mapping nodes (enough to cover requirements by all sets in this pipeline layout)
-    VK_ASSERT((stageIndex + 1) * m_pipelineInfo.tempStageSize <= m_pipelineInfo.tempBufferSize);
+    // NOTE: Some fields of resource mapping nodes are unused for certain node types.  We must initialize them to zeroes.
+    memset(pCacheMem, 0, m_pipelineInfo.mappingCacheSize);
 
-    void* pStageBuffer = Util::VoidPtrInc(pBuffer, stageIndex * m_pipelineInfo.tempStageSize);
-
-    Vkgc::ResourceMappingNode* pUserDataNodes = reinterpret_cast<Vkgc::ResourceMappingNode*>(pStageBuffer);
-
-    Vkgc::ResourceMappingNode* pAllNodes = pUserDataNodes + m_pipelineInfo.numUserDataNodes;
-    Vkgc::DescriptorRangeValue* pDescriptorRangeValues =
-        reinterpret_cast<Vkgc::DescriptorRangeValue*>(pUserDataNodes + m_pipelineInfo.numRsrcMapNodes);
-    uint32_t descriptorRangeCount = 0;
-
-    uint32_t mappingNodeCount  = 0; // Number of consumed ResourceMappingNodes
-    uint32_t userDataNodeCount = 0; // Number of consumed user data ResourceMappingNodes entries
+    m_mappingCache.pUserDataNodes   = static_cast<Vkgc::ResourceMappingNode*>(pCacheMem);
+    m_mappingCache.pStaNodes        = m_mappingCache.pUserDataNodes + m_pipelineInfo.numUserDataNodes;
+    m_mappingCache.pDescRangeValues = reinterpret_cast<Vkgc::DescriptorRangeValue*>(
+        m_mappingCache.pStaNodes + m_pipelineInfo.numStaRsrcMapNodes);
 
-    if (result == VK_SUCCESS)
-    {
-        if ((m_info.userDataLayout.transformFeedbackRegCount > 0) && isLastVertexStage)
-        {
-            Vkgc::ResourceMappingNode* pTransformFeedbackNode = &pUserDataNodes[userDataNodeCount];
-            pTransformFeedbackNode->type           = Vkgc::ResourceMappingNodeType::StreamOutTableVaPtr;
-            pTransformFeedbackNode->offsetInDwords = m_info.userDataLayout.transformFeedbackRegBase;
-            pTransformFeedbackNode->sizeInDwords   = m_info.userDataLayout.transformFeedbackRegCount;
+    Vkgc::ResourceMappingNode*  pUserDataNodes         = m_mappingCache.pUserDataNodes;
+    Vkgc::ResourceMappingNode*  pAllNodes              = m_mappingCache.pStaNodes;
+    Vkgc::DescriptorRangeValue* pDescriptorRangeValues = m_mappingCache.pDescRangeValues;
 
-            userDataNodeCount += 1;
-        }
-    }
+    uint32_t mappingNodeCount     = 0; // Number of consumed ResourceMappingNodes
+    uint32_t userDataNodeCount    = 0; // Number of consumed user data ResourceMappingNodes entries
+    uint32_t descriptorRangeCount = 0; // Number of consumed DescriptorRangeValues
 
     // TODO: Build the internal push constant resource mapping
-    if (result == VK_SUCCESS)
+    if (m_info.userDataLayout.pushConstRegCount > 0)
     {
-        if (m_info.userDataLayout.pushConstRegCount > 0)
-        {
-            Vkgc::ResourceMappingNode* pPushConstNode = &pUserDataNodes[userDataNodeCount];
-            pPushConstNode->type             = Vkgc::ResourceMappingNodeType::PushConst;
-            pPushConstNode->offsetInDwords   = m_info.userDataLayout.pushConstRegBase;
-            pPushConstNode->sizeInDwords     = m_info.userDataLayout.pushConstRegCount;
-            pPushConstNode->srdRange.set     = Vkgc::InternalDescriptorSetId;
+        Vkgc::ResourceMappingNode* pPushConstNode = &pUserDataNodes[userDataNodeCount];
+        pPushConstNode->type             = Vkgc::ResourceMappingNodeType::PushConst;
+        pPushConstNode->offsetInDwords   = m_info.userDataLayout.pushConstRegBase;
+        pPushConstNode->sizeInDwords     = m_info.userDataLayout.pushConstRegCount;
+        pPushConstNode->srdRange.set     = Vkgc::InternalDescriptorSetId;
 
-            userDataNodeCount += 1;
-        }
+        userDataNodeCount += 1;
     }
 
     // Build descriptor for each set
-    for (uint32_t setIndex = 0; (setIndex < m_info.setCount) && (result == VK_SUCCESS); ++setIndex)
+    for (uint32_t setIndex = 0; setIndex < m_info.setCount; ++setIndex)
     {
         const SetUserDataLayout* pSetUserData = &GetSetUserData(setIndex);
         const auto* pSetLayout = GetSetLayouts(setIndex);
 
-        // Test if this descriptor set is active in this stage.
-        if (Util::TestAnyFlagSet(pSetLayout->Info().activeStageMask, stageMask))
+        // Sets are currently either active in every stage or in none (see DescriptorSetLayout::ConvertCreateInfo),
+        // which is what allows a single mapping to be shared by all stages.
+        VK_ASSERT((pSetLayout->Info().activeStageMask == 0) ||
+                  (pSetLayout->Info().activeStageMask == VK_SHADER_STAGE_ALL));
+
+        if (pSetLayout->Info().activeStageMask != 0)
         {
             // Build the resource mapping nodes for the contents of this set.
             auto pStaNodes   = &pAllNodes[mappingNodeCount];
@@ -568,7 +564,7 @@ VkResult PipelineLayout::BuildLlpcPipelineMapping(
             uint32_t staNodeCount;
             uint32_t dynNodeCount;
 
-            result = BuildLlpcSetMapping(
+            BuildLlpcSetMapping(
                 setIndex,
                 pSetLayout,
                 pStaNodes,
@@ -604,6 +600,61 @@ VkResult PipelineLayout::BuildLlpcPipelineMapping(
         }
     }
 
+    m_mappingCache.userDataNodeCount   = userDataNodeCount;
+    m_mappingCache.staNodeCount        = mappingNodeCount;
+    m_mappingCache.descRangeValueCount = descriptorRangeCount;
+
+    // If you hit these asserts, we precomputed an insufficient amount of space during layout creation.
+    VK_ASSERT(mappingNodeCount <= m_pipelineInfo.numStaRsrcMapNodes);
+    VK_ASSERT(descriptorRangeCount <= m_pipelineInfo.numDescRangeValueNodes);
+}
+
+// =====================================================================================================================
+// This function populates the resource mapping node details to the shader-stage specific pipeline info structure.
+VkResult PipelineLayout::BuildLlpcPipelineMapping(
+    ShaderStage                                 stage,
+    void*                                       pBuffer,
+    const VkPipelineVertexInputStateCreateInfo* pVertexInput,
+    Vkgc::PipelineShaderInfo*                   pShaderInfo,
+    VbBindingInfo*                              pVbInfo,
+    bool                                        isLastVertexStage
+    ) const
+{
+    VkResult result = VK_SUCCESS;
+    // Vertex binding information should only be specified for the VS stage
+    VK_ASSERT(stage == ShaderStageVertex || (pVertexInput == nullptr && pVbInfo == nullptr));
+
+    uint32_t stageIndex = stage;
+    // Buffer of the top-level user data nodes of every stage
+    VK_ASSERT((stageIndex + 1) * m_pipelineInfo.tempStageSize <= m_pipelineInfo.tempBufferSize);
+
+    void* pStageBuffer = Util::VoidPtrInc(pBuffer, stageIndex * m_pipelineInfo.tempStageSize);
+
+    Vkgc::ResourceMappingNode* pUserDataNodes = reinterpret_cast<Vkgc::ResourceMappingNode*>(pStageBuffer);
+
+    uint32_t userDataNodeCount = 0; // Number of consumed user data ResourceMappingNodes entries
+
+    if ((m_info.userDataLayout.transformFeedbackRegCount > 0) && isLastVertexStage)
+    {
+        Vkgc::ResourceMappingNode* pTransformFeedbackNode = &pUserDataNodes[userDataNodeCount];
+        pTransformFeedbackNode->type           = Vkgc::ResourceMappingNodeType::StreamOutTableVaPtr;
+        pTransformFeedbackNode->offsetInDwords = m_info.userDataLayout.transformFeedbackRegBase;
+        pTransformFeedbackNode->sizeInDwords   = m_info.userDataLayout.transformFeedbackRegCount;
+
+        userDataNodeCount += 1;
+    }
+
+    // The push constant and descriptor set nodes come straight from the mapping built at layout creation.  The set
+    // pointer nodes in it point at the cached static section nodes, so those need not be copied.
+    if (m_mappingCache.userDataNodeCount > 0)
+    {
+        memcpy(&pUserDataNodes[userDataNodeCount],
+               m_mappingCache.pUserDataNodes,
+               m_mappingCache.userDataNodeCount * sizeof(Vkgc::ResourceMappingNode));
+
+        userDataNodeCount += m_mappingCache.userDataNodeCount;
+    }
+
     // Build the internal vertex buffer table mapping
     constexpr uint32_t VbTablePtrRegCount = 1; // PAL requires all indirect user data tables to be 1DW
 
@@ -636,11 +687,11 @@ VkResult PipelineLayout::BuildLlpcPipelineMapping(
 
     pShaderInfo->pUserDataNodes   = pUserDataNodes;
     pShaderInfo->userDataNodeCount = userDataNodeCount;
-    pShaderInfo->pDescriptorRangeValues    = pDescriptorRangeValues;
-    pShaderInfo->descriptorRangeValueCount = descriptorRangeCount;
+    pShaderInfo->pDescriptorRangeValues    = m_mappingCache.pDescRangeValues;
+    pShaderInfo->descriptorRangeValueCount = m_mappingCache.descRangeValueCount;
 
     // If you hit this assert, we precomputed an insufficient amount of scratch space during layout creation.
-    VK_ASSERT(mappingNodeCount <= m_pipelineInfo.numRsrcMapNodes);
+    VK_ASSERT(userDataNodeCount <= m_pipelineInfo.numUserDataNodes);
 
     return VK_SUCCESS;
 }
@@ -70,10 +70,21 @@ Queue::Queue(
     m_queueIndex(queueIndex),
     m_queueFlags(queueFlags),
     m_pDevModeMgr(pDevice->VkInstance()->GetDevModeMgr()),
-    m_pStackAllocator(pStackAllocator)
+    m_pStackAllocator(pStackAllocator),
+    m_pSubmitThread(nullptr),
+    m_submitSerial(0),
+    m_completedSubmitSerial(0)
 {
     memcpy(m_pPalQueues, pPalQueues, sizeof(pPalQueues[0]) * pDevice->NumPalDevices());
     memset(&m_palFrameMetadataControl, 0, sizeof(Pal::PerSourceFrameMetadataControl));
+    memset(&m_submitStats, 0, sizeof(m_submitStats));
+    memset(&m_internalCmdBufStats, 0, sizeof(m_internalCmdBufStats));
+    memset(m_internalTimeline, 0, sizeof(m_internalTimeline));
+
+    // The submission thread only handles a single PAL queue, and DevMode has to see every submission as it happens
+    const bool useSubmitThread = pDevice->GetRuntimeSettings().enableQueueSubmitThread &&
+                                 (pDevice->NumPalDevices() == 1)                      &&
+                                 (m_pDevModeMgr == nullptr);
 
     for (uint32_t deviceIdx = 0; deviceIdx < MaxPalDevices; deviceIdx++)
     {
@@ -81,11 +92,45 @@ Queue::Queue(
         m_pCmdBufRing[deviceIdx]     = nullptr;
     }
 
+    // The thread is created up front so that m_pSubmitThread never changes while other threads may read it
+    if (useSubmitThread)
+    {
+        CreateSubmitThread();
+    }
 }
 
 // =====================================================================================================================
 Queue::~Queue()
 {
+    if (m_pSubmitThread != nullptr)
+    {
+        m_pSubmitThread->Stop();
+
+        Util::Destructor(m_pSubmitThread);
+
+        m_pDevice->VkInstance()->FreeMem(m_pSubmitThread);
+    }
+
+    if (m_submitStats.submitCalls > 0)
+    {
+        const uint64_t submitTimeUs = utils::TicksToMicroseconds(m_submitStats.submitTime,
+                                                                 static_cast<uint64_t>(Util::GetPerfFrequency()));
+
+        AmdvlkLog(m_pDevice->GetRuntimeSettings().logTagIdMask, QueueSubmitStats,
+                  "Queue %u-%u: %llu calls, %llu batches, %llu PAL submits, %llu us",
+                  m_queueFamilyIndex, m_queueIndex, m_submitStats.submitCalls, m_submitStats.batchCount,
+                  m_submitStats.palSubmitCount, submitTimeUs);
+    }
+
+    if (m_internalCmdBufStats.acquireCount > 0)
+    {
+        AmdvlkLog(m_pDevice->GetRuntimeSettings().logTagIdMask, QueueSubmitStats,
+                  "Queue %u-%u internal command buffers: %llu acquires, %llu already begun, %llu created, %llu stalls",
+                  m_queueFamilyIndex, m_queueIndex, m_internalCmdBufStats.acquireCount,
+                  m_internalCmdBufStats.readyCount, m_internalCmdBufStats.createCount,
+                  m_internalCmdBufStats.stallCount);
+    }
+
     for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); ++deviceIdx)
     {
         if (m_pDummyCmdBuffer[deviceIdx] != nullptr)
@@ -110,6 +155,33 @@ Queue::~Queue()
 
 }
 
+// =====================================================================================================================
+// Creates the thread that issues this queue's submissions.  Submissions are issued directly if that fails.
+void Queue::CreateSubmitThread()
+{
+    void* pMemory = m_pDevice->VkInstance()->AllocMem(
+        sizeof(QueueSubmitThread),
+        VK_DEFAULT_MEM_ALIGN,
+        VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+
+    if (pMemory != nullptr)
+    {
+        QueueSubmitThread* pThread = VK_PLACEMENT_NEW(pMemory) QueueSubmitThread(m_pDevice->VkInstance(),
+                                                                                 PalQueue(DefaultDeviceIndex));
+
+        if (pThread->Init() == Pal::Result::Success)
+        {
+            m_pSubmitThread = pThread;
+        }
+        else
+        {
+            Util::Destructor(pThread);
+
+            m_pDevice->VkInstance()->FreeMem(pMemory);
+        }
+    }
+}
+
 // =====================================================================================================================
 // Create a dummy command buffer for the present queue
 VkResult Queue::CreateDummyCmdBuffer()
@@ -203,7 +275,19 @@ VkResult Queue::NotifyFlipMetadata(
                     result = CreateDummyCmdBuffer();
                 }
 
-                if (result == VK_SUCCESS)
+                if ((result == VK_SUCCESS) && (m_pSubmitThread != nullptr))
+                {
+                    QueuedSubmitOp op = {};
+                    op.type                  = QueuedSubmitOp::Type::Submit;
+                    op.pMemory               = nullptr;
+                    op.submit.ppCmdBuffers   = &m_pDummyCmdBuffer[deviceIdx];
+                    op.submit.cmdBufferCount = 1;
+                    op.submit.pFence         = nullptr;
+                    op.submit.cmdBufInfo     = cmdBufInfo;
+
+                    m_pSubmitThread->Push(op);
+                }
+                else if (result == VK_SUCCESS)
                 {
                     Pal::PerSubQueueSubmitInfo perSubQueueInfo = {};
                     perSubQueueInfo.cmdBufferCount  = 1;
@@ -251,6 +335,44 @@ VkResult Queue::NotifyFlipMetadataAfterPresent(
     return result;
 }
 
+// Number of PAL command buffers per submission that Queue::Submit() gathers without opening a virtual stack frame
+static constexpr uint32_t InlineSubmitCmdBufferCount = 16;
+
+// =====================================================================================================================
+// Finds the extension structures of a VkSubmitInfo that are handled by Queue::Submit().
+static void GetSubmitInfoExtensions(
+    const VkSubmitInfo&                   submitInfo,
+    const VkDeviceGroupSubmitInfo**       ppDeviceGroupInfo,
+    const VkTimelineSemaphoreSubmitInfo** ppTimelineSemaphoreInfo)
+{
+    union
+    {
+        const VkStructHeader*                          pHeader;
+        const VkSubmitInfo*                            pVkSubmitInfo;
+        const VkTimelineSemaphoreSubmitInfo*           pVkTimelineSemaphoreSubmitInfo;
+        const VkDeviceGroupSubmitInfo*                 pVkDeviceGroupSubmitInfo;
+    };
+
+    *ppDeviceGroupInfo       = nullptr;
+    *ppTimelineSemaphoreInfo = nullptr;
+
+    for (pVkSubmitInfo = &submitInfo; pHeader != nullptr; pHeader = pHeader->pNext)
+    {
+        switch (static_cast<int32_t>(pHeader->sType))
+        {
+        case VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO:
+            *ppDeviceGroupInfo = pVkDeviceGroupSubmitInfo;
+            break;
+        case VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO:
+            *ppTimelineSemaphoreInfo = pVkTimelineSemaphoreSubmitInfo;
+            break;
+        default:
+            // Skip any unknown extension structures
+            break;
+        }
+    }
+}
+
 // =====================================================================================================================
 // Submit an array of command buffers to a queue
 VkResult Queue::Submit(
@@ -267,13 +389,24 @@ VkResult Queue::Submit(
 #endif
     Fence* pFence = Fence::ObjectFromHandle(fence);
 
-    VirtualStackFrame virtStackFrame(m_pStackAllocator);
+    VirtualStackArray<Pal::ICmdBuffer*, InlineSubmitCmdBufferCount> palCmdBufferArray(m_pStackAllocator);
 
     VkResult result = VK_SUCCESS;
 
+    const int64_t startTime = Util::GetPerfCpuTime();
+
+    // Timed submissions are reported per VkSubmitInfo, so their batches are never merged
+    const bool coalesceBatches = m_pDevice->GetRuntimeSettings().coalesceSubmitBatches && (timedQueueEvents == false);
+
+    m_submitSerial++;
+
+    if (m_pSubmitThread != nullptr)
+    {
+        result = SubmitToThread(submitCount, pSubmits, pFence);
+    }
     // The fence should be only used in the last submission to PAL. The implicit ordering guarantees provided by PAL
     // make sure that the fence is only signaled when all submissions complete.
-    if ((submitCount == 0) && (pFence != nullptr))
+    else if ((submitCount == 0) && (pFence != nullptr))
     {
         Pal::IFence* pPalFence = nullptr;
 
@@ -296,40 +429,22 @@ VkResult Queue::Submit(
 
         palResult = PalQueue(DefaultDeviceIndex)->Submit(submitInfo);
 
+        m_submitStats.palSubmitCount++;
+
         result = PalToVkResult(palResult);
     }
     else
     {
-        for (uint32_t submitIdx = 0; (submitIdx < submitCount) && (result == VK_SUCCESS); ++submitIdx)
+        // Number of VkSubmitInfos merged into the current PAL submission
+        uint32_t batchCount = 1;
+
+        for (uint32_t submitIdx = 0; (submitIdx < submitCount) && (result == VK_SUCCESS); submitIdx += batchCount)
         {
             const VkSubmitInfo& submitInfo = pSubmits[submitIdx];
             const VkDeviceGroupSubmitInfo* pDeviceGroupInfo = nullptr;
             const VkTimelineSemaphoreSubmitInfo* pTimelineSemaphoreInfo = nullptr;
-            {
-                union
-                {
-                    const VkStructHeader*                          pHeader;
-                    const VkSubmitInfo*                            pVkSubmitInfo;
-                    const VkTimelineSemaphoreSubmitInfo*           pVkTimelineSemaphoreSubmitInfo;
-                    const VkDeviceGroupSubmitInfo*                 pVkDeviceGroupSubmitInfo;
-                };
 
-                for (pVkSubmitInfo = &submitInfo; pHeader != nullptr; pHeader = pHeader->pNext)
-                {
-                    switch (static_cast<int32_t>(pHeader->sType))
-                    {
-                    case VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO:
-                        pDeviceGroupInfo = pVkDeviceGroupSubmitInfo;
-                        break;
-                    case VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO:
-                        pTimelineSemaphoreInfo = pVkTimelineSemaphoreSubmitInfo;
-                        break;
-                    default:
-                        // Skip any unknown extension structures
-                        break;
-                    }
-                }
-            }
+            GetSubmitInfoExtensions(submitInfo, &pDeviceGroupInfo, &pTimelineSemaphoreInfo);
 
             if ((result == VK_SUCCESS) && (submitInfo.waitSemaphoreCount > 0))
             {
@@ -343,16 +458,43 @@ VkResult Queue::Submit(
                     (pDeviceGroupInfo != nullptr ? pDeviceGroupInfo->pWaitSemaphoreDeviceIndices : nullptr));
             }
 
-            // Allocate space to store the PAL command buffer handles
-            const VkCommandBuffer* pCmdBuffers = submitInfo.pCommandBuffers;
-            const uint32_t cmdBufferCount      = submitInfo.commandBufferCount;
+            // Merge the following batches into the same PAL submission as long as nothing has to happen between them,
+            // i.e. the merged batches neither signal nor wait for semaphores in between.  Batches are executed in
+            // order either way, so this only saves the cost of the additional submissions.
+            const VkSubmitInfo*                  pLastSubmitInfo       = &submitInfo;
+            const VkTimelineSemaphoreSubmitInfo* pLastTimelineSemaInfo = pTimelineSemaphoreInfo;
+            uint32_t                             cmdBufferCount        = submitInfo.commandBufferCount;
+
+            batchCount = 1;
+
+            if (coalesceBatches && (pDeviceGroupInfo == nullptr))
+            {
+                while ((submitIdx + batchCount < submitCount) && (pLastSubmitInfo->signalSemaphoreCount == 0))
+                {
+                    const VkSubmitInfo&                  nextSubmitInfo       = pSubmits[submitIdx + batchCount];
+                    const VkDeviceGroupSubmitInfo*       pNextDeviceGroupInfo = nullptr;
+                    const VkTimelineSemaphoreSubmitInfo* pNextTimelineSemaInfo = nullptr;
+
+                    GetSubmitInfoExtensions(nextSubmitInfo, &pNextDeviceGroupInfo, &pNextTimelineSemaInfo);
+
+                    if ((nextSubmitInfo.waitSemaphoreCount > 0) || (pNextDeviceGroupInfo != nullptr))
+                    {
+                        break;
+                    }
+
+                    pLastSubmitInfo       = &nextSubmitInfo;
+                    pLastTimelineSemaInfo = pNextTimelineSemaInfo;
+                    cmdBufferCount       += nextSubmitInfo.commandBufferCount;
+                    batchCount++;
+                }
+            }
 
-            Pal::ICmdBuffer** pPalCmdBuffers = (cmdBufferCount > 0) ?
-                            virtStackFrame.AllocArray<Pal::ICmdBuffer*>(submitInfo.commandBufferCount) : nullptr;
+            // Get space to store the PAL command buffer handles
+            Pal::ICmdBuffer** pPalCmdBuffers = (cmdBufferCount > 0) ? palCmdBufferArray.Alloc(cmdBufferCount) : nullptr;
 
             result = ((pPalCmdBuffers != nullptr) || (cmdBufferCount == 0)) ? result : VK_ERROR_OUT_OF_HOST_MEMORY;
 
-            bool lastBatch = (submitIdx == submitCount - 1);
+            bool lastBatch = (submitIdx + batchCount == submitCount);
 
             Pal::IFence*    pPalFence     = nullptr;
 
@@ -371,27 +513,32 @@ VkResult Queue::Submit(
 
             for (uint32_t deviceIdx = 0; (deviceIdx < deviceCount) && (result == VK_SUCCESS); deviceIdx++)
             {
-                // Get the PAL command buffer object from each Vulkan object and put it
-                // in the local array before submitting to PAL.
-                DispatchableCmdBuffer* const * pCommandBuffers =
-                    reinterpret_cast<DispatchableCmdBuffer*const*>(submitInfo.pCommandBuffers);
-
                 perSubQueueInfo.cmdBufferCount = 0;
 
                 const uint32_t deviceMask = 1 << deviceIdx;
 
-                for (uint32_t i = 0; i < cmdBufferCount; ++i)
+                for (uint32_t batchIdx = 0; batchIdx < batchCount; ++batchIdx)
                 {
-                    if ((deviceCount > 1) &&
-                        (pDeviceGroupInfo->pCommandBufferDeviceMasks != nullptr) &&
-                        (pDeviceGroupInfo->pCommandBufferDeviceMasks[i] & deviceMask) == 0)
+                    const VkSubmitInfo& batchInfo = pSubmits[submitIdx + batchIdx];
+
+                    // Get the PAL command buffer object from each Vulkan object and put it
+                    // in the local array before submitting to PAL.
+                    DispatchableCmdBuffer* const * pCommandBuffers =
+                        reinterpret_cast<DispatchableCmdBuffer*const*>(batchInfo.pCommandBuffers);
+
+                    for (uint32_t i = 0; i < batchInfo.commandBufferCount; ++i)
                     {
-                        continue;
-                    }
+                        if ((deviceCount > 1) &&
+                            (pDeviceGroupInfo->pCommandBufferDeviceMasks != nullptr) &&
+                            (pDeviceGroupInfo->pCommandBufferDeviceMasks[i] & deviceMask) == 0)
+                        {
+                            continue;
+                        }
 
-                    const CmdBuffer& cmdBuf = *(*pCommandBuffers[i]);
+                        const CmdBuffer& cmdBuf = *(*pCommandBuffers[i]);
 
-                    pPalCmdBuffers[perSubQueueInfo.cmdBufferCount++] = cmdBuf.PalCmdBuffer(deviceIdx);
+                        pPalCmdBuffers[perSubQueueInfo.cmdBufferCount++] = cmdBuf.PalCmdBuffer(deviceIdx);
+                    }
                 }
 
                 if (lastBatch && (pFence != nullptr))
@@ -421,41 +568,312 @@ VkResult Queue::Submit(
                             cmdBufferCount,
                             submitInfo.pCommandBuffers,
                             palSubmitInfo,
-                            &virtStackFrame);
+                            palCmdBufferArray.GetFrame());
 #else
                         VK_NEVER_CALLED();
 #endif
                     }
+
+                    m_submitStats.palSubmitCount++;
+
                     result = PalToVkResult(palResult);
                 }
 
             }
 
-            virtStackFrame.FreeArray(pPalCmdBuffers);
-
-            if ((result == VK_SUCCESS) && (submitInfo.signalSemaphoreCount > 0))
+            // Only the last of the merged batches can have semaphores to signal
+            if ((result == VK_SUCCESS) && (pLastSubmitInfo->signalSemaphoreCount > 0))
             {
-                VK_ASSERT((pTimelineSemaphoreInfo == nullptr) ||
-                          (submitInfo.signalSemaphoreCount == pTimelineSemaphoreInfo->signalSemaphoreValueCount));
+                VK_ASSERT((pLastTimelineSemaInfo == nullptr) ||
+                          (pLastSubmitInfo->signalSemaphoreCount == pLastTimelineSemaInfo->signalSemaphoreValueCount));
                 result = PalSignalSemaphores(
-                    submitInfo.signalSemaphoreCount,
-                    submitInfo.pSignalSemaphores,
-                    ((pTimelineSemaphoreInfo != nullptr) ? pTimelineSemaphoreInfo->pSignalSemaphoreValues : nullptr),
+                    pLastSubmitInfo->signalSemaphoreCount,
+                    pLastSubmitInfo->pSignalSemaphores,
+                    ((pLastTimelineSemaInfo != nullptr) ? pLastTimelineSemaInfo->pSignalSemaphoreValues : nullptr),
                     (pDeviceGroupInfo != nullptr ? pDeviceGroupInfo->signalSemaphoreCount          : 0),
                     (pDeviceGroupInfo != nullptr ? pDeviceGroupInfo->pSignalSemaphoreDeviceIndices : nullptr));
             }
 
         }
     }
+
+    // Once the fence is known to be signaled, so are the timeline semaphores signaled by this call
+    if ((result == VK_SUCCESS) && (pFence != nullptr) && (m_pDevice->NumPalDevices() == 1))
+    {
+        pFence->SetSubmitSerial(this, m_submitSerial);
+    }
+
+    m_submitStats.submitCalls++;
+    m_submitStats.batchCount += submitCount;
+    m_submitStats.submitTime += Util::GetPerfCpuTime() - startTime;
+
+    return result;
+}
+
+// =====================================================================================================================
+// Flattens the batches of a vkQueueSubmit() call into PAL queue operations and hands them to the submission thread,
+// which issues them in order.  Vulkan objects are resolved to PAL objects here, so the thread never touches them.
+// The same batches are merged into one PAL submission as in the direct path.
+VkResult Queue::SubmitToThread(
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits,
+    Fence*              pFence)
+{
+    // Report an error the thread ran into with an earlier submission
+    VkResult result = PalToVkResult(m_pSubmitThread->ConsumeResult());
+
+    const bool coalesceBatches = m_pDevice->GetRuntimeSettings().coalesceSubmitBatches;
+
+    // The PAL command buffers of all batches are gathered in one allocation owned by the submission of the last one
+    uint32_t totalCmdBufferCount = 0;
+
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        totalCmdBufferCount += pSubmits[submitIdx].commandBufferCount;
+    }
+
+    Pal::ICmdBuffer** ppPalCmdBuffers = nullptr;
+
+    if ((result == VK_SUCCESS) && (totalCmdBufferCount > 0))
+    {
+        ppPalCmdBuffers = static_cast<Pal::ICmdBuffer**>(m_pDevice->VkInstance()->AllocMem(
+            sizeof(Pal::ICmdBuffer*) * totalCmdBufferCount,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND));
+
+        result = (ppPalCmdBuffers != nullptr) ? VK_SUCCESS : VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    QueuedSubmitOp op = {};
+
+    uint32_t cmdBufferCount      = 0;      // Number of command buffers gathered so far
+    uint32_t firstCmdBuffer      = 0;      // First command buffer not yet pushed with a submission
+    bool     submitPending       = false;  // Whether a submission has to be pushed for the batches so far
+    bool     cmdBuffersHandedOff = (ppPalCmdBuffers == nullptr);
+
+    for (uint32_t submitIdx = 0; (submitIdx < submitCount) && (result == VK_SUCCESS); ++submitIdx)
+    {
+        const VkSubmitInfo&                  submitInfo             = pSubmits[submitIdx];
+        const VkDeviceGroupSubmitInfo*       pDeviceGroupInfo       = nullptr;
+        const VkTimelineSemaphoreSubmitInfo* pTimelineSemaphoreInfo = nullptr;
+
+        GetSubmitInfoExtensions(submitInfo, &pDeviceGroupInfo, &pTimelineSemaphoreInfo);
+
+        const bool lastBatch = (submitIdx == submitCount - 1);
+
+        if (submitInfo.waitSemaphoreCount > 0)
+        {
+            // The waits belong after the command buffers of the previous batches
+            if (submitPending)
+            {
+                op.type                  = QueuedSubmitOp::Type::Submit;
+                op.pMemory               = nullptr;
+                op.submit.ppCmdBuffers   = ppPalCmdBuffers + firstCmdBuffer;
+                op.submit.cmdBufferCount = cmdBufferCount - firstCmdBuffer;
+                op.submit.pFence         = nullptr;
+
+                m_pSubmitThread->Push(op);
+                m_submitStats.palSubmitCount++;
+
+                firstCmdBuffer = cmdBufferCount;
+            }
+
+            for (uint32_t i = 0; (i < submitInfo.waitSemaphoreCount) && (result == VK_SUCCESS); ++i)
+            {
+                Semaphore* pSemaphore = Semaphore::ObjectFromHandle(submitInfo.pWaitSemaphores[i]);
+                uint64_t   value      = 0;
+
+                if (pSemaphore->IsTimelineSemaphore())
+                {
+                    if ((pTimelineSemaphoreInfo == nullptr) ||
+                        (pTimelineSemaphoreInfo->pWaitSemaphoreValues == nullptr))
+                    {
+                        result = PalToVkResult(Pal::Result::ErrorInvalidPointer);
+                        break;
+                    }
+
+                    value = pTimelineSemaphoreInfo->pWaitSemaphoreValues[i];
+                }
+
+                PushWaitSemaphore(pSemaphore, value);
+            }
+
+            // Like in the direct path, waits are always followed by a submission
+            submitPending = true;
+        }
+
+        DispatchableCmdBuffer* const * pCommandBuffers =
+            reinterpret_cast<DispatchableCmdBuffer*const*>(submitInfo.pCommandBuffers);
+
+        for (uint32_t i = 0; (i < submitInfo.commandBufferCount) && (result == VK_SUCCESS); ++i)
+        {
+            const CmdBuffer& cmdBuf = *(*pCommandBuffers[i]);
+
+            ppPalCmdBuffers[cmdBufferCount++] = cmdBuf.PalCmdBuffer(DefaultDeviceIndex);
+
+            submitPending = true;
+        }
+
+        // Push the submission unless it can be merged with the next batch.  The fence goes on the last one.
+        if ((result == VK_SUCCESS) &&
+            ((lastBatch && (pFence != nullptr)) ||
+             (submitPending && ((coalesceBatches == false) || (submitInfo.signalSemaphoreCount > 0) || lastBatch))))
+        {
+            op.type                  = QueuedSubmitOp::Type::Submit;
+            op.pMemory               = nullptr;
+            op.submit.ppCmdBuffers   = ppPalCmdBuffers + firstCmdBuffer;
+            op.submit.cmdBufferCount = cmdBufferCount - firstCmdBuffer;
+            op.submit.pFence         = nullptr;
+
+            if (lastBatch && (pFence != nullptr))
+            {
+                op.submit.pFence = pFence->PalFence(DefaultDeviceIndex);
+            }
+
+            if ((cmdBuffersHandedOff == false) && (cmdBufferCount == totalCmdBufferCount))
+            {
+                op.pMemory          = ppPalCmdBuffers;
+                cmdBuffersHandedOff = true;
+            }
+
+            m_pSubmitThread->Push(op);
+            m_submitStats.palSubmitCount++;
+
+            firstCmdBuffer = cmdBufferCount;
+            submitPending  = false;
+        }
+
+        for (uint32_t i = 0; (i < submitInfo.signalSemaphoreCount) && (result == VK_SUCCESS); ++i)
+        {
+            Semaphore* pSemaphore = Semaphore::ObjectFromHandle(submitInfo.pSignalSemaphores[i]);
+
+            op.type                 = QueuedSubmitOp::Type::SignalSemaphore;
+            op.pMemory              = nullptr;
+            op.semaphore.pSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
+            op.semaphore.value      = 0;
+
+            if (pSemaphore->IsTimelineSemaphore())
+            {
+                if ((pTimelineSemaphoreInfo == nullptr) ||
+                    (pTimelineSemaphoreInfo->pSignalSemaphoreValues == nullptr))
+                {
+                    result = PalToVkResult(Pal::Result::ErrorInvalidPointer);
+                    break;
+                }
+
+                op.semaphore.value = pTimelineSemaphoreInfo->pSignalSemaphoreValues[i];
+            }
+
+            m_pSubmitThread->Push(op);
+            pSemaphore->SetSignalSubmitPoint(GetSubmitPoint());
+
+            if (pSemaphore->IsTimelineSemaphore())
+            {
+                pSemaphore->RecordTimelineSignal(op.semaphore.value, GetCompletionPoint());
+            }
+        }
+    }
+
+    if ((result == VK_SUCCESS) && (submitCount == 0) && (pFence != nullptr))
+    {
+        // Submit nothing just so that the fence is signaled
+        op.type                  = QueuedSubmitOp::Type::Submit;
+        op.pMemory               = nullptr;
+        op.submit.ppCmdBuffers   = nullptr;
+        op.submit.cmdBufferCount = 0;
+        op.submit.pFence         = pFence->PalFence(DefaultDeviceIndex);
+
+        m_pSubmitThread->Push(op);
+        m_submitStats.palSubmitCount++;
+    }
+
+    if (cmdBuffersHandedOff == false)
+    {
+        // Operations pushed before the failure may still read the command buffers
+        m_pSubmitThread->WaitIdle();
+
+        m_pDevice->VkInstance()->FreeMem(ppPalCmdBuffers);
+    }
+
+    if ((result == VK_SUCCESS) && (pFence != nullptr))
+    {
+        pFence->SetActiveDevice(DefaultDeviceIndex);
+        pFence->SetPendingSubmission(m_pSubmitThread, m_pSubmitThread->GetPushedCount());
+    }
+
     return result;
 }
 
+// =====================================================================================================================
+// Pushes a wait for a semaphore to the submission thread.  A binary semaphore has to be signaled before a wait for it
+// is issued, so this first waits for the semaphore's signal if another queue's submission thread still holds it.
+void Queue::PushWaitSemaphore(
+    Semaphore* pSemaphore,
+    uint64_t   value)
+{
+    m_pDevice->WaitForSubmitPoint(pSemaphore->GetSignalSubmitPoint(), this);
+
+    QueuedSubmitOp op = {};
+    op.type                 = QueuedSubmitOp::Type::WaitSemaphore;
+    op.pMemory              = nullptr;
+    op.semaphore.pSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
+    op.semaphore.value      = value;
+
+    pSemaphore->RestoreSemaphore();
+
+    if (op.semaphore.pSemaphore != nullptr)
+    {
+        m_pSubmitThread->Push(op);
+        pSemaphore->SetWaitSubmitPoint(GetSubmitPoint());
+    }
+}
+
+// =====================================================================================================================
+// Pushes a present to the submission thread.  The present rectangles are copied along with it; they are only a hint
+// to the presentation engine, so they are dropped if the copy cannot be allocated.
+void Queue::PushPresent(
+    const Pal::PresentSwapChainInfo& presentInfo)
+{
+    QueuedSubmitOp op = {};
+    op.type    = QueuedSubmitOp::Type::Present;
+    op.pMemory = nullptr;
+    op.present = presentInfo;
+
+    if (presentInfo.rectangleCount > 0)
+    {
+        op.pMemory = m_pDevice->VkInstance()->AllocMem(
+            sizeof(Pal::Rect) * presentInfo.rectangleCount,
+            VK_DEFAULT_MEM_ALIGN,
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+
+        if (op.pMemory != nullptr)
+        {
+            memcpy(op.pMemory, presentInfo.pRectangles, sizeof(Pal::Rect) * presentInfo.rectangleCount);
+        }
+        else
+        {
+            op.present.rectangleCount = 0;
+        }
+
+        op.present.pRectangles = static_cast<const Pal::Rect*>(op.pMemory);
+    }
+
+    m_pSubmitThread->Push(op);
+}
+
 // =====================================================================================================================
 // Wait for a queue to go idle
 VkResult Queue::WaitIdle(void)
 {
     Pal::Result palResult = Pal::Result::Success;
 
+    if (m_pSubmitThread != nullptr)
+    {
+        m_pSubmitThread->WaitIdle();
+
+        palResult = m_pSubmitThread->ConsumeResult();
+    }
+
     for (uint32_t deviceIdx = 0;
         (deviceIdx < m_pDevice->NumPalDevices()) && (palResult == Pal::Result::Success);
         deviceIdx++)
@@ -463,9 +881,33 @@ VkResult Queue::WaitIdle(void)
         palResult = PalQueue(deviceIdx)->WaitIdle();
     }
 
+    if (palResult == Pal::Result::Success)
+    {
+        ObserveCompletedSubmitSerial(m_submitSerial);
+    }
+
     return PalToVkResult(palResult);
 }
 
+// =====================================================================================================================
+// Records that the Submit() and BindSparse() calls up to the given serial number have completed on the GPU.
+void Queue::ObserveCompletedSubmitSerial(
+    uint64_t submitSerial)
+{
+    // Like Semaphore::ObserveTimelineValue(), concurrent updates exchange their values until the highest one sticks
+    while (true)
+    {
+        const uint64_t prevSerial = Util::AtomicExchange64(&m_completedSubmitSerial, submitSerial);
+
+        if (prevSerial <= submitSerial)
+        {
+            break;
+        }
+
+        submitSerial = prevSerial;
+    }
+}
+
 // =====================================================================================================================
 // Signal a queue semaphore
 // If semaphoreCount > semaphoreDeviceIndicesCount, the last device index will be used for the remaining semaphores.
@@ -534,6 +976,13 @@ VkResult Queue::PalSignalSemaphores(
             palResult = Pal::Result::ErrorUnknown;
 #endif
         }
+
+        // Fences only tell about the completion of submissions with a single PAL device
+        if ((palResult == Pal::Result::Success) && pVkSemaphore->IsTimelineSemaphore())
+        {
+            pVkSemaphore->RecordTimelineSignal(pointValue,
+                                               (m_pDevice->NumPalDevices() == 1) ? GetCompletionPoint() : 0);
+        }
     }
 
     return  (palResult == Pal::Result::ErrorUnknown) ? VK_ERROR_DEVICE_LOST : PalToVkResult(palResult);
@@ -592,6 +1041,9 @@ VkResult Queue::PalWaitSemaphores(
 
         VK_ASSERT(deviceIdx < m_pDevice->NumPalDevices());
 
+        // The signal may still be held by another queue's submission thread
+        m_pDevice->WaitForSubmitPoint(pSemaphore->GetSignalSubmitPoint(), this);
+
         // Wait for the semaphore.
         pPalSemaphore = pSemaphore->PalSemaphore(deviceIdx);
         pSemaphore->RestoreSemaphore();
@@ -738,7 +1190,37 @@ VkResult Queue::Present(
         return VK_ERROR_INITIALIZATION_FAILED;
     }
 
-    if (pPresentInfo->waitSemaphoreCount > 0)
+    // Presents are pushed to the submission thread along with their semaphore waits and internal submissions unless a
+    // swap chain needs them to be issued right away
+    bool queuePresent = (m_pSubmitThread != nullptr);
+
+    for (uint32_t i = 0; queuePresent && (i < pPresentInfo->swapchainCount); ++i)
+    {
+        queuePresent = SwapChain::ObjectFromHandle(pPresentInfo->pSwapchains[i])->CanQueuePresent();
+    }
+
+    // A failure of an earlier queued present is reported by this one
+    Pal::Result queuedPresentResult = queuePresent ? m_pSubmitThread->ConsumePresentResult() : Pal::Result::Success;
+
+    if (queuePresent == false)
+    {
+        // The present is issued directly and has to follow this queue's submissions.  PalWaitSemaphores() waits for
+        // the signals of the semaphores held by other queues' submission threads.
+        WaitSubmitThreadIdle();
+    }
+
+    if ((pPresentInfo->waitSemaphoreCount > 0) && queuePresent)
+    {
+        for (uint32_t i = 0; i < pPresentInfo->waitSemaphoreCount; ++i)
+        {
+            PushWaitSemaphore(Semaphore::ObjectFromHandle(pPresentInfo->pWaitSemaphores[i]), 0);
+        }
+
+#if __unix__
+        needSemaphoreFlush = true;
+#endif
+    }
+    else if (pPresentInfo->waitSemaphoreCount > 0)
     {
         result = PalWaitSemaphores(
             pPresentInfo->waitSemaphoreCount,
@@ -836,6 +1318,12 @@ VkResult Queue::Present(
                                                  pGpuMemory,
                                                  needSemaphoreFlush);
 
+        // Keep the command buffer begun for the next present if no post processing was recorded into it
+        if ((pCmdBufState != nullptr) && pCmdBufState->isBegun)
+        {
+            ReleaseUnusedInternalCmdBuf(presentationDeviceIdx, pCmdBufState);
+        }
+
         if (result != VK_SUCCESS)
         {
             break;
@@ -846,7 +1334,22 @@ VkResult Queue::Present(
         }
 
         // Perform the actual present
-        Pal::Result palResult = pPresentQueue->PresentSwapChain(presentInfo);
+        Pal::Result palResult = Pal::Result::Success;
+
+        if (queuePresent)
+        {
+            VK_ASSERT(pPresentQueue == PalQueue(DefaultDeviceIndex));
+
+            PushPresent(presentInfo);
+            pSwapChain->SetPresentSubmitPoint(GetSubmitPoint());
+
+            palResult           = queuedPresentResult;
+            queuedPresentResult = Pal::Result::Success;
+        }
+        else
+        {
+            palResult = pPresentQueue->PresentSwapChain(presentInfo);
+        }
 
         result = NotifyFlipMetadataAfterPresent(presentationDeviceIdx, &presentInfo);
 
@@ -1001,11 +1504,22 @@ VkResult Queue::BindSparseEntry(
         for (uint32_t k = 0; k < bufBindInfo.bindCount; ++k)
         {
             const VkSparseMemoryBind& bind = bufBindInfo.pBinds[k];
-            Pal::IGpuMemory* pRealGpuMem = nullptr;
+            Pal::IGpuMemory* pRealGpuMem   = nullptr;
+            Pal::gpusize     realMemOffset = 0;
 
             if (bind.memory != VK_NULL_HANDLE)
             {
-                pRealGpuMem = Memory::ObjectFromHandle(bind.memory)->PalMemory(resourceDeviceIndex, memoryDeviceIndex);
+                Memory* pMemory = Memory::ObjectFromHandle(bind.memory);
+
+                result = pMemory->CommitResidency();
+
+                if (result != VK_SUCCESS)
+                {
+                    goto End;
+                }
+
+                pRealGpuMem   = pMemory->PalMemory(resourceDeviceIndex, memoryDeviceIndex);
+                realMemOffset = pMemory->PalOffset();
             }
 
             VK_ASSERT(bind.flags == 0);
@@ -1015,7 +1529,7 @@ VkResult Queue::BindSparseEntry(
                 pVirtualGpuMem,
                 bind.resourceOffset,
                 pRealGpuMem,
-                bind.memoryOffset,
+                realMemOffset + bind.memoryOffset,
                 bind.size,
                 pRemapState);
 
@@ -1038,11 +1552,22 @@ VkResult Queue::BindSparseEntry(
         for (uint32_t k = 0; k < imgBindInfo.bindCount; ++k)
         {
             const VkSparseMemoryBind& bind = imgBindInfo.pBinds[k];
-            Pal::IGpuMemory* pRealGpuMem = nullptr;
+            Pal::IGpuMemory* pRealGpuMem   = nullptr;
+            Pal::gpusize     realMemOffset = 0;
 
             if (bind.memory != VK_NULL_HANDLE)
             {
-                pRealGpuMem = Memory::ObjectFromHandle(bind.memory)->PalMemory(resourceDeviceIndex, memoryDeviceIndex);
+                Memory* pMemory = Memory::ObjectFromHandle(bind.memory);
+
+                result = pMemory->CommitResidency();
+
+                if (result != VK_SUCCESS)
+                {
+                    goto End;
+                }
+
+                pRealGpuMem   = pMemory->PalMemory(resourceDeviceIndex, memoryDeviceIndex);
+                realMemOffset = pMemory->PalOffset();
             }
 
             result = AddVirtualRemapRange(
@@ -1050,7 +1575,7 @@ VkResult Queue::BindSparseEntry(
                 pVirtualGpuMem,
                 bind.resourceOffset,
                 pRealGpuMem,
-                bind.memoryOffset,
+                realMemOffset + bind.memoryOffset,
                 bind.size,
                 pRemapState);
 
@@ -1078,11 +1603,22 @@ VkResult Queue::BindSparseEntry(
 
             VK_ASSERT(bind.flags == 0);
 
-            Pal::IGpuMemory* pRealGpuMem = nullptr;
+            Pal::IGpuMemory* pRealGpuMem   = nullptr;
+            Pal::gpusize     realMemOffset = 0;
 
             if (bind.memory != VK_NULL_HANDLE)
             {
-                pRealGpuMem = Memory::ObjectFromHandle(bind.memory)->PalMemory(resourceDeviceIndex, memoryDeviceIndex);
+                Memory* pMemory = Memory::ObjectFromHandle(bind.memory);
+
+                result = pMemory->CommitResidency();
+
+                if (result != VK_SUCCESS)
+                {
+                    goto End;
+                }
+
+                pRealGpuMem   = pMemory->PalMemory(resourceDeviceIndex, memoryDeviceIndex);
+                realMemOffset = pMemory->PalOffset();
             }
 
             // Get the subresource layout to be able to figure out its offset
@@ -1136,7 +1672,7 @@ VkResult Queue::BindSparseEntry(
 
             // Calculate byte size to remap per row
             VkDeviceSize sizePerRow = extentInTiles.width * prtTileSize;
-            VkDeviceSize realOffset = bind.memoryOffset;
+            VkDeviceSize realOffset = realMemOffset + bind.memoryOffset;
 
             for (uint32_t tileZ = 0; tileZ < extentInTiles.depth; ++tileZ)
             {
@@ -1226,6 +1762,11 @@ VkResult Queue::BindSparse(
 {
     VkResult result = VK_SUCCESS;
 
+    // Sparse binds are issued directly and have to follow this queue's submissions
+    WaitSubmitThreadIdle();
+
+    m_submitSerial++;
+
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
 
     // Initialize state to track batches of sparse bind calls
@@ -1362,6 +1903,11 @@ VkResult Queue::BindSparse(
             result = PalToVkResult(PalQueue(deviceIndex)->Submit(submitInfo));
         }
         while ((result == VK_SUCCESS) && deviceGroup.IterateNext());
+
+        if ((result == VK_SUCCESS) && (m_pDevice->NumPalDevices() == 1))
+        {
+            pFence->SetSubmitSerial(this, m_submitSerial);
+        }
     }
 
     virtStackFrame.FreeArray(remapState.pRanges);
@@ -1382,6 +1928,36 @@ void Queue::CreateCmdBufRing(
     }
 
     VK_ASSERT(m_pCmdBufRing[deviceIdx] != nullptr);
+
+    // Completion is tracked through the command buffers' fences if no timeline semaphore can be created
+    if (m_pDevice->VkPhysicalDevice(deviceIdx)->PalProperties().osProperties.timelineSemaphore.support)
+    {
+        Pal::IDevice* pPalDevice = m_pDevice->PalDevice(deviceIdx);
+
+        Pal::QueueSemaphoreCreateInfo createInfo = {};
+        createInfo.maxCount       = 1;
+        createInfo.flags.timeline = 1;
+
+        Pal::Result  result        = Pal::Result::Success;
+        const size_t semaphoreSize = pPalDevice->GetQueueSemaphoreSize(createInfo, &result);
+
+        void* pSemaphoreMemory = (result == Pal::Result::Success) ?
+            m_pDevice->VkInstance()->AllocMem(semaphoreSize, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT) : nullptr;
+
+        if (pSemaphoreMemory != nullptr)
+        {
+            result = pPalDevice->CreateQueueSemaphore(createInfo,
+                                                      pSemaphoreMemory,
+                                                      &m_internalTimeline[deviceIdx].pSemaphore);
+
+            if (result != Pal::Result::Success)
+            {
+                m_internalTimeline[deviceIdx].pSemaphore = nullptr;
+
+                m_pDevice->VkInstance()->FreeMem(pSemaphoreMemory);
+            }
+        }
+    }
 }
 
 // =====================================================================================================================
@@ -1403,6 +1979,13 @@ void Queue::DestroyCmdBufRing(
         m_pDevice->VkInstance()->FreeMem(m_pCmdBufRing[deviceIdx]);
         m_pCmdBufRing[deviceIdx] = nullptr;
     }
+
+    if (m_internalTimeline[deviceIdx].pSemaphore != nullptr)
+    {
+        m_internalTimeline[deviceIdx].pSemaphore->Destroy();
+        m_pDevice->VkInstance()->FreeMem(m_internalTimeline[deviceIdx].pSemaphore);
+        m_internalTimeline[deviceIdx].pSemaphore = nullptr;
+    }
 }
 
 // =====================================================================================================================
@@ -1464,6 +2047,11 @@ CmdBufState* Queue::CreateCmdBufState(
             result = pDevice->CreateFence(fenceInfo, pFenceStorage, &pCmdBufState->pFence);
         }
 
+        pCmdBufState->isBegun       = false;
+        pCmdBufState->isPending     = false;
+        pCmdBufState->submitOpCount = 0;
+        pCmdBufState->timelineValue = 0;
+
         VK_ASSERT(Util::VoidPtrInc(pCmdBufState, totalSize) == pStorage);
 
         if (result != Pal::Result::Success)
@@ -1482,10 +2070,10 @@ void Queue::DestroyCmdBufState(
     uint32_t     deviceIdx,
     CmdBufState* pCmdBufState)
 {
-    // Wait to finish in case still in flight
-    if (pCmdBufState->pFence->GetStatus() == Pal::Result::NotReady)
+    // Wait to finish in case still in flight, which is tracked by the internal timeline when there is one
+    if (pCmdBufState->isPending && (IsInternalCmdBufComplete(deviceIdx, pCmdBufState) == false))
     {
-        m_pDevice->PalDevice(deviceIdx)->WaitForFences(1, &pCmdBufState->pFence, true, ~0ULL);
+        WaitInternalCmdBuf(deviceIdx, pCmdBufState);
     }
 
     // Destroy Fence
@@ -1505,7 +2093,13 @@ void Queue::DestroyCmdBufState(
 }
 
 // =====================================================================================================================
-// Gets a new command buffer from a ring buffer, the cmd of which can be redefined with new command data
+// Gets a begun command buffer from a ring buffer, the cmd of which can be redefined with new command data.
+//
+// The ring holds at most internalCmdBufRingSize command buffers in the order they were handed out, so the front one is
+// the oldest.  Command buffers that were never submitted go back to the front still begun, and submitted ones are
+// begun again by RetireInternalCmdBuf() once they have completed, so the front one can usually be handed out without
+// any PAL call.  Only when a full ring's oldest command buffer is still in flight does this wait for it, which bounds
+// the memory used by internal submissions.
 CmdBufState* Queue::AcquireInternalCmdBuf(
     uint32_t                       deviceIdx)
 {
@@ -1519,21 +2113,48 @@ CmdBufState* Queue::AcquireInternalCmdBuf(
 
     if (m_pCmdBufRing[deviceIdx] != nullptr)
     {
-        // Create a new command buffer if the least recently used one is still busy.
-        if ((m_pCmdBufRing[deviceIdx]->NumElements() == 0) ||
-            (m_pCmdBufRing[deviceIdx]->Front()->pFence->GetStatus() == Pal::Result::NotReady))
+        CmdBufRing* pRing = m_pCmdBufRing[deviceIdx];
+
+        const uint32_t maxRingSize = Util::Max(m_pDevice->GetRuntimeSettings().internalCmdBufRingSize, 1u);
+
+        m_internalCmdBufStats.acquireCount++;
+
+        CmdBufState* pOldest = (pRing->NumElements() > 0) ? pRing->Front() : nullptr;
+
+        // A fence cannot be polled before the submission thread has issued its submission
+        if ((pOldest != nullptr) && pOldest->isPending && IsInternalCmdBufComplete(deviceIdx, pOldest))
+        {
+            pOldest->isPending = false;
+        }
+
+        // Create a new command buffer if the least recently used one is still busy and the ring is not full yet.
+        if ((pOldest == nullptr) || (pOldest->isPending && (pRing->NumElements() < maxRingSize)))
         {
             pCmdBufState = CreateCmdBufState(deviceIdx);
+
+            if (pCmdBufState != nullptr)
+            {
+                m_internalCmdBufStats.createCount++;
+            }
         }
         else
         {
-            m_pCmdBufRing[deviceIdx]->PopFront(&pCmdBufState);
+            pRing->PopFront(&pCmdBufState);
+
+            if (pCmdBufState->isPending)
+            {
+                m_internalCmdBufStats.stallCount++;
+
+                WaitInternalCmdBuf(deviceIdx, pCmdBufState);
+
+                pCmdBufState->isPending = false;
+            }
         }
 
         // Immediately push this command buffer onto the back of the deque to avoid leaking memory.
         if (pCmdBufState != nullptr)
         {
-            Pal::Result result = m_pCmdBufRing[deviceIdx]->PushBack(pCmdBufState);
+            Pal::Result result = pRing->PushBack(pCmdBufState);
 
             if (result != Pal::Result::Success)
             {
@@ -1541,28 +2162,147 @@ CmdBufState* Queue::AcquireInternalCmdBuf(
                 DestroyCmdBufState(deviceIdx, pCmdBufState);
                 pCmdBufState = nullptr;
             }
-            else
+            else if (pCmdBufState->isBegun)
+            {
+                m_internalCmdBufStats.readyCount++;
+            }
+            else if (BeginInternalCmdBuf(deviceIdx, pCmdBufState) != Pal::Result::Success)
             {
-                Pal::CmdBufferBuildInfo buildInfo = {};
+                pCmdBufState = nullptr;
+            }
+        }
+    }
 
-                buildInfo.flags.optimizeOneTimeSubmit = 1;
+    return pCmdBufState;
+}
 
-                result = pCmdBufState->pCmdBuf->Reset(m_pDevice->GetSharedCmdAllocator(deviceIdx), true);
+// =====================================================================================================================
+// Returns whether the submission of an internal command buffer has completed.  With an internal timeline semaphore
+// this compares the command buffer's value with the highest value seen so far.  Only if that does not suffice is the
+// semaphore queried, and that one query then covers every older submission as well.  Without one, the command
+// buffer's fence has to be polled, and only after the submission thread has issued the submission.
+bool Queue::IsInternalCmdBufComplete(
+    uint32_t           deviceIdx,
+    const CmdBufState* pCmdBufState)
+{
+    InternalTimeline* pTimeline = &m_internalTimeline[deviceIdx];
+    bool              complete  = false;
 
-                if (result == Pal::Result::Success)
-                {
-                    result = pCmdBufState->pCmdBuf->Begin(buildInfo);
-                }
+    if (pTimeline->pSemaphore != nullptr)
+    {
+        uint64_t value = 0;
 
-                if (result != Pal::Result::Success)
-                {
-                    pCmdBufState = nullptr;
-                }
-            }
+        if ((pTimeline->completedValue < pCmdBufState->timelineValue) &&
+            (pTimeline->pSemaphore->QuerySemaphoreValue(&value) == Pal::Result::Success))
+        {
+            pTimeline->completedValue = Util::Max(pTimeline->completedValue, value);
         }
+
+        complete = (pTimeline->completedValue >= pCmdBufState->timelineValue);
+    }
+    else
+    {
+        complete = ((m_pSubmitThread == nullptr) || m_pSubmitThread->IsIssued(pCmdBufState->submitOpCount)) &&
+                   (pCmdBufState->pFence->GetStatus() != Pal::Result::NotReady);
     }
 
-    return pCmdBufState;
+    return complete;
+}
+
+// =====================================================================================================================
+// Waits until the submission of an internal command buffer has completed.
+void Queue::WaitInternalCmdBuf(
+    uint32_t           deviceIdx,
+    const CmdBufState* pCmdBufState)
+{
+    InternalTimeline* pTimeline = &m_internalTimeline[deviceIdx];
+
+    // Neither the fence nor the timeline value can be waited for before the submission thread has issued them
+    WaitSubmitThreadIssued(pCmdBufState->submitOpCount);
+
+    if (pTimeline->pSemaphore != nullptr)
+    {
+        if (pTimeline->pSemaphore->WaitSemaphoreValue(pCmdBufState->timelineValue, ~0ULL) == Pal::Result::Success)
+        {
+            pTimeline->completedValue = Util::Max(pTimeline->completedValue, pCmdBufState->timelineValue);
+        }
+    }
+    else
+    {
+        m_pDevice->PalDevice(deviceIdx)->WaitForFences(1, &pCmdBufState->pFence, true, ~0ULL);
+    }
+}
+
+// =====================================================================================================================
+// Resets and begins an internal command buffer whose previous submission, if any, has completed.
+Pal::Result Queue::BeginInternalCmdBuf(
+    uint32_t     deviceIdx,
+    CmdBufState* pCmdBufState)
+{
+    VK_ASSERT((pCmdBufState->isBegun == false) && (pCmdBufState->isPending == false));
+
+    Pal::CmdBufferBuildInfo buildInfo = {};
+
+    buildInfo.flags.optimizeOneTimeSubmit = 1;
+
+    Pal::Result result = pCmdBufState->pCmdBuf->Reset(m_pDevice->GetSharedCmdAllocator(deviceIdx), true);
+
+    if (result == Pal::Result::Success)
+    {
+        result = pCmdBufState->pCmdBuf->Begin(buildInfo);
+    }
+
+    pCmdBufState->isBegun = (result == Pal::Result::Success);
+
+    return result;
+}
+
+// =====================================================================================================================
+// Begins the oldest internal command buffer again once its submission has completed, so that the next
+// AcquireInternalCmdBuf() can hand it out right away.  Called after each internal submission, which keeps the ring's
+// front ready without a separate pass over the ring.
+void Queue::RetireInternalCmdBuf(
+    uint32_t deviceIdx)
+{
+    CmdBufRing* pRing = m_pCmdBufRing[deviceIdx];
+
+    if ((pRing != nullptr) && (pRing->NumElements() > 0))
+    {
+        CmdBufState* pOldest = pRing->Front();
+
+        if (pOldest->isPending && IsInternalCmdBufComplete(deviceIdx, pOldest))
+        {
+            pOldest->isPending = false;
+        }
+
+        // If this fails, AcquireInternalCmdBuf() tries again when it hands the command buffer out
+        if ((pOldest->isPending == false) && (pOldest->isBegun == false))
+        {
+            BeginInternalCmdBuf(deviceIdx, pOldest);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Gives back the command buffer of the last AcquireInternalCmdBuf() call if nothing was recorded into it.  It stays
+// begun and is handed out first by the next call.
+void Queue::ReleaseUnusedInternalCmdBuf(
+    uint32_t                       deviceIdx,
+    CmdBufState*                   pCmdBufState)
+{
+    CmdBufRing* pRing = m_pCmdBufRing[deviceIdx];
+
+    VK_ASSERT((pRing != nullptr) && (pRing->Back() == pCmdBufState));
+    VK_ASSERT(pCmdBufState->isBegun && (pCmdBufState->isPending == false));
+
+    CmdBufState* pBack = nullptr;
+
+    pRing->PopBack(&pBack);
+
+    if (pRing->PushFront(pBack) != Pal::Result::Success)
+    {
+        DestroyCmdBufState(deviceIdx, pBack);
+    }
 }
 
 // =====================================================================================================================
@@ -1611,33 +2351,86 @@ VkResult Queue::SubmitInternalCmdBuf(
     const Pal::CmdBufInfo&  cmdBufInfo,
     CmdBufState*            pCmdBufState)
 {
+    InternalTimeline* pTimeline = &m_internalTimeline[deviceIdx];
+    Pal::IFence*      pFence    = (pTimeline->pSemaphore == nullptr) ? pCmdBufState->pFence : nullptr;
+
+    VK_ASSERT(cmdBufInfo.isValid == 1);
+
     Pal::Result result = pCmdBufState->pCmdBuf->End();
 
-    if (result == Pal::Result::Success)
+    pCmdBufState->isBegun = false;
+
+    if ((result == Pal::Result::Success) && (pFence != nullptr))
+    {
+        result = m_pDevice->PalDevice(deviceIdx)->ResetFences(1, &pFence);
+    }
+
+    // Submit the command buffer, followed by a signal of the next internal timeline value
+    if ((result == Pal::Result::Success) && (m_pSubmitThread != nullptr))
     {
-        result = m_pDevice->PalDevice(deviceIdx)->ResetFences(1, &pCmdBufState->pFence);
+        QueuedSubmitOp op = {};
+        op.type                  = QueuedSubmitOp::Type::Submit;
+        op.pMemory               = nullptr;
+        op.submit.ppCmdBuffers   = &pCmdBufState->pCmdBuf;
+        op.submit.cmdBufferCount = 1;
+        op.submit.pFence         = pFence;
+        op.submit.cmdBufInfo     = cmdBufInfo;
 
-        // Submit the command buffer
-        if (result == Pal::Result::Success)
+        m_pSubmitThread->Push(op);
+
+        if (pTimeline->pSemaphore != nullptr)
         {
-            Pal::PerSubQueueSubmitInfo perSubQueueInfo = {};
-            perSubQueueInfo.cmdBufferCount  = 1;
-            perSubQueueInfo.ppCmdBuffers    = &pCmdBufState->pCmdBuf;
-            perSubQueueInfo.pCmdBufInfoList = &cmdBufInfo;
+            op.type                 = QueuedSubmitOp::Type::SignalSemaphore;
+            op.semaphore.pSemaphore = pTimeline->pSemaphore;
+            op.semaphore.value      = ++pTimeline->signaledValue;
 
-            Pal::SubmitInfo palSubmitInfo = {};
+            m_pSubmitThread->Push(op);
+        }
 
-            VK_ASSERT(cmdBufInfo.isValid == 1);
+        pCmdBufState->isPending     = true;
+        pCmdBufState->submitOpCount = m_pSubmitThread->GetPushedCount();
+        pCmdBufState->timelineValue = pTimeline->signaledValue;
+    }
+    else if (result == Pal::Result::Success)
+    {
+        Pal::PerSubQueueSubmitInfo perSubQueueInfo = {};
+        perSubQueueInfo.cmdBufferCount  = 1;
+        perSubQueueInfo.ppCmdBuffers    = &pCmdBufState->pCmdBuf;
+        perSubQueueInfo.pCmdBufInfoList = &cmdBufInfo;
 
-            palSubmitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
-            palSubmitInfo.perSubQueueInfoCount = 1;
-            palSubmitInfo.ppFences             = &pCmdBufState->pFence;
-            palSubmitInfo.fenceCount           = 1;
+        Pal::SubmitInfo palSubmitInfo = {};
+
+        palSubmitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
+        palSubmitInfo.perSubQueueInfoCount = 1;
+        palSubmitInfo.ppFences             = (pFence != nullptr) ? &pFence : nullptr;
+        palSubmitInfo.fenceCount           = (pFence != nullptr) ? 1 : 0;
 
-            result = m_pPalQueues[deviceIdx]->Submit(palSubmitInfo);
+        result = m_pPalQueues[deviceIdx]->Submit(palSubmitInfo);
+
+        pCmdBufState->isPending = (result == Pal::Result::Success);
+
+        if ((result == Pal::Result::Success) && (pTimeline->pSemaphore != nullptr))
+        {
+            result = m_pPalQueues[deviceIdx]->SignalQueueSemaphore(pTimeline->pSemaphore,
+                                                                   ++pTimeline->signaledValue);
+
+            pCmdBufState->timelineValue = pTimeline->signaledValue;
+
+            if (result != Pal::Result::Success)
+            {
+                // Nothing would ever report the submission as complete
+                m_pPalQueues[deviceIdx]->WaitIdle();
+
+                pCmdBufState->isPending = false;
+            }
         }
     }
 
+    if (result == Pal::Result::Success)
+    {
+        RetireInternalCmdBuf(deviceIdx);
+    }
+
     return PalToVkResult(result);
 }
 
@@ -28,6 +28,7 @@
 #include "include/vk_instance.h"
 #include "include/vk_semaphore.h"
 #include "include/vk_object.h"
+#include "include/vk_queue.h"
 
 #include "palQueueSemaphore.h"
 
@@ -246,6 +247,9 @@ VkResult Semaphore::GetShareHandle(
     VkExternalSemaphoreHandleTypeFlagBits       handleType,
     Pal::OsExternalHandle*                      pHandle)
 {
+    // A sync file only captures the state of the semaphore once its signal has been issued to PAL
+    device->WaitForSubmitPoint(m_signalSubmitPoint, nullptr);
+
 #if defined(__unix__)
     PAL_ASSERT((handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT) ||
                (handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT));
@@ -311,6 +315,9 @@ VkResult Semaphore::ImportSemaphore(
 
                 if (vkResult == VK_SUCCESS)
                 {
+                    // Operations queued on submission threads may still refer to the PAL semaphores replaced here
+                    WaitForQueuedOps(pDevice);
+
                     DestroyTemporarySemaphore(pDevice);
                     if ((importInfo.importFlags & VK_SEMAPHORE_IMPORT_TEMPORARY_BIT))
                     {
@@ -383,6 +390,96 @@ void Semaphore::SetSemaphore(
     }
 
     m_sharedSemaphoreHandle = importedHandle;
+
+    // Nothing is known about the imported payload yet, and signals recorded for the replaced one say nothing about it
+    m_payloadShared         = true;
+    m_timelineValue         = 0;
+    m_signaledValue         = 0;
+    m_signalCompletionPoint = 0;
+}
+
+// =====================================================================================================================
+// Records that the timeline payload has reached at least the given value.
+void Semaphore::ObserveTimelineValue(
+    uint64_t value)
+{
+    // Any value that is stored is one that was observed, so it remains a valid lower bound while concurrent updates
+    // exchange their values back and forth until the highest one sticks.
+    RaiseValue(&m_timelineValue, value);
+}
+
+// =====================================================================================================================
+// Raises a timeline value to at least the given one.
+void Semaphore::RaiseValue(
+    volatile uint64_t* pTarget,
+    uint64_t           value)
+{
+    while (true)
+    {
+        const uint64_t prevValue = Util::AtomicExchange64(pTarget, value);
+
+        if (prevValue <= value)
+        {
+            break;
+        }
+
+        value = prevValue;
+    }
+}
+
+// =====================================================================================================================
+// Records a signal operation for the given timeline value that was issued by the Submit() or BindSparse() call
+// identified by a completion point, see Queue::GetCompletionPoint(), or by an unknown call if the point is 0.  Calls on
+// a queue are recorded in submission order and signal increasing values, so while all signals come from one queue the
+// completion of the latest recorded point implies that the payload has reached the highest recorded value.
+void Semaphore::RecordTimelineSignal(
+    uint64_t value,
+    uint64_t completionPoint)
+{
+    const uint32_t queueBits = static_cast<uint32_t>(completionPoint >> Queue::SubmitPointQueueShift);
+
+    // The queue check is published before the point and the point before the value, RefreshTimelineValue() reads them
+    // in the opposite order.
+    const uint32_t prevQueueBits = (queueBits != 0) ? Util::AtomicCompareAndSwap(&m_signalQueueBits, 0, queueBits) : 0;
+
+    if ((queueBits == 0) || ((prevQueueBits != 0) && (prevQueueBits != queueBits)))
+    {
+        Util::AtomicExchange(&m_multiQueueSignals, 1);
+    }
+    else
+    {
+        Util::AtomicExchange64(&m_signalCompletionPoint, completionPoint);
+    }
+
+    RaiseValue(&m_signaledValue, value);
+}
+
+// =====================================================================================================================
+// Raises the observed timeline value to the highest signaled one if the queue that signaled it is known to have
+// completed the signal, see Device::IsCompletionPointReached().
+void Semaphore::RefreshTimelineValue(
+    const Device* pDevice)
+{
+    const uint64_t signaledValue = m_signaledValue;
+
+    if ((signaledValue > m_timelineValue) && (m_useTempSemaphore == false))
+    {
+        const uint64_t completionPoint = m_signalCompletionPoint;
+
+        if ((m_multiQueueSignals == 0) && pDevice->IsCompletionPointReached(completionPoint))
+        {
+            ObserveTimelineValue(signaledValue);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Waits until the submission threads have issued the latest signal and wait operations pushed for the semaphore.
+void Semaphore::WaitForQueuedOps(
+    Device* pDevice) const
+{
+    pDevice->WaitForSubmitPoint(m_signalSubmitPoint, nullptr);
+    pDevice->WaitForSubmitPoint(m_waitSubmitPoint, nullptr);
 }
 
 // =====================================================================================================================
@@ -430,8 +527,34 @@ VkResult Semaphore::GetSemaphoreCounterValue(
 
     if (pSemaphore != nullptr)
     {
-        pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
-        palResult = pPalSemaphore->QuerySemaphoreValue(pValue);
+        const bool isTimeline = pSemaphore->IsTimelineSemaphore();
+
+        if (isTimeline)
+        {
+            pSemaphore->RefreshTimelineValue(pDevice);
+        }
+
+        // Once every signal issued on this device is known to have completed, the payload cannot change anymore unless
+        // it is shared with someone else, so the observed value is the current one.
+        if (isTimeline                                &&
+            (pSemaphore->m_payloadShared == false)    &&
+            (pSemaphore->m_useTempSemaphore == false) &&
+            (pSemaphore->m_timelineValue >= pSemaphore->m_signaledValue))
+        {
+            *pValue = pSemaphore->m_timelineValue;
+        }
+        else
+        {
+            pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
+            palResult = pPalSemaphore->QuerySemaphoreValue(pValue);
+
+            // Signals whose completion is unknown to the host still have to be queried from PAL; the result lets later
+            // waits for values up to it skip the kernel.
+            if ((palResult == Pal::Result::Success) && isTimeline)
+            {
+                pSemaphore->ObserveTimelineValue(*pValue);
+            }
+        }
     }
 
     return PalToVkResult(palResult);
@@ -450,9 +573,20 @@ VkResult Semaphore::WaitSemaphoreValue(
     if (pSemaphore != nullptr)
     {
         VK_ASSERT(pSemaphore->IsTimelineSemaphore());
-        pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
-        pSemaphore->RestoreSemaphore();
-        palResult = pPalSemaphore->WaitSemaphoreValue(value, timeout);
+
+        pSemaphore->RefreshTimelineValue(pDevice);
+
+        if (pSemaphore->IsTimelineValueReached(value) == false)
+        {
+            pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
+            pSemaphore->RestoreSemaphore();
+            palResult = pPalSemaphore->WaitSemaphoreValue(value, timeout);
+
+            if (palResult == Pal::Result::Success)
+            {
+                pSemaphore->ObserveTimelineValue(value);
+            }
+        }
     }
 
     return PalToVkResult(palResult);
@@ -471,6 +605,14 @@ VkResult Semaphore::SignalSemaphoreValue(
     {
         pPalSemaphore = pSemaphore->PalSemaphore(DefaultDeviceIndex);
         palResult = pPalSemaphore->SignalSemaphoreValue(value);
+
+        if (palResult == Pal::Result::Success)
+        {
+            // The value is observed before it is recorded as signaled, so pairing it with the completion point of a
+            // queue signal in RefreshTimelineValue() never claims more than is already known.
+            pSemaphore->ObserveTimelineValue(value);
+            RaiseValue(&pSemaphore->m_signaledValue, value);
+        }
     }
 
     return PalToVkResult(palResult);
@@ -485,10 +627,15 @@ VKAPI_ATTR void VKAPI_CALL vkDestroySemaphore(
 {
     if (semaphore != VK_NULL_HANDLE)
     {
-        const Device*                pDevice  = ApiDevice::ObjectFromHandle(device);
+        Device*                      pDevice  = ApiDevice::ObjectFromHandle(device);
         const VkAllocationCallbacks* pAllocCB = pAllocator ? pAllocator : pDevice->VkInstance()->GetAllocCallbacks();
 
-        Semaphore::ObjectFromHandle(semaphore)->Destroy(pDevice, pAllocCB);
+        Semaphore* pSemaphore = Semaphore::ObjectFromHandle(semaphore);
+
+        // A wait queued on a submission thread may still refer to a temporarily imported payload of the semaphore
+        pSemaphore->WaitForQueuedOps(pDevice);
+
+        pSemaphore->Destroy(pDevice, pAllocCB);
     }
 }
 
@@ -74,6 +74,32 @@ VK_INLINE void MetroHashTo128Bit(
               static_cast<uint64_t>(hash.dwords[3]) << 32;
 }
 
+// Name of the entry point used by nearly every pipeline stage
+static constexpr char MainEntryPointName[] = "main";
+
+// =====================================================================================================================
+// Folds the hash of an entry point name into a module's code hash.
+static void CombineEntryPointHash(
+    const char*      pEntryPoint,
+    Pal::ShaderHash* pHash)
+{
+    size_t entryLength = strlen(pEntryPoint);
+
+    if (entryLength > 0)
+    {
+        Util::MetroHash::Hash entryHash = {};
+        Util::MetroHash128::Hash(reinterpret_cast<const uint8_t*>(pEntryPoint), entryLength, entryHash.bytes);
+
+        uint64_t entryLower;
+        uint64_t entryUpper;
+
+        MetroHashTo128Bit(entryHash, &entryLower, &entryUpper);
+
+        pHash->lower ^= entryLower;
+        pHash->upper ^= entryUpper;
+    }
+}
+
 // =====================================================================================================================
 // Returns a 128-bit hash based on this module's SPIRV code plus an optional entry point combination.
 Pal::ShaderHash ShaderModule::GetCodeHash(
@@ -84,20 +110,14 @@ Pal::ShaderHash ShaderModule::GetCodeHash(
 
     if (pEntryPoint != nullptr)
     {
-        size_t entryLength = strlen(pEntryPoint);
-
-        if (entryLength > 0)
+        // The combination with the most common entry point is computed once up front
+        if (strcmp(pEntryPoint, MainEntryPointName) == 0)
         {
-            Util::MetroHash::Hash entryHash = {};
-            Util::MetroHash128::Hash(reinterpret_cast<const uint8_t*>(pEntryPoint), entryLength, entryHash.bytes);
-
-            uint64_t entryLower;
-            uint64_t entryUpper;
-
-            MetroHashTo128Bit(entryHash, &entryLower, &entryUpper);
-
-            hash.lower ^= entryLower;
-            hash.upper ^= entryUpper;
+            hash = m_mainEntryCodeHash;
+        }
+        else
+        {
+            CombineEntryPointHash(pEntryPoint, &hash);
         }
     }
 
@@ -144,6 +164,10 @@ ShaderModule::ShaderModule(
     Util::MetroHash128::Hash(static_cast<const uint8_t*>(pCode), codeSize, codeHash.bytes);
 
     MetroHashTo128Bit(codeHash, &m_codeHash.lower, &m_codeHash.upper);
+
+    m_mainEntryCodeHash = m_codeHash;
+    CombineEntryPointHash(MainEntryPointName, &m_mainEntryCodeHash);
+
     memset(&m_handle, 0, sizeof(m_handle));
 }
 
@@ -81,7 +81,8 @@ SwapChain::SwapChain(
     m_appOwnedImageCount(0),
     m_presentCount(0),
     m_presentMode(presentMode),
-    m_deprecated(false)
+    m_deprecated(false),
+    m_presentSubmitPoint(0)
 {
 }
 
@@ -539,6 +540,8 @@ void SwapChain::InitSwCompositor(
 VkResult SwapChain::Destroy(const VkAllocationCallbacks* pAllocator)
 {
     // Make sure the swapchain is idle and safe to be destroyed.
+    m_pDevice->WaitForSubmitPoint(m_presentSubmitPoint, nullptr);
+
     if (m_pPalSwapChain != nullptr)
     {
         m_pPalSwapChain->WaitIdle();
@@ -638,6 +641,9 @@ VkResult SwapChain::AcquireNextImage(
                 pFence->SetActiveDevice(presentationDeviceIdx);
             }
 
+            // Images only become available again once the presents that release them have been issued
+            m_pDevice->WaitForSubmitPoint(m_presentSubmitPoint, nullptr);
+
             result = PalToVkResult(m_pPalSwapChain->AcquireNextImage(acquireInfo, pImageIndex));
         }
 
@@ -138,6 +138,10 @@ void VulkanSettingsLoader::OverrideSettingsBySystemInfo()
 
         MakeAbsolutePath(m_settings.pipelineProfileDumpFile, sizeof(m_settings.pipelineProfileDumpFile),
                          pRootPath, m_settings.pipelineProfileDumpFile);
+        MakeAbsolutePath(m_settings.pipelineCreationProfileFile, sizeof(m_settings.pipelineCreationProfileFile),
+                         pRootPath, m_settings.pipelineCreationProfileFile);
+        MakeAbsolutePath(m_settings.barrierAnalysisFile, sizeof(m_settings.barrierAnalysisFile),
+                         pRootPath, m_settings.barrierAnalysisFile);
 #if ICD_RUNTIME_APP_PROFILE
         MakeAbsolutePath(m_settings.pipelineProfileRuntimeFile, sizeof(m_settings.pipelineProfileRuntimeFile),
                          pRootPath, m_settings.pipelineProfileRuntimeFile);